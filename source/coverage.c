@@ -0,0 +1,550 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*unpubModule*****************************************************************
+ NAME
+    coverage.c - Execution counts of the -C runtime option
+
+ DESCRIPTION
+    With -C every statement started is counted against its line, the
+    Ctx.CurrFileno and Ctx.CurrLineno of the last T_LINENO token, by
+    CovCount() in stmtbegin().  The counts are kept in an array for
+    each file number, indexed by the line number, which grows as
+    higher lines are reached.  A call counts against the line of the
+    function's declaration.
+
+    Each call of a function, also of a library function, is counted by
+    CovEnter() and CovLeave() in CallFunction(), with the time it took.
+    Its inclusive time is that of the outermost calls, so a recursive
+    function is not counted twice; its exclusive time is that less the
+    time of the functions it called.
+
+    When the run ends the source files are written to sourcename.COV,
+    as gcov does: each line with the count of its statements in front,
+    "#####" if it has code which never ran, or "-" if it has none.
+    Before the line declaring a function are its calls and times; the
+    library functions called follow the source.  The share of the lines
+    with code which ran is reported on stderr.
+
+ FUNCTIONS
+    CovStart()
+    CovStop()
+    CovGrow()
+    CovEnter()
+    CovLeave()
+
+    CovWrite()
+    CovFree()
+    CovNow()
+    CovSource()
+    CovFunc()
+    CovLines()
+    CovBody()
+    CovCode()
+
+ FILES
+    vcldef.h
+
+ SEE ALSO
+    stmt.c, func.c, profile.c
+
+ NOTES
+    Which lines have code is read off the T_LINENO tokens of the
+    functions' pcode by CovLines(): the line of a function's declaration
+    and those on which a statement starts, as statement() would count
+    it.  Local declarations, braces, "else" and case labels are not
+    statements, nor are a statement's continuation lines.
+
+    The source is read again when the report is written, for its text,
+    so it must be where it was compiled from, and not changed since.
+
+    Calls left by longjmp() or an error are not timed.  Times are of
+    the wall clock.  The functions of spawn() and of a parallel for run
+    in instances of their own and are not counted.
+
+*****************************************************************unpubModule*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <dir.h>                        // For MAXPATH
+#include <sclib.h>
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef WRAPVCL
+#include "vcl.hpp"
+#else
+#include "vcldef.h"
+#endif
+
+#define COVLINE         512             /* longest line read at once */
+
+
+/*
+ * Start counting the run
+ */
+void
+VCLCLASS CovStart (void)
+{
+    if ( Cover != NULL || ( Cover = (COVER *) calloc( 1, sizeof( COVER ) )) == NULL )
+        return;
+    if ( ( Cover->funcs = (COVFUNC *) calloc( FunctionsCount + 1, sizeof( COVFUNC ) )) == NULL )
+    {
+        free( Cover );
+        Cover = NULL;
+    }
+} /* CovStart */
+
+
+/*
+ * Stop counting the run, write the report and free the counts
+ */
+void
+VCLCLASS CovStop (void)
+{
+    CovWrite();
+    CovFree();
+} /* CovStop */
+
+
+/*
+ * Count a statement beyond the end of its file's counts
+ *
+ * Called by CovCount(); grows the file's array to the line
+ */
+void
+VCLCLASS CovGrow (void)
+{
+    unsigned long * lp;
+    int             f = Ctx.CurrFileno;
+    int             n;
+
+    if ( f < 0 || f >= COVFILES || Ctx.CurrLineno < 0 )
+        return;
+
+    n = ( Cover->nlines[f] < 256 ) ? 256 : Cover->nlines[f];
+    while ( n <= Ctx.CurrLineno )
+        n *= 2;
+    if ( ( lp = (unsigned long *) realloc( Cover->lines[f], n * sizeof( unsigned long ) )) == NULL )
+        return;
+    memset( lp + Cover->nlines[f], 0, ( n - Cover->nlines[f] ) * sizeof( unsigned long ) );
+    Cover->lines[f] = lp;
+    Cover->nlines[f] = n;
+
+    ++Cover->lines[f][Ctx.CurrLineno];
+} /* CovGrow */
+
+
+/*
+ * Count a call, as the function is entered
+ */
+void
+VCLCLASS CovEnter (FUNCRUNNING *fr)
+{
+    int             f = (int) ( fr->fvar - FunctionMemory );
+
+    if ( f >= 0 && f < FunctionsCount )
+        ++Cover->funcs[f].calls;
+    fr->child = 0.0;
+    fr->enter = CovNow();
+} /* CovEnter */
+
+
+/*
+ * Time a call, as the function returns
+ *
+ * Its time is its caller's time in callees, and counts as inclusive
+ * unless it is called from within itself
+ */
+void
+VCLCLASS CovLeave (FUNCRUNNING *fr)
+{
+    FUNCRUNNING *   up;
+    int             f = (int) ( fr->fvar - FunctionMemory );
+    double          t = CovNow() - fr->enter;
+
+    if ( fr->fprev != NULL )
+        fr->fprev->child += t;
+    if ( f < 0 || f >= FunctionsCount )
+        return;
+
+    Cover->funcs[f].excl += t - fr->child;
+    for ( up = fr->fprev; up != NULL; up = up->fprev )
+        if ( up->fvar == fr->fvar )
+            return;
+    Cover->funcs[f].incl += t;
+} /* CovLeave */
+
+
+/*
+ * Write the annotated source to sourcename.cov
+ */
+void
+VCLCLASS CovWrite (void)
+{
+    SRCFILE *       file;
+    FILE *          fp;
+    char *          cp;
+    char            pn[MAXPATH];
+    int             fileno;
+    int             f;
+    long            code = 0;           /* lines with code */
+    long            ran = 0;            /* of those, lines which ran */
+
+    /* build the sourcename.cov path */
+    strcpy( pn, (char *) FirstFile->fullname );
+    for ( cp = &pn[ strlen( pn ) - 1 ]; cp > pn; --cp )
+    {
+        if ( *cp == '.' )
+        {
+            *cp = NB;
+            break;
+        }
+        else if ( *cp == '\\' || *cp == '/' || *cp == ':' )
+            break;
+    }
+    strcat( pn, ".cov" );
+
+    if ( (fp = fopen( pn, "w" )) == NULL )
+    {
+        sprintf( ErrorMsg, "cannot open '%s' for writing", pn );
+        warning( FILERR );
+        return;
+    }
+
+    CovLines();
+
+    /* the files with code, in the order of their numbers */
+    for ( file = FirstFile, fileno = 1; file != NULL && fileno < COVFILES;
+          file = file->NextFile, ++fileno )
+    {
+        if ( Cover->nlines[fileno] || Cover->ncode[fileno] )
+            CovSource( fp, file, fileno, &code, &ran );
+    }
+
+    /* the library functions called */
+    fprintf( fp, "%9s:%5d:Library\n", "-", 0 );
+    for ( f = 0; f < FunctionsCount; ++f )
+        if ( FunctionMemory[f].libcode && Cover->funcs[f].calls )
+            CovFunc( fp, f );
+
+    fclose( fp );
+
+    fprintf( stderr, "\nCounts.... %ld of %ld lines with code ran, %6.02lf%%, see %s\n",
+             ran, code, code ? (double) ran / (double) code * 100.0 : 0.00, pn );
+} /* CovWrite */
+
+
+/*
+ * Write a source file with its counts
+ *
+ * Adds the lines with code and those of them which ran to *code
+ * and *ran
+ */
+void
+VCLCLASS CovSource (FILE *fp, SRCFILE *file, int fileno, long *code, long *ran)
+{
+    FILE *          sp;
+    char            buf[COVLINE];
+    char *          name = file->path ? file->path : (char *) file->fullname;
+    unsigned long   n;
+    int             lineno = 0;
+    int             bol = TRUE;         /* buf starts a line */
+    int             f;
+
+    fprintf( fp, "%9s:%5d:Source:%s\n", "-", 0, name );
+    if ( ( sp = fopen( name, "r" )) == NULL )
+    {
+        fprintf( fp, "%9s:%5d:Cannot open source\n", "-", 0 );
+        return;
+    }
+
+    while ( fgets( buf, sizeof( buf ), sp ) != NULL )
+    {
+        if ( ! bol )
+        {
+            fputs( buf, fp );           /* the rest of a long line */
+            bol = ( strchr( buf, '\n' ) != NULL );
+            continue;
+        }
+        ++lineno;
+
+        /* the functions declared on the line */
+        for ( f = 0; f < FunctionsCount; ++f )
+            if ( ! FunctionMemory[f].libcode && FunctionMemory[f].fileno == fileno &&
+                 FunctionMemory[f].lineno == lineno )
+                CovFunc( fp, f );
+
+        n = ( lineno < Cover->nlines[fileno] ) ? Cover->lines[fileno][lineno] : 0;
+        if ( n )
+        {
+            fprintf( fp, "%9lu:%5d:%s", n, lineno, buf );
+            ++*code;
+            ++*ran;
+        }
+        else if ( lineno < Cover->ncode[fileno] && Cover->code[fileno][lineno] )
+        {
+            fprintf( fp, "%9s:%5d:%s", "#####", lineno, buf );
+            ++*code;
+        }
+        else
+            fprintf( fp, "%9s:%5d:%s", "-", lineno, buf );
+
+        bol = ( strchr( buf, '\n' ) != NULL );
+        if ( ! bol && feof( sp ) )
+            fputc( '\n', fp );
+    }
+    fclose( sp );
+} /* CovSource */
+
+
+/*
+ * Write a function's calls and times
+ */
+void
+VCLCLASS CovFunc (FILE *fp, int f)
+{
+    char *          name = FindSymbolName( FunctionMemory[f].symbol );
+
+    fprintf( fp, "function %s called %lu inclusive %.6lfs exclusive %.6lfs\n",
+             name ? name : "?", Cover->funcs[f].calls,
+             Cover->funcs[f].incl, Cover->funcs[f].excl );
+} /* CovFunc */
+
+
+/*
+ * Mark the lines with code, from the T_LINENO tokens of the pcode
+ *
+ * A function's declaration has code, as its calls count against it,
+ * and so has each line on which a statement of its body starts
+ */
+void
+VCLCLASS CovLines (void)
+{
+    CTX             ctx = Ctx;          /* getoken() moves it */
+    uchar           wasStruct = isStruct;
+    int             f;
+
+    for ( f = 0; f < FunctionsCount; ++f )
+    {
+        if ( FunctionMemory[f].libcode || FunctionMemory[f].code == NULL )
+            continue;
+        CovCode( FunctionMemory[f].fileno, FunctionMemory[f].lineno );
+        Ctx.Progptr = (unsigned char *) FunctionMemory[f].code;
+        CovBody();
+    }
+    Ctx = ctx;
+    isStruct = wasStruct;
+} /* CovLines */
+
+
+/*
+ * Mark the lines on which the statements of a function body start
+ *
+ * Ctx.Progptr is at the body's '{'.  As in statement(), the local
+ * declarations at the start of a block, the braces, "else", case
+ * labels and the "while" of a do do not start a statement of their
+ * own, and a statement's continuation lines are not marked.
+ */
+void
+VCLCLASS CovBody (void)
+{
+    int             dos[MAXNESTS];      /* do's of each block, before while */
+    int             depth = 0;          /* blocks open */
+    int             data = 0;           /* an initializer's braces open */
+    int             paren = 0;          /* parentheses open */
+    int             cond = 0;           /* '?' before their ':' */
+    int             start = TRUE;       /* the next token starts a statement */
+    int             block = FALSE;      /* declarations may come next */
+    int             decl = FALSE;       /* in a local declaration */
+    int             header = FALSE;     /* in the (...) of an if, etc. */
+
+    while ( getoken() != T_EOF )
+    {
+        if ( decl )
+        {
+            if ( Ctx.Token == T_LBRACE )
+                ++data;
+            else if ( Ctx.Token == T_RBRACE )
+                --data;
+            else if ( Ctx.Token == T_SEMICOLON && data == 0 )
+            {
+                decl = FALSE;
+                start = TRUE;
+            }
+            continue;
+        }
+
+        switch ( Ctx.Token )
+        {
+            case T_LBRACE:
+                if ( ++depth < MAXNESTS )
+                    dos[depth] = 0;
+                start = block = TRUE;
+                continue;
+            case T_RBRACE:
+                if ( --depth == 0 )
+                    return;
+                start = TRUE;
+                block = FALSE;
+                continue;
+            case T_LPAREN:
+                ++paren;
+                break;
+            case T_RPAREN:
+                if ( --paren == 0 && header )
+                {
+                    header = FALSE;
+                    start = TRUE;       /* the statement of the if, etc. */
+                    continue;
+                }
+                break;
+            case T_COND:
+                ++cond;
+                break;
+            case T_COLON:
+                if ( cond )
+                    --cond;
+                else if ( paren == 0 )
+                {
+                    start = TRUE;       /* after a case or a label */
+                    continue;
+                }
+                break;
+            case T_SEMICOLON:
+                if ( paren == 0 )
+                {
+                    start = TRUE;
+                    continue;
+                }
+                break;
+        }
+        if ( ! start )
+            continue;
+
+        start = FALSE;
+        if ( block && isLocalType() )
+        {
+            decl = TRUE;
+            continue;
+        }
+        block = FALSE;
+
+        switch ( Ctx.Token )
+        {
+            case T_ELSE:
+                start = TRUE;
+                continue;
+            case T_PARALLEL:
+                start = TRUE;           /* its for follows */
+                break;
+            case T_CASE:
+            case T_DEFAULT:
+                continue;
+            case T_DO:
+                if ( depth < MAXNESTS )
+                    ++dos[depth];
+                start = TRUE;
+                break;
+            case T_WHILE:
+                header = TRUE;
+                if ( depth < MAXNESTS && dos[depth] )
+                {
+                    --dos[depth];       /* the end of a do */
+                    continue;
+                }
+                break;
+            case T_IF:
+            case T_FOR:
+            case T_SWITCH:
+                header = TRUE;
+                break;
+        }
+        CovCode( Ctx.CurrFileno, Ctx.CurrLineno );
+    }
+} /* CovBody */
+
+
+/*
+ * Mark a line as having code, growing its file's array to it
+ */
+void
+VCLCLASS CovCode (int f, int lineno)
+{
+    char *          cp;
+    int             n;
+
+    if ( f < 0 || f >= COVFILES || lineno < 0 )
+        return;
+
+    if ( lineno >= Cover->ncode[f] )
+    {
+        n = ( Cover->ncode[f] < 256 ) ? 256 : Cover->ncode[f];
+        while ( n <= lineno )
+            n *= 2;
+        if ( ( cp = (char *) realloc( Cover->code[f], n )) == NULL )
+            return;
+        memset( cp + Cover->ncode[f], 0, n - Cover->ncode[f] );
+        Cover->code[f] = cp;
+        Cover->ncode[f] = n;
+    }
+    Cover->code[f][lineno] = TRUE;
+} /* CovCode */
+
+
+/*
+ * Free the counts
+ */
+void
+VCLCLASS CovFree (void)
+{
+    int             f;
+
+    for ( f = 0; f < COVFILES; ++f )
+    {
+        free( Cover->lines[f] );
+        free( Cover->code[f] );
+    }
+    free( Cover->funcs );
+    free( Cover );
+    Cover = NULL;
+} /* CovFree */
+
+
+/*
+ * Seconds of the wall clock
+ */
+double
+VCLCLASS CovNow (void)
+{
+#ifdef __GLIBC__
+    struct timespec     ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+#else
+    return (double) clock() / (double) CLOCKS_PER_SEC;
+#endif
+} /* CovNow */
@@ -0,0 +1,458 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*unpubModule*****************************************************************
+ NAME
+    profile.c - Sampling profiler of the -p runtime option
+
+ DESCRIPTION
+    With -p a timer of the process's processor time, ITIMER_PROF, ticks
+    every PROFUSEC microseconds while the program runs.  The SIGPROF
+    handler only counts the tick.  The interpreter notices the count
+    has changed at the start of its next statement, see stmtbegin(),
+    and takes the sample there: the call stack, from Ctx.Curfunc along
+    fprev, and the line, Ctx.CurrFileno and Ctx.CurrLineno.  A sample
+    is weighed by the ticks since the last one, so a long library call
+    is charged to the line which made it.
+
+    Between ticks the interpreter pays only for a compare at each
+    statement.
+
+    When the run ends the call stacks are written to sourcename.PRF,
+    one line for each, the functions from main() on separated by ';'
+    and followed by the number of samples.  This is the collapsed stack
+    format of flame graph tools, e.g. "flamegraph.pl sourcename.PRF".
+    The functions and lines sampled most are reported on stderr.
+
+ FUNCTIONS
+    ProfStart()
+    ProfStop()
+    ProfSample()
+    ProfReport()
+
+    ProfWrite()
+    ProfName()
+    ProfFree()
+    ProfTick()
+
+ FILES
+    vcldef.h
+
+ SEE ALSO
+    stmt.c, vcl.c
+
+ NOTES
+    The timer and its handler are the process's.  Where several
+    instances run with -p at once, e.g. the tasks of vci-pt, each
+    samples at every tick of the process, so their counts are not
+    what each of them used.  The functions of spawn() and of a
+    parallel for run in instances of their own and are not sampled.
+
+    Lines are only known with line numbers in the pcode, i.e. not
+    with -l.  Stacks deeper than PROFDEPTH lose their outer frames.
+
+    The timer is not available in the DOS builds; the profile is
+    then empty.
+
+*****************************************************************unpubModule*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dir.h>                        // For MAXPATH
+#ifdef __GLIBC__
+#include <signal.h>                     // For sigaction()
+#include <sys/time.h>                   // For setitimer()
+#endif
+#include <sclib.h>
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef WRAPVCL
+#include "vcl.hpp"
+#else
+#include "vcldef.h"
+#endif
+
+#define PROFUSEC        1000            /* timer period, microseconds */
+
+/* the timer, common to all instances of the process */
+static volatile int     ProfTicks = 0;  /* ticks so far */
+#ifdef __GLIBC__
+static int              ProfUsers = 0;  /* instances profiling */
+static struct sigaction ProfOld;        /* SIGPROF action before */
+#ifdef VCL_PTHREADS
+static pthread_mutex_t  ProfLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void             ProfTick (int);
+#endif
+
+
+/*
+ * Start profiling the run
+ *
+ * Starts the timer unless another instance has
+ */
+void
+VCLCLASS ProfStart (void)
+{
+#ifdef __GLIBC__
+    struct sigaction    sa;
+    struct itimerval    it;
+#endif
+
+    if ( Prof != NULL || ( Prof = (PROFILE *) calloc( 1, sizeof( PROFILE ) )) == NULL )
+        return;
+    Prof->ticks = &ProfTicks;
+    Prof->seen = ProfTicks;
+
+#ifdef __GLIBC__
+#ifdef VCL_PTHREADS
+    pthread_mutex_lock( &ProfLock );
+#endif
+    if ( ProfUsers++ == 0 )
+    {
+        memset( &sa, 0, sizeof( sa ) );
+        sa.sa_handler = ProfTick;
+        sa.sa_flags = SA_RESTART;
+        sigemptyset( &sa.sa_mask );
+        sigaction( SIGPROF, &sa, &ProfOld );
+
+        it.it_interval.tv_sec = 0;
+        it.it_interval.tv_usec = PROFUSEC;
+        it.it_value = it.it_interval;
+        setitimer( ITIMER_PROF, &it, NULL );
+    }
+#ifdef VCL_PTHREADS
+    pthread_mutex_unlock( &ProfLock );
+#endif
+#endif
+} /* ProfStart */
+
+
+/*
+ * Stop profiling the run
+ *
+ * Stops the timer unless another instance is still profiling,
+ * then writes the stacks and the report, and frees the samples
+ */
+void
+VCLCLASS ProfStop (void)
+{
+#ifdef __GLIBC__
+    struct itimerval    it;
+
+#ifdef VCL_PTHREADS
+    pthread_mutex_lock( &ProfLock );
+#endif
+    if ( --ProfUsers == 0 )
+    {
+        memset( &it, 0, sizeof( it ) );
+        setitimer( ITIMER_PROF, &it, NULL );
+        sigaction( SIGPROF, &ProfOld, NULL );
+    }
+#ifdef VCL_PTHREADS
+    pthread_mutex_unlock( &ProfLock );
+#endif
+#endif
+
+    ProfWrite();
+    ProfReport( stderr );
+    ProfFree();
+} /* ProfStop */
+
+
+/*
+ * Take a sample, the timer has ticked since the last one
+ *
+ * Called by stmtbegin() at the start of a statement
+ */
+void
+VCLCLASS ProfSample (void)
+{
+    FUNCRUNNING *   fr;
+    PROFSTACK *     sp;
+    PROFLINE *      lp;
+    FUNCTION *      frames[PROFDEPTH];
+    FUNCTION *      leaf;
+    int             depth = 0;
+    int             n;
+    unsigned        h = 0;
+
+    n = *Prof->ticks - Prof->seen;
+    Prof->seen += n;
+    Prof->samples += n;
+
+    /* the call stack, the running function first */
+    for ( fr = Ctx.Curfunc; fr != NULL && depth < PROFDEPTH; fr = fr->fprev )
+    {
+        frames[depth++] = fr->fvar;
+        h = h * 31 + (unsigned) ( (size_t) fr->fvar / sizeof( FUNCTION ) );
+    }
+    h %= PROFHASH;
+    for ( sp = Prof->stacks[h]; sp != NULL; sp = sp->next )
+        if ( sp->depth == depth && ! memcmp( sp->frames, frames, depth * sizeof( FUNCTION * ) ) )
+            break;
+    if ( sp == NULL && ( sp = (PROFSTACK *) calloc( 1, sizeof( PROFSTACK ) )) != NULL )
+    {
+        memcpy( sp->frames, frames, depth * sizeof( FUNCTION * ) );
+        sp->depth = depth;
+        sp->next = Prof->stacks[h];
+        Prof->stacks[h] = sp;
+    }
+    if ( sp != NULL )
+        sp->count += n;
+
+    /* the line */
+    leaf = depth ? frames[0] : NULL;
+    h = (unsigned) ( Ctx.CurrFileno * 31 + Ctx.CurrLineno ) % PROFHASH;
+    for ( lp = Prof->lines[h]; lp != NULL; lp = lp->next )
+        if ( lp->lineno == Ctx.CurrLineno && lp->fileno == Ctx.CurrFileno &&
+             lp->fvar == leaf )
+            break;
+    if ( lp == NULL && ( lp = (PROFLINE *) calloc( 1, sizeof( PROFLINE ) )) != NULL )
+    {
+        lp->fvar = leaf;
+        lp->fileno = Ctx.CurrFileno;
+        lp->lineno = Ctx.CurrLineno;
+        lp->next = Prof->lines[h];
+        Prof->lines[h] = lp;
+    }
+    if ( lp != NULL )
+        lp->count += n;
+} /* ProfSample */
+
+
+/*
+ * Report the functions and lines sampled most
+ *
+ * A function's self samples are those in it, its total those
+ * with it anywhere on the call stack
+ */
+void
+VCLCLASS ProfReport (FILE *fp)
+{
+    unsigned long * self;
+    unsigned long * total;
+    int *           mark;
+    PROFLINE **     top;
+    PROFSTACK *     sp;
+    PROFLINE *      lp;
+    SRCFILE *       svfile = ThisFile;  /* SrcFileName() moves it */
+    double          all = (double) Prof->samples;
+    int             nlines = 0;
+    int             id = 0;
+    int             h;
+    int             i;
+    int             k;
+    int             f;
+
+    fprintf( fp, "\nProfile... %lu samples\n", Prof->samples );
+    if ( Prof->samples == 0 )
+        return;
+
+    /* by function, the last slot for code outside any */
+    self = (unsigned long *) calloc( FunctionsCount + 1, sizeof( unsigned long ) );
+    total = (unsigned long *) calloc( FunctionsCount + 1, sizeof( unsigned long ) );
+    mark = (int *) calloc( FunctionsCount + 1, sizeof( int ) );
+    if ( self != NULL && total != NULL && mark != NULL )
+    {
+        for ( h = 0; h < PROFHASH; ++h )
+        {
+            for ( sp = Prof->stacks[h]; sp != NULL; sp = sp->next )
+            {
+                ++id;
+                for ( i = 0; i < sp->depth || i == 0; ++i )
+                {
+                    f = ( i < sp->depth && sp->frames[i] != NULL ) ?
+                        (int) ( sp->frames[i] - FunctionMemory ) : FunctionsCount;
+                    if ( f < 0 || f > FunctionsCount )
+                        f = FunctionsCount;
+                    if ( i == 0 )
+                        self[f] += sp->count;
+                    if ( mark[f] != id )  /* once for a recursive one */
+                        total[f] += sp->count;
+                    mark[f] = id;
+                }
+            }
+        }
+
+        fprintf( fp, "  self%%  total%%  function\n" );
+        for ( k = 0; k < PROFTOP; ++k )
+        {
+            for ( i = 0, f = -1; i <= FunctionsCount; ++i )
+                if ( self[i] && ( f < 0 || self[i] > self[f] ) )
+                    f = i;
+            if ( f < 0 )
+                break;
+            fprintf( fp, "%6.02lf %7.02lf  ", self[f] / all * 100.0, total[f] / all * 100.0 );
+            if ( f < FunctionsCount )
+                fprintf( fp, "%s (%s:%d)\n", ProfName( FunctionMemory + f ),
+                         SrcFileName( FunctionMemory[f].fileno ), FunctionMemory[f].lineno );
+            else
+                fprintf( fp, "%s\n", ProfName( NULL ) );
+            self[f] = 0;
+        }
+    }
+    free( self );
+    free( total );
+    free( mark );
+
+    /* by line */
+    for ( h = 0; h < PROFHASH; ++h )
+        for ( lp = Prof->lines[h]; lp != NULL; lp = lp->next )
+            ++nlines;
+    if ( ( top = (PROFLINE **) calloc( nlines, sizeof( PROFLINE * ) )) != NULL )
+    {
+        for ( h = 0, i = 0; h < PROFHASH; ++h )
+            for ( lp = Prof->lines[h]; lp != NULL; lp = lp->next )
+                top[i++] = lp;
+
+        fprintf( fp, "  self%%  line\n" );
+        for ( k = 0; k < PROFTOP; ++k )
+        {
+            for ( i = 0, f = -1; i < nlines; ++i )
+                if ( top[i] != NULL && ( f < 0 || top[i]->count > top[f]->count ) )
+                    f = i;
+            if ( f < 0 )
+                break;
+            lp = top[f];
+            fprintf( fp, "%6.02lf  %s:%d  %s\n", lp->count / all * 100.0,
+                     lp->fileno > 0 ? SrcFileName( lp->fileno ) : "?",
+                     lp->lineno, ProfName( lp->fvar ) );
+            top[f] = NULL;
+        }
+        free( top );
+    }
+
+    ThisFile = svfile;
+} /* ProfReport */
+
+
+/*
+ * Write the call stacks to sourcename.PRF, collapsed
+ */
+void
+VCLCLASS ProfWrite (void)
+{
+    PROFSTACK *     sp;
+    FILE *          fp;
+    char *          cp;
+    char            pn[MAXPATH];
+    int             h;
+    int             i;
+
+    /* build the sourcename.prf path */
+    strcpy( pn, (char *) FirstFile->fullname );
+    for ( cp = &pn[ strlen( pn ) - 1 ]; cp > pn; --cp )
+    {
+        if ( *cp == '.' )
+        {
+            *cp = NB;
+            break;
+        }
+        else if ( *cp == '\\' || *cp == '/' || *cp == ':' )
+            break;
+    }
+    strcat( pn, ".prf" );
+
+    if ( (fp = fopen( pn, "w" )) == NULL )
+    {
+        sprintf( ErrorMsg, "cannot open '%s' for writing", pn );
+        warning( FILERR );
+        return;
+    }
+
+    /* main() first, i.e. the stack backwards */
+    for ( h = 0; h < PROFHASH; ++h )
+    {
+        for ( sp = Prof->stacks[h]; sp != NULL; sp = sp->next )
+        {
+            if ( sp->count == 0 )
+                continue;
+            if ( sp->depth == 0 )
+                fputs( ProfName( NULL ), fp );
+            for ( i = sp->depth - 1; i >= 0; --i )
+                fprintf( fp, "%s%c", ProfName( sp->frames[i] ), i ? ';' : ' ' );
+            fprintf( fp, "%s%lu\n", sp->depth ? "" : " ", sp->count );
+        }
+    }
+
+    fclose( fp );
+} /* ProfWrite */
+
+
+/*
+ * Name of a function sampled, NULL for code outside any
+ */
+char *
+VCLCLASS ProfName (FUNCTION *fvar)
+{
+    char *          name;
+
+    if ( fvar == NULL )
+        return "(global)";
+    name = FindSymbolName( fvar->symbol );
+    return name ? name : "?";
+} /* ProfName */
+
+
+/*
+ * Free the samples
+ */
+void
+VCLCLASS ProfFree (void)
+{
+    PROFSTACK *     sp;
+    PROFLINE *      lp;
+    int             h;
+
+    for ( h = 0; h < PROFHASH; ++h )
+    {
+        while ( ( sp = Prof->stacks[h] ) != NULL )
+        {
+            Prof->stacks[h] = sp->next;
+            free( sp );
+        }
+        while ( ( lp = Prof->lines[h] ) != NULL )
+        {
+            Prof->lines[h] = lp->next;
+            free( lp );
+        }
+    }
+    free( Prof );
+    Prof = NULL;
+} /* ProfFree */
+
+
+#ifdef __GLIBC__
+/*
+ * SIGPROF handler, counts the tick
+ */
+static void
+ProfTick (int sig)
+{
+    sig = sig;                          /* avoid 'not used' compiler warning */
+    ++ProfTicks;
+} /* ProfTick */
+#endif
@@ -1,722 +1,1126 @@
-/*
- * Licensed to the Apache Software Foundation (ASF) under one
- * or more contributor license agreements.  See the NOTICE file
- * distributed with this work for additional information
- * regarding copyright ownership.  The ASF licenses this file
- * to you under the Apache License, Version 2.0 (the
- * "License"); you may not use this file except in compliance
- * with the License.  You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-/*
-    Copyright (c) 1989-1993
-    by Todd R. Hill
-    All Rights Reserved
-*/
-
-/*unpubModule*****************************************************************
- NAME
-    stmt.c - Interpreter statement processing
-
- DESCRIPTION
-    Interprets keywords, initializers, and recursive statement skipping.
-
- FUNCTIONS
-    statement()
-    stmtbegin()
-    stmtend()
-
-    DoStatement()
-    InitializeLocalVariables()
-    skipstatement()
-
- FILES
-    vcldef.h
-
- SEE ALSO
-
- NOTES
-
- BUGS
-
-*****************************************************************unpubModule*/
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <setjmp.h>
-#ifdef __cplusplus
-}
-#endif
-
-#ifdef WRAPVCL
-#include "vcl.hpp"
-#else
-#include "vcldef.h"
-#endif
-
-/*
- * Execute one statement or block
- * return false if longjmp (goto) occurred
- */
-int
-VCLCLASS DoStatement (void)
-{
-    if ( Ctx.Curfunc->BlkNesting < MAXNESTS )
-        if ( setjmp( gotojmp[Ctx.Curfunc->BlkNesting] ) != 0 )
-            return 0;
-    setjmp( stmtjmp.jb );
-    stmtjmp.jmp_ctx = Ctx;
-    statement();
-    return 1;
-} /* DoStatement */
-
-
-/*
- * Evaluate a statement
- */
-void
-VCLCLASS statement (void)
-{
-    unsigned char * repeat;
-    unsigned char * body;
-    unsigned char * iterate;
-    int             svlineno;
-    int             svfileno;
-    int             argc;
-    int             i;
-
-    if ( Ctx.Token != T_LBRACE && Ctx.Token != T_RBRACE )
-        stmtbegin();
-
-    if ( isTypeDeclaration() )
-        error( BADVARERR );
-    switch ( Ctx.Token )
-    {
-        case T_LBRACE:
-            /*
-             * parse a compound statement
-             */
-            Ctx.svpptr = Ctx.Progptr;
-            getoken();
-
-            Assert( Ctx.Curfunc != NULL );
-
-            /* supports the debugger */
-            Ctx.Curfunc->BlkNesting++;
-
-            while ( istypespec() || Ctx.Token == T_CONST ||
-                    Ctx.Token == T_VOLATILE || Ctx.Token == T_VOID ||
-                    Ctx.Token == T_REGISTER || Ctx.Token == T_AUTO ||
-                    Ctx.Token == T_STATIC || Ctx.Token == T_EXTERNAL )
-            {
-                InitializeLocalVariables();
-                stmtend();
-            }
-
-            /* loop executing statements until return, break, continue, and
-               goto nesting not exceeded or the closing right brace */
-            while ( ! ( Saw_return || Saw_break || Saw_continue ) &&
-                    ( GotoNesting || Ctx.Token != T_RBRACE ) )
-                DoStatement();
-
-            if ( Saw_break || Saw_continue )
-                while ( Ctx.Token != T_RBRACE && Ctx.Token != T_EOF )
-                    getoken();
-
-            if ( Ctx.Token == T_RBRACE )
-                getoken();
-            else if ( ! Saw_return )
-                error( RBRACERR );
-
-            /* supports the debugger */
-            --Ctx.Curfunc->BlkNesting;
-            break;
-
-        case T_RBRACE:
-            getoken();
-            if ( GotoNesting )
-                if ( --GotoNesting == Ctx.Curfunc->BlkNesting )
-                    GotoNesting = 0;
-            break;
-
-        case T_GOTO:
-            if ( getoken() != T_IDENTIFIER )
-                error( GOTOERR );
-            if ( Ctx.Curvar == NULL )
-                error( GOTOERR );
-
-            GotoOffset = Ctx.Curvar->voffset;
-            getoken();
-            stmtend();
-            Ctx.Progptr = Progstart + GotoOffset;
-            getoken();
-            Saw_break = Saw_return = Saw_continue = 0;
-            if ( Ctx.Curvar->vcat > Ctx.Curfunc->BlkNesting )
-                GotoNesting = Ctx.Curvar->vcat;
-            else if ( Ctx.Curvar->vcat < Ctx.Curfunc->BlkNesting )
-                if ( Ctx.Curvar->vcat < MAXNESTS )
-                    longjmp( gotojmp[Ctx.Curvar->vcat], 1 );
-            break;
-
-        case T_IF:
-            /*
-             * parse an "if-else" statement
-             */
-            if ( getoken() != T_LPAREN )
-                error( LPARENERR );
-            getoken();
-            argc = expression();
-            if ( Ctx.Token != T_RPAREN )
-                error( RPARENERR );
-            getoken();
-            if ( popnint( argc ) )
-            {
-                if ( ! DoStatement() )
-                    break;
-                if ( Ctx.Token == T_ELSE )
-                {
-                    getoken();
-                    skipstatement();
-                }
-            }
-            else
-            {
-                skipstatement();
-                if ( Ctx.Token == T_ELSE )
-                {
-                    getoken();
-                    DoStatement();
-                }
-            }
-            break;
-
-        case T_ELSE:
-            getoken();
-            skipstatement();
-            break;
-
-        case T_WHILE:
-            {
-                int             dost = 1;
-
-                /*
-                 * parse a "while" statement
-                 */
-                ++Ctx.Looping;
-                repeat = Ctx.Progptr;
-                svlineno = Ctx.CurrLineno;
-                svfileno = Ctx.CurrFileno;
-                for ( ;; )
-                {
-                    if ( getoken() != T_LPAREN )
-                        error( LPARENERR );
-
-                    stmtbegin();
-                    getoken();
-                    argc = expression();
-                    if ( Ctx.Token != T_RPAREN )
-                        error( RPARENERR );
-
-                    if ( popnint( argc ) )
-                    {
-                        body = Ctx.Progptr;
-                        getoken();
-                        if ( ! ( dost = DoStatement() ) )
-                            break;
-                        if ( Saw_return || Saw_break )
-                        {
-                            Ctx.Progptr = body;
-                            Saw_break = 0;
-                            break;
-                        }
-                        Ctx.Progptr = repeat;
-                        Ctx.CurrLineno = svlineno;
-                        Ctx.CurrFileno = svfileno;
-                        Saw_continue = 0;
-                    }
-                    else
-                        break;
-                }
-                --Ctx.Looping;
-                if ( dost )
-                {
-                    getoken();
-                    skipstatement();
-                }
-                break;
-            }
-
-        case T_DO:
-            /*
-             * Parse a "do-while" statement:
-             */
-            ++Ctx.Looping;
-            repeat = Ctx.Progptr;
-            svlineno = Ctx.CurrLineno;
-            svfileno = Ctx.CurrFileno;
-            for ( ;; )
-            {
-                stmtbegin();
-                getoken();
-                if ( ! DoStatement() )
-                    break;
-                if ( Ctx.Token != T_WHILE )
-                    error( WHILERR );
-                if ( getoken() != T_LPAREN )
-                    error( LPARENERR );
-                getoken();
-                argc = expression();
-                if ( Ctx.Token != T_RPAREN )
-                    error( RPARENERR );
-                getoken();
-                stmtend();
-
-                if ( popnint( argc ) )
-                {
-                    if ( Saw_return || Saw_break )
-                    {
-                        Saw_break = 0;
-                        break;
-                    }
-                    Ctx.CurrLineno = svlineno;
-                    Ctx.CurrFileno = svfileno;
-                    Ctx.Progptr = repeat;
-                    Saw_continue = 0;
-                }
-                else
-                    break;
-            }
-            --Ctx.Looping;
-            break;
-
-        case T_FOR:
-            {
-                int             dost = 1;
-
-                /*-
-                 * Parse a "for" statement:
-                 *
-                 *   for (<initialization> ; <test> ; <iteration>)
-                 *      <statement>
-                 */
-                if ( getoken() != T_LPAREN )
-                    error( LPARENERR );
-                stmtbegin();
-                if ( getoken() != T_SEMICOLON )
-                {
-                    /*
-                     * Do <initialization> part
-                     */
-                    popn( expression() );
-                }
-                if ( Ctx.Token != T_SEMICOLON )
-                    error( SEMIERR );
-
-                /*
-                 * Progptr now points to <test> part - save this address.
-                 */
-                ++Ctx.Looping;
-                svlineno = Ctx.CurrLineno;
-                svfileno = Ctx.CurrFileno;
-                repeat = Ctx.Progptr;
-                for ( ;; )
-                {
-                    stmtbegin();
-                    if ( getoken() == T_SEMICOLON )
-                    {
-                        /*
-                         * Missing <test> part means it's always TRUE.
-                         */
-                        pushint( argc = 1, FALSE );
-                    }
-                    else
-                    {
-                        /*
-                         * Do the <test> part.
-                         */
-                        argc = expression();
-                        if ( Ctx.Token != T_SEMICOLON )
-                            error( SEMIERR );
-                    }
-
-                    /*
-                     * Progptr now points to <iteration> part, skip over it
-                     * now.
-                     */
-                    iterate = Ctx.Progptr;
-                    getoken();          /* get rid of ';' */
-                    while ( Ctx.Token != T_RPAREN && Ctx.Token != T_EOF )
-                    {
-                        if ( Ctx.Token == T_LPAREN )
-                            skip( T_LPAREN, T_RPAREN );
-                        else
-                            getoken();
-                    }
-                    if ( Ctx.Token != T_RPAREN )
-                    {
-                        Ctx.Progptr = iterate;
-                        getoken();
-                        error( RPARENERR );
-                    }
-
-                    /*
-                     * Check <test> part for non-zero value
-                     */
-                    if ( popnint( argc ) )
-                    {
-                        /*
-                         * Do <statement> part, the body of the loop.
-                         */
-                        body = Ctx.Progptr;
-                        getoken();
-                        if ( ! ( dost = DoStatement() ) )
-                            break;
-                        if ( Saw_return || Saw_break )
-                        {
-                            /*
-                             * Encountered either a "return", a "break" or an
-                             * error; break out of loop.
-                             */
-                            Ctx.Progptr = body;
-                            Saw_break = 0;
-                            break;
-                        }
-                        /*
-                         * Now go back to <iteration> part and do it.
-                         */
-                        Ctx.Progptr = iterate;
-                        if ( getoken() != T_RPAREN )
-                            popn( expression() );
-
-                        Saw_continue = 0;
-                        Ctx.CurrLineno = svlineno;
-                        Ctx.CurrFileno = svfileno;
-                        Ctx.Progptr = repeat;
-                    }
-                    else
-                        break;
-                }
-                --Ctx.Looping;
-                if ( dost )
-                {
-                    getoken();
-                    skipstatement();
-                }
-                break;
-            }
-
-        case T_SWITCH:
-            {
-                int             dost = 1;
-
-                /*
-                 * Parse a "switch" statement
-                 */
-                if ( getoken() != T_LPAREN )
-                    error( LPARENERR );
-                getoken();
-                i = popnint( expression() );
-                if ( Ctx.Token != T_RPAREN )
-                    error( RPARENERR );
-
-                body = Ctx.Progptr;     /* just after ')' */
-                getoken();              /* get rid of ')' */
-
-                if ( Ctx.Token == T_LBRACE )
-                    getoken();          /* get rid of '{' */
-
-                ++Ctx.Switching;
-                while ( ! ( Saw_break || Saw_return ) && Ctx.Token != T_RBRACE )
-                {
-                    if ( Ctx.Token == T_CASE )
-                    {
-                        getoken();
-                        argc = expression();
-                        if ( Ctx.Token != T_COLON )
-                            error( COLONERR );
-                        getoken();
-                        if ( i == popnint( argc ) )
-                        {
-                            while ( ! ( Saw_break || Saw_continue || Saw_return ) &&
-                                    Ctx.Token != T_RBRACE )
-                            {
-                                if ( ! ( dost = DoStatement() ) )
-                                    break;
-                            }
-                        }
-                        else
-                        {
-                            if ( Ctx.Token != T_CASE && Ctx.Token != T_DEFAULT )
-                                skipstatement();
-                        }
-                    }
-                    else if ( Ctx.Token == T_DEFAULT )
-                    {
-                        if ( getoken() != T_COLON )
-                            error( COLONERR );
-                        getoken();
-                        while ( ! ( Saw_break || Saw_return ) && Ctx.Token != T_RBRACE )
-                            if ( ! ( dost = DoStatement() ) )
-                                break;
-                    }
-                    else
-                        skipstatement();
-                }
-                --Ctx.Switching;
-                Saw_break = 0;
-                if ( dost )
-                {
-                    Ctx.Progptr = body;
-                    getoken();
-                    skipstatement();
-                }
-                break;
-            }
-
-        case T_CASE:
-        case T_DEFAULT:
-            skipstatement();
-            break;
-
-        case T_RETURN:
-            /*
-             * parse a "return" statement
-             */
-            if ( getoken() == T_SEMICOLON )
-            {
-                /* return; */
-                TestZeroReturn();
-                pushint( 0, FALSE );
-            }
-            else
-            {
-                /* return val; */
-                if ( Ctx.Curfunc != NULL )
-                {
-                    if ( Ctx.Curfunc->fvar->type == VOID &&
-                         Ctx.Curfunc->fvar->cat == 0 )
-                        error( VOIDRETERR );
-                }
-                expression();
-
-            }
-            ++Saw_return;
-            stmtend();
-            break;
-
-        case T_BREAK:
-            /*
-             * parse a "break" statement
-             */
-            if ( Ctx.Looping || Ctx.Switching )
-            {
-                getoken();
-                ++Saw_break;
-            }
-            else
-                error( BREAKERR );
-            stmtend();
-            break;
-
-        case T_CONTINUE:
-            /*
-             * parse a "continue" statement
-             */
-            if ( Ctx.Looping )
-            {
-                getoken();
-                ++Saw_continue;
-            }
-            else
-                error( CONTERR );
-            stmtend();
-            break;
-
-        case T_SEMICOLON:
-            stmtend();
-            break;
-
-        default:
-            /*
-             * parse an expression statement
-             */
-            if ( ExpressionOne() )
-                pop();
-            if ( Ctx.Token == T_RPAREN || Ctx.Token == T_RBRACKET )
-                error( BADLBRACERR );
-            stmtend();
-    }
-} /* statement */
-
-
-void
-VCLCLASS InitializeLocalVariables (void)
-{
-    while ( Ctx.Token != T_SEMICOLON )
-    {
-        while ( Ctx.Token == T_STATIC ||
-                Ctx.Token == T_CONST ||
-                Ctx.Token == T_AUTO ||
-                Ctx.Token == T_REGISTER ||
-                Ctx.Token == T_VOLATILE )
-            getoken();
-        if ( Ctx.Token == T_STRUCT ||
-             Ctx.Token == T_UNION ||
-             Ctx.Token == T_ENUM )
-        {
-            getoken();                  /* get a struct/union/enum tag or a { */
-            if ( Ctx.Token == T_IDENTIFIER )
-                getoken();              /* get the one past the tag */
-            if ( Ctx.Token == T_LBRACE )
-                skip( T_LBRACE, T_RBRACE );
-        }
-        else
-            getoken();
-
-        if ( Ctx.Token == T_IDENTIFIER && ! Ctx.Curvar->vstatic )
-        {
-            getoken();
-            while ( Ctx.Token == T_LBRACKET )
-            {
-                do
-                    getoken();
-                while ( Ctx.Token != T_RBRACKET );
-                getoken();
-            }
-            if ( Ctx.Token == T_ASSIGN )
-            {
-                VARIABLE *      pvar = Ctx.Curvar;
-
-                Assert( pvar != NULL );
-                stmtbegin();
-                getoken();              /* get initializer expression */
-                Initializer( pvar, (char *) DataAddress( pvar ), 0 );
-            }
-        }
-    }
-} /* InitializeLocalVariables */
-
-
-/*
- * Beginning of statement processing.
- * Stop at every line and activate debugger.
- */
-void
-VCLCLASS stmtbegin (void)
-{
-#if DEBUGGER
-    int             kbhit(void);
-
-    if ( StepCount == 0 )
-    {
-        int             debugger(void);
-
-        if ( debugger() )
-        {
-            pushint( 0 );
-            longjmp( Shelljmp, 2 );
-        }
-    }
-    kbhit();
-#endif
-} /* stmtbegin */
-
-
-/*
- * Handle end of statement
- */
-void
-VCLCLASS stmtend (void)
-{
-    if ( ! longjumping )
-    {
-        Ctx.svpptr = Ctx.Progptr;
-        if ( Ctx.Token == T_SEMICOLON )
-            getoken();
-        else
-            error( SEMIERR );
-    }
-} /* stmtend */
-
-
-/*
- * Skip a statement
- */
-void
-VCLCLASS skipstatement (void)
-{
-    switch ( Ctx.Token )
-    {
-        case T_LBRACE:
-            /*
-             * skip a compound statement
-             */
-            skip( T_LBRACE, T_RBRACE );
-            break;
-
-        case T_IF:
-            /*
-             * skip an "if-else" statement
-             */
-            getoken();                  /* skip 'if' */
-            skip( T_LPAREN, T_RPAREN );
-            skipstatement();
-            if ( Ctx.Token == T_ELSE )
-            {
-                getoken();              /* skip 'else' */
-                skipstatement();
-            }
-            break;
-
-        case T_DO:
-            /*
-             * skip a "do-while" statement
-             */
-            getoken();                  /* skip 'do' */
-            skipstatement();
-            getoken();                  /* skip 'while' */
-            skip( T_LPAREN, T_RPAREN );
-            stmtend();
-            break;
-
-        case T_WHILE:
-        case T_FOR:
-        case T_SWITCH:
-            /*
-             * skip a "while", "for" or "switch" statement
-             */
-            getoken();                  /* skip 'while' */
-            skip( T_LPAREN, T_RPAREN );
-            skipstatement();
-            break;
-
-        case T_CASE:
-        case T_DEFAULT:
-            while ( getoken() != T_COLON )
-                ;
-            getoken();
-            break;
-
-        default:
-            /*
-             * skip a one-liner
-             */
-            while ( Ctx.Token != T_SEMICOLON && Ctx.Token != T_RBRACE && Ctx.Token != T_EOF )
-                getoken();
-            if ( Ctx.Token == T_EOF )
-                error( RBRACERR );
-            if ( Ctx.Token == T_SEMICOLON )
-                getoken();
-    }
-} /* skipstatement */
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+    Copyright (c) 1989-1993
+    by Todd R. Hill
+    All Rights Reserved
+*/
+
+/*unpubModule*****************************************************************
+ NAME
+    stmt.c - Interpreter statement processing
+
+ DESCRIPTION
+    Interprets keywords, initializers, and recursive statement skipping.
+
+    A for loop after "#pragma parallel for" is handed to the host's
+    spawn hooks (see vclSpawn()) to run its iterations on the host's
+    threads.  Each thread runs the loop body with a copy of the
+    function's locals, so assignments to locals other than the loop's
+    reduction variables are not seen after the loop.  A loop with more
+    than MAXREDUCE reduction variables runs serially.
+
+ FUNCTIONS
+    statement()
+    stmtbegin()
+    stmtend()
+
+    DoStatement()
+    InitializeLocalVariables()
+    skipstatement()
+    ParallelFor()
+    LoopShape()
+    LoopBody()
+    ReduceInit()
+    ReduceMerge()
+
+ FILES
+    vcldef.h
+
+ SEE ALSO
+
+ NOTES
+
+ BUGS
+
+*****************************************************************unpubModule*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <setjmp.h>
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef WRAPVCL
+#include "vcl.hpp"
+#else
+#include "vcldef.h"
+#endif
+
+/*
+ * Execute one statement or block
+ * return false if longjmp (goto) occurred
+ */
+int
+VCLCLASS DoStatement (void)
+{
+    if ( Ctx.Curfunc->BlkNesting < MAXNESTS )
+        if ( setjmp( gotojmp[Ctx.Curfunc->BlkNesting] ) != 0 )
+            return 0;
+    setjmp( stmtjmp.jb );
+    stmtjmp.jmp_ctx = Ctx;
+    statement();
+    return 1;
+} /* DoStatement */
+
+
+/*
+ * Evaluate a statement
+ */
+void
+VCLCLASS statement (void)
+{
+    unsigned char * repeat;
+    unsigned char * body;
+    unsigned char * iterate;
+    int             svlineno;
+    int             svfileno;
+    int             argc;
+    int             i;
+
+    if ( Ctx.Token != T_LBRACE && Ctx.Token != T_RBRACE )
+        stmtbegin();
+
+    if ( isTypeDeclaration() )
+        error( BADVARERR );
+    switch ( Ctx.Token )
+    {
+        case T_LBRACE:
+            /*
+             * parse a compound statement
+             */
+            Ctx.svpptr = Ctx.Progptr;
+            getoken();
+
+            Assert( Ctx.Curfunc != NULL );
+
+            /* supports the debugger */
+            Ctx.Curfunc->BlkNesting++;
+
+            while ( istypespec() || Ctx.Token == T_CONST ||
+                    Ctx.Token == T_VOLATILE || Ctx.Token == T_VOID ||
+                    Ctx.Token == T_REGISTER || Ctx.Token == T_AUTO ||
+                    Ctx.Token == T_STATIC || Ctx.Token == T_EXTERNAL )
+            {
+                InitializeLocalVariables();
+                stmtend();
+            }
+
+            /* loop executing statements until return, break, continue, and
+               goto nesting not exceeded or the closing right brace */
+            while ( ! ( Saw_return || Saw_break || Saw_continue ) &&
+                    ( GotoNesting || Ctx.Token != T_RBRACE ) )
+                DoStatement();
+
+            if ( Saw_break || Saw_continue )
+                while ( Ctx.Token != T_RBRACE && Ctx.Token != T_EOF )
+                    getoken();
+
+            if ( Ctx.Token == T_RBRACE )
+                getoken();
+            else if ( ! Saw_return )
+                error( RBRACERR );
+
+            /* supports the debugger */
+            --Ctx.Curfunc->BlkNesting;
+            break;
+
+        case T_RBRACE:
+            getoken();
+            if ( GotoNesting )
+                if ( --GotoNesting == Ctx.Curfunc->BlkNesting )
+                    GotoNesting = 0;
+            break;
+
+        case T_GOTO:
+            if ( getoken() != T_IDENTIFIER )
+                error( GOTOERR );
+            if ( Ctx.Curvar == NULL )
+                error( GOTOERR );
+
+            GotoOffset = Ctx.Curvar->voffset;
+            getoken();
+            stmtend();
+            Ctx.Progptr = Progstart + GotoOffset;
+            BudgetTick();
+            getoken();
+            Saw_break = Saw_return = Saw_continue = 0;
+            if ( Ctx.Curvar->vcat > Ctx.Curfunc->BlkNesting )
+                GotoNesting = Ctx.Curvar->vcat;
+            else if ( Ctx.Curvar->vcat < Ctx.Curfunc->BlkNesting )
+                if ( Ctx.Curvar->vcat < MAXNESTS )
+                    longjmp( gotojmp[Ctx.Curvar->vcat], 1 );
+            break;
+
+        case T_IF:
+            /*
+             * parse an "if-else" statement
+             */
+            if ( getoken() != T_LPAREN )
+                error( LPARENERR );
+            getoken();
+            argc = expression();
+            if ( Ctx.Token != T_RPAREN )
+                error( RPARENERR );
+            getoken();
+            if ( popnint( argc ) )
+            {
+                if ( ! DoStatement() )
+                    break;
+                if ( Ctx.Token == T_ELSE )
+                {
+                    getoken();
+                    skipstatement();
+                }
+            }
+            else
+            {
+                skipstatement();
+                if ( Ctx.Token == T_ELSE )
+                {
+                    getoken();
+                    DoStatement();
+                }
+            }
+            break;
+
+        case T_ELSE:
+            getoken();
+            skipstatement();
+            break;
+
+        case T_WHILE:
+            {
+                int             dost = 1;
+
+                /*
+                 * parse a "while" statement
+                 */
+                ++Ctx.Looping;
+                repeat = Ctx.Progptr;
+                svlineno = Ctx.CurrLineno;
+                svfileno = Ctx.CurrFileno;
+                for ( ;; )
+                {
+                    if ( getoken() != T_LPAREN )
+                        error( LPARENERR );
+
+                    stmtbegin();
+                    getoken();
+                    argc = expression();
+                    if ( Ctx.Token != T_RPAREN )
+                        error( RPARENERR );
+
+                    if ( popnint( argc ) )
+                    {
+                        body = Ctx.Progptr;
+                        getoken();
+                        if ( ! ( dost = DoStatement() ) )
+                            break;
+                        if ( Saw_return || Saw_break )
+                        {
+                            Ctx.Progptr = body;
+                            Saw_break = 0;
+                            break;
+                        }
+                        Ctx.Progptr = repeat;
+                        Ctx.CurrLineno = svlineno;
+                        Ctx.CurrFileno = svfileno;
+                        Saw_continue = 0;
+                        BudgetTick();
+                    }
+                    else
+                        break;
+                }
+                --Ctx.Looping;
+                if ( dost )
+                {
+                    getoken();
+                    skipstatement();
+                }
+                break;
+            }
+
+        case T_DO:
+            /*
+             * Parse a "do-while" statement:
+             */
+            ++Ctx.Looping;
+            repeat = Ctx.Progptr;
+            svlineno = Ctx.CurrLineno;
+            svfileno = Ctx.CurrFileno;
+            for ( ;; )
+            {
+                stmtbegin();
+                getoken();
+                if ( ! DoStatement() )
+                    break;
+                if ( Ctx.Token != T_WHILE )
+                    error( WHILERR );
+                if ( getoken() != T_LPAREN )
+                    error( LPARENERR );
+                getoken();
+                argc = expression();
+                if ( Ctx.Token != T_RPAREN )
+                    error( RPARENERR );
+                getoken();
+                stmtend();
+
+                if ( popnint( argc ) )
+                {
+                    if ( Saw_return || Saw_break )
+                    {
+                        Saw_break = 0;
+                        break;
+                    }
+                    Ctx.CurrLineno = svlineno;
+                    Ctx.CurrFileno = svfileno;
+                    Ctx.Progptr = repeat;
+                    Saw_continue = 0;
+                    BudgetTick();
+                }
+                else
+                    break;
+            }
+            --Ctx.Looping;
+            break;
+
+        case T_FOR:
+            {
+                int             dost = 1;
+
+                /*-
+                 * Parse a "for" statement:
+                 *
+                 *   for (<initialization> ; <test> ; <iteration>)
+                 *      <statement>
+                 */
+                if ( getoken() != T_LPAREN )
+                    error( LPARENERR );
+                stmtbegin();
+                if ( getoken() != T_SEMICOLON )
+                {
+                    /*
+                     * Do <initialization> part
+                     */
+                    popn( expression() );
+                }
+                if ( Ctx.Token != T_SEMICOLON )
+                    error( SEMIERR );
+
+                /*
+                 * Progptr now points to <test> part - save this address.
+                 */
+                ++Ctx.Looping;
+                svlineno = Ctx.CurrLineno;
+                svfileno = Ctx.CurrFileno;
+                repeat = Ctx.Progptr;
+                for ( ;; )
+                {
+                    stmtbegin();
+                    if ( getoken() == T_SEMICOLON )
+                    {
+                        /*
+                         * Missing <test> part means it's always TRUE.
+                         */
+                        pushint( argc = 1, FALSE );
+                    }
+                    else
+                    {
+                        /*
+                         * Do the <test> part.
+                         */
+                        argc = expression();
+                        if ( Ctx.Token != T_SEMICOLON )
+                            error( SEMIERR );
+                    }
+
+                    /*
+                     * Progptr now points to <iteration> part, skip over it
+                     * now.
+                     */
+                    iterate = Ctx.Progptr;
+                    getoken();          /* get rid of ';' */
+                    while ( Ctx.Token != T_RPAREN && Ctx.Token != T_EOF )
+                    {
+                        if ( Ctx.Token == T_LPAREN )
+                            skip( T_LPAREN, T_RPAREN );
+                        else
+                            getoken();
+                    }
+                    if ( Ctx.Token != T_RPAREN )
+                    {
+                        Ctx.Progptr = iterate;
+                        getoken();
+                        error( RPARENERR );
+                    }
+
+                    /*
+                     * Check <test> part for non-zero value
+                     */
+                    if ( popnint( argc ) )
+                    {
+                        /*
+                         * Do <statement> part, the body of the loop.
+                         */
+                        body = Ctx.Progptr;
+                        getoken();
+                        if ( ! ( dost = DoStatement() ) )
+                            break;
+                        if ( Saw_return || Saw_break )
+                        {
+                            /*
+                             * Encountered either a "return", a "break" or an
+                             * error; break out of loop.
+                             */
+                            Ctx.Progptr = body;
+                            Saw_break = 0;
+                            break;
+                        }
+                        /*
+                         * Now go back to <iteration> part and do it.
+                         */
+                        Ctx.Progptr = iterate;
+                        if ( getoken() != T_RPAREN )
+                            popn( expression() );
+
+                        Saw_continue = 0;
+                        Ctx.CurrLineno = svlineno;
+                        Ctx.CurrFileno = svfileno;
+                        Ctx.Progptr = repeat;
+                        BudgetTick();
+                    }
+                    else
+                        break;
+                }
+                --Ctx.Looping;
+                if ( dost )
+                {
+                    getoken();
+                    skipstatement();
+                }
+                break;
+            }
+
+        case T_PARALLEL:
+            ParallelFor();
+            break;
+
+        case T_SWITCH:
+            {
+                int             dost = 1;
+
+                /*
+                 * Parse a "switch" statement
+                 */
+                if ( getoken() != T_LPAREN )
+                    error( LPARENERR );
+                getoken();
+                i = popnint( expression() );
+                if ( Ctx.Token != T_RPAREN )
+                    error( RPARENERR );
+
+                body = Ctx.Progptr;     /* just after ')' */
+                getoken();              /* get rid of ')' */
+
+                if ( Ctx.Token == T_LBRACE )
+                    getoken();          /* get rid of '{' */
+
+                ++Ctx.Switching;
+                while ( ! ( Saw_break || Saw_return ) && Ctx.Token != T_RBRACE )
+                {
+                    if ( Ctx.Token == T_CASE )
+                    {
+                        getoken();
+                        argc = expression();
+                        if ( Ctx.Token != T_COLON )
+                            error( COLONERR );
+                        getoken();
+                        if ( i == popnint( argc ) )
+                        {
+                            while ( ! ( Saw_break || Saw_continue || Saw_return ) &&
+                                    Ctx.Token != T_RBRACE )
+                            {
+                                if ( ! ( dost = DoStatement() ) )
+                                    break;
+                            }
+                        }
+                        else
+                        {
+                            if ( Ctx.Token != T_CASE && Ctx.Token != T_DEFAULT )
+                                skipstatement();
+                        }
+                    }
+                    else if ( Ctx.Token == T_DEFAULT )
+                    {
+                        if ( getoken() != T_COLON )
+                            error( COLONERR );
+                        getoken();
+                        while ( ! ( Saw_break || Saw_return ) && Ctx.Token != T_RBRACE )
+                            if ( ! ( dost = DoStatement() ) )
+                                break;
+                    }
+                    else
+                        skipstatement();
+                }
+                --Ctx.Switching;
+                Saw_break = 0;
+                if ( dost )
+                {
+                    Ctx.Progptr = body;
+                    getoken();
+                    skipstatement();
+                }
+                break;
+            }
+
+        case T_CASE:
+        case T_DEFAULT:
+            skipstatement();
+            break;
+
+        case T_RETURN:
+            /*
+             * parse a "return" statement
+             */
+            if ( getoken() == T_SEMICOLON )
+            {
+                /* return; */
+                TestZeroReturn();
+                pushint( 0, FALSE );
+            }
+            else
+            {
+                /* return val; */
+                if ( Ctx.Curfunc != NULL )
+                {
+                    if ( Ctx.Curfunc->fvar->type == VOID &&
+                         Ctx.Curfunc->fvar->cat == 0 )
+                        error( VOIDRETERR );
+                }
+                expression();
+
+            }
+            ++Saw_return;
+            stmtend();
+            break;
+
+        case T_BREAK:
+            /*
+             * parse a "break" statement
+             */
+            if ( Ctx.Looping || Ctx.Switching )
+            {
+                getoken();
+                ++Saw_break;
+            }
+            else
+                error( BREAKERR );
+            stmtend();
+            break;
+
+        case T_CONTINUE:
+            /*
+             * parse a "continue" statement
+             */
+            if ( Ctx.Looping )
+            {
+                getoken();
+                ++Saw_continue;
+            }
+            else
+                error( CONTERR );
+            stmtend();
+            break;
+
+        case T_SEMICOLON:
+            stmtend();
+            break;
+
+        default:
+            /*
+             * parse an expression statement
+             */
+            if ( ExpressionOne() )
+                pop();
+            if ( Ctx.Token == T_RPAREN || Ctx.Token == T_RBRACKET )
+                error( BADLBRACERR );
+            stmtend();
+    }
+} /* statement */
+
+
+void
+VCLCLASS InitializeLocalVariables (void)
+{
+    while ( Ctx.Token != T_SEMICOLON )
+    {
+        while ( Ctx.Token == T_STATIC ||
+                Ctx.Token == T_CONST ||
+                Ctx.Token == T_AUTO ||
+                Ctx.Token == T_REGISTER ||
+                Ctx.Token == T_VOLATILE )
+            getoken();
+        if ( Ctx.Token == T_STRUCT ||
+             Ctx.Token == T_UNION ||
+             Ctx.Token == T_ENUM )
+        {
+            getoken();                  /* get a struct/union/enum tag or a { */
+            if ( Ctx.Token == T_IDENTIFIER )
+                getoken();              /* get the one past the tag */
+            if ( Ctx.Token == T_LBRACE )
+                skip( T_LBRACE, T_RBRACE );
+        }
+        else
+            getoken();
+
+        if ( Ctx.Token == T_IDENTIFIER && ! Ctx.Curvar->vstatic )
+        {
+            getoken();
+            while ( Ctx.Token == T_LBRACKET )
+            {
+                do
+                    getoken();
+                while ( Ctx.Token != T_RBRACKET );
+                getoken();
+            }
+            if ( Ctx.Token == T_ASSIGN )
+            {
+                VARIABLE *      pvar = Ctx.Curvar;
+
+                Assert( pvar != NULL );
+                stmtbegin();
+                getoken();              /* get initializer expression */
+                Initializer( pvar, (char *) DataAddress( pvar ), 0 );
+            }
+        }
+    }
+} /* InitializeLocalVariables */
+
+
+/*
+ * Beginning of statement processing.
+ * Stop at every line and activate debugger.
+ */
+void
+VCLCLASS stmtbegin (void)
+{
+    ++Statements;                       /* see vclStats() */
+    if ( Prof != NULL && *Prof->ticks != Prof->seen )
+        ProfSample();                   /* the profiler's timer ticked */
+    if ( Cover != NULL )
+        CovCount();
+
+#if DEBUGGER
+    int             kbhit(void);
+
+    if ( StepCount == 0 )
+    {
+        int             debugger(void);
+
+        if ( debugger() )
+        {
+            pushint( 0 );
+            longjmp( Shelljmp, 2 );
+        }
+    }
+    kbhit();
+#endif
+} /* stmtbegin */
+
+
+/*
+ * Handle end of statement
+ */
+void
+VCLCLASS stmtend (void)
+{
+    if ( ! longjumping )
+    {
+        Ctx.svpptr = Ctx.Progptr;
+        if ( Ctx.Token == T_SEMICOLON )
+            getoken();
+        else
+            error( SEMIERR );
+    }
+} /* stmtend */
+
+
+/*
+ * Skip a statement
+ */
+void
+VCLCLASS skipstatement (void)
+{
+    switch ( Ctx.Token )
+    {
+        case T_LBRACE:
+            /*
+             * skip a compound statement
+             */
+            skip( T_LBRACE, T_RBRACE );
+            break;
+
+        case T_IF:
+            /*
+             * skip an "if-else" statement
+             */
+            getoken();                  /* skip 'if' */
+            skip( T_LPAREN, T_RPAREN );
+            skipstatement();
+            if ( Ctx.Token == T_ELSE )
+            {
+                getoken();              /* skip 'else' */
+                skipstatement();
+            }
+            break;
+
+        case T_DO:
+            /*
+             * skip a "do-while" statement
+             */
+            getoken();                  /* skip 'do' */
+            skipstatement();
+            getoken();                  /* skip 'while' */
+            skip( T_LPAREN, T_RPAREN );
+            stmtend();
+            break;
+
+        case T_WHILE:
+        case T_FOR:
+        case T_SWITCH:
+            /*
+             * skip a "while", "for" or "switch" statement
+             */
+            getoken();                  /* skip 'while' */
+            skip( T_LPAREN, T_RPAREN );
+            skipstatement();
+            break;
+
+        case T_CASE:
+        case T_DEFAULT:
+            while ( getoken() != T_COLON )
+                ;
+            getoken();
+            break;
+
+        default:
+            /*
+             * skip a one-liner
+             */
+            while ( Ctx.Token != T_SEMICOLON && Ctx.Token != T_RBRACE && Ctx.Token != T_EOF )
+                getoken();
+            if ( Ctx.Token == T_EOF )
+                error( RBRACERR );
+            if ( Ctx.Token == T_SEMICOLON )
+                getoken();
+    }
+} /* skipstatement */
+
+
+/*
+ * Run a for loop prefixed by "#pragma parallel for"
+ *
+ *   __parallel ( 'op' , variable , ... ) for ( ... ) body
+ *
+ * A loop like "for ( i = a ; i < b ; i++ )", see LoopShape(), with
+ * int, long or float local reduction variables runs on the host's
+ * threads; the loop variable and the reductions are set as if it had
+ * run serially.  Any other loop, or a loop without the host's loop
+ * hook, runs as an ordinary for.
+ */
+void
+VCLCLASS ParallelFor (void)
+{
+    VCLLOOP         loop;
+    VARIABLE *      pvar;
+    ITEM *          item;
+    uchar *         forptr;
+    uchar *         init;
+    uchar *         bound;
+    uchar *         iter;
+    char *          adr;
+    long            end;
+    long            count;
+    long            s;
+    int             cmp;
+    int             argc = 0;
+    int             ok;
+    int             rtn;
+
+    memset( &loop, 0, sizeof( loop ) );
+    ok = ( SpawnHooks != NULL && SpawnHooks->loop != NULL && Ctx.Curfunc != NULL );
+    if ( ok )
+    {
+        loop.fvar = Ctx.Curfunc->fvar;
+        loop.BlkNesting = Ctx.Curfunc->BlkNesting;
+        loop.ldata = Ctx.Curfunc->ldata;
+        loop.framelen = (int) ( Ctx.NextData - loop.ldata );
+        loop.arglength = Ctx.Curfunc->arglength;
+    }
+
+    /* the reductions, ( op, variable ) pairs */
+    if ( getoken() != T_LPAREN )
+        error( LPARENERR );
+    if ( getoken() != T_RPAREN )
+        argc = expression();
+    if ( Ctx.Token != T_RPAREN )
+        error( RPARENERR );
+    for ( ; argc >= 2; argc -= 2 )
+    {
+        item = Ctx.Stackptr;
+        adr = item->value.cptr;
+        if ( ! ok || ! item->lvalue || item->cat ||
+             ( item->type != INT && item->type != LONG && item->type != FLOAT ) ||
+             adr < loop.ldata || adr + item->size > loop.ldata + loop.framelen ||
+             loop.nreduce >= MAXREDUCE )
+        {
+            ok = FALSE;
+            popn( 2 );
+            continue;
+        }
+        loop.reduce[loop.nreduce].type = item->type;
+        loop.reduce[loop.nreduce].size = item->size;
+        loop.reduce[loop.nreduce].offset = (int) ( adr - loop.ldata );
+        pop();
+        loop.reduce[loop.nreduce++].op = (char) popint();
+    }
+    popn( argc );
+
+    forptr = Ctx.Progptr;
+    if ( ! ok || getoken() != T_FOR || ! LoopShape( &pvar, &cmp, &init, &bound, &iter ) )
+    {
+        /* an ordinary loop */
+        Ctx.Progptr = forptr;
+        getoken();
+        statement();
+        return;
+    }
+    loop.body = Ctx.Progptr;
+    loop.varoff = (int) ( (char *) DataAddress( pvar ) - loop.ldata );
+    loop.varsize = pvar->vsize;
+
+    /* the bounds & step, evaluated once */
+    Ctx.Progptr = init;
+    getoken();
+    popn( expression() - 1 );
+    loop.start = poplng();
+    Ctx.Progptr = bound;
+    getoken();
+    popn( expression() - 1 );
+    end = poplng();
+    loop.step = ( cmp == T_LT || cmp == T_LE ) ? 1 : -1;
+    if ( iter != NULL )
+    {
+        Ctx.Progptr = iter;
+        getoken();
+        popn( expression() - 1 );
+        if ( ( s = poplng()) <= 0 )
+            error( PARFORERR );
+        loop.step *= s;
+    }
+
+    /* the number of iterations */
+    s = loop.step > 0 ? loop.step : -loop.step;
+    switch ( cmp )
+    {
+        case T_LT:
+            count = loop.start < end ? ( end - loop.start + s - 1 ) / s : 0;
+            break;
+        case T_LE:
+            count = loop.start <= end ? ( end - loop.start ) / s + 1 : 0;
+            break;
+        case T_GT:
+            count = loop.start > end ? ( loop.start - end + s - 1 ) / s : 0;
+            break;
+        default:
+            count = loop.start >= end ? ( loop.start - end ) / s + 1 : 0;
+            break;
+    }
+
+    /*
+     * run it, or if the host can't, run the iterations here on the
+     * function's own locals
+     */
+    loop.image = (char *) getmem( loop.framelen + 1 );
+    memcpy( loop.image, loop.ldata, loop.framelen );
+#ifdef VCL_PTHREADS
+    pthread_mutex_init( &loop.lock, NULL );
+#endif
+    rtn = count ? (*SpawnHooks->loop)( SpawnArg, &loop, count ) : 0;
+#ifdef VCL_PTHREADS
+    pthread_mutex_destroy( &loop.lock );
+#endif
+    free( loop.image );
+    if ( rtn < 0 )
+        LoopBody( &loop, 0, count, loop.ldata );
+    else if ( rtn > 0 )
+        error( rtn );
+
+    /* the loop variable as the loop leaves it */
+    if ( loop.varsize == sizeof( long ) )
+        *(long *) ( loop.ldata + loop.varoff ) = loop.start + count * loop.step;
+    else
+        *(int *) ( loop.ldata + loop.varoff ) = (int) ( loop.start + count * loop.step );
+
+    Ctx.Progptr = loop.body;
+    getoken();
+    skipstatement();
+} /* ParallelFor */
+
+
+/*
+ * Test for a for loop ParallelFor() can run, Token is T_FOR
+ *
+ *   for ( v = <init> ; v <cmp> <bound> ; <iter> )
+ *
+ * v is an int or long local, <cmp> <, <=, > or >=, and <iter> v++,
+ * ++v, v += <step> for < and <=, or v--, --v, v -= <step> for > and
+ * >=.  <init>, <bound> and <step> may not have a comma operator.
+ *
+ * Returns TRUE with the variable, comparison and the positions of the
+ * expressions (iter NULL for ++ or --), and Progptr at the body, or
+ * FALSE with Ctx unchanged.
+ */
+int
+VCLCLASS LoopShape (VARIABLE **pvar, int *cmp, uchar **init, uchar **bound, uchar **iter)
+{
+    CTX             svCtx = Ctx;
+    VARIABLE *      var;
+    int             up;
+    int             i;
+
+    *iter = NULL;
+    if ( getoken() != T_LPAREN || getoken() != T_IDENTIFIER || ( var = Ctx.Curvar ) == NULL ||
+         ! var->islocal || var->vstatic || var->vcat || var->vkind || var->vdims[0] ||
+         ( var->vtype != INT && var->vtype != LONG ) ||
+         ( var->vsize != sizeof( int ) && var->vsize != sizeof( long ) ) ||
+         getoken() != T_ASSIGN )
+    {
+        Ctx = svCtx;
+        return FALSE;
+    }
+    *pvar = var;
+
+    /* <init> ; v <cmp> <bound> ; */
+    for ( i = 0; i < 2; ++i )
+    {
+        if ( i == 0 )
+            *init = Ctx.Progptr;
+        else
+        {
+            if ( getoken() != T_IDENTIFIER || Ctx.Curvar != var ||
+                 ( getoken() != T_LT && Ctx.Token != T_LE &&
+                   Ctx.Token != T_GT && Ctx.Token != T_GE ) )
+            {
+                Ctx = svCtx;
+                return FALSE;
+            }
+            *cmp = Ctx.Token;
+            *bound = Ctx.Progptr;
+        }
+        getoken();
+        while ( Ctx.Token != T_SEMICOLON && Ctx.Token != T_COMMA && Ctx.Token != T_EOF )
+        {
+            if ( Ctx.Token == T_LPAREN )
+                skip( T_LPAREN, T_RPAREN );
+            else
+                getoken();
+        }
+        if ( Ctx.Token != T_SEMICOLON )
+        {
+            Ctx = svCtx;
+            return FALSE;
+        }
+    }
+    up = ( *cmp == T_LT || *cmp == T_LE );
+
+    /* <iter> ) */
+    if ( getoken() == T_INCR || Ctx.Token == T_DECR )
+    {
+        if ( ( Ctx.Token == T_INCR ) != up || getoken() != T_IDENTIFIER || Ctx.Curvar != var )
+        {
+            Ctx = svCtx;
+            return FALSE;
+        }
+        getoken();
+    }
+    else if ( Ctx.Token == T_IDENTIFIER && Ctx.Curvar == var )
+    {
+        getoken();
+        if ( (uchar) Ctx.Token == ( up ? ( T_ADD | OPASSIGN ) : ( T_SUB | OPASSIGN ) ) )
+        {
+            *iter = Ctx.Progptr;
+            getoken();
+            while ( Ctx.Token != T_RPAREN && Ctx.Token != T_COMMA && Ctx.Token != T_EOF )
+            {
+                if ( Ctx.Token == T_LPAREN )
+                    skip( T_LPAREN, T_RPAREN );
+                else
+                    getoken();
+            }
+        }
+        else if ( Ctx.Token == ( up ? T_INCR : T_DECR ) )
+            getoken();
+    }
+    if ( Ctx.Token != T_RPAREN )
+    {
+        Ctx = svCtx;
+        return FALSE;
+    }
+    return TRUE;
+} /* LoopShape */
+
+
+/*
+ * Run iterations from through to - 1 of a parallel for, with ldata
+ * the locals
+ *
+ * A break, return or goto out of the body is an error.
+ */
+void
+VCLCLASS LoopBody (VCLLOOP *loop, long from, long to, char *ldata)
+{
+    char *          var = ldata + loop->varoff;
+
+    ++Ctx.Looping;
+    for ( ; from < to; ++from )
+    {
+        if ( loop->varsize == sizeof( long ) )
+            *(long *) var = loop->start + from * loop->step;
+        else
+            *(int *) var = (int) ( loop->start + from * loop->step );
+
+        Ctx.Progptr = loop->body;
+        getoken();
+        if ( ! DoStatement() || Saw_return || Saw_break )
+            error( PARFORERR );
+        Saw_continue = 0;
+        BudgetTick();
+    }
+    --Ctx.Looping;
+} /* LoopBody */
+
+
+/* start a copy of the locals' reduction variables at 0, or the limit */
+void
+VCLCLASS ReduceInit (VCLLOOP *loop, char *ldata)
+{
+    char *          adr;
+    int             i;
+
+    for ( i = 0; i < loop->nreduce; i++ )
+    {
+        adr = ldata + loop->reduce[i].offset;
+        switch ( loop->reduce[i].type )
+        {
+            case INT:
+                *(int *) adr = loop->reduce[i].op == '+' ? 0 :
+                               loop->reduce[i].op == '<' ? INT_MAX : INT_MIN;
+                break;
+            case LONG:
+                *(long *) adr = loop->reduce[i].op == '+' ? 0 :
+                                loop->reduce[i].op == '<' ? LONG_MAX : LONG_MIN;
+                break;
+            default:
+                if ( loop->reduce[i].size == sizeof( float ) )
+                    *(float *) adr = loop->reduce[i].op == '+' ? 0 :
+                                     loop->reduce[i].op == '<' ? FLT_MAX : -FLT_MAX;
+                else
+                    *(double *) adr = loop->reduce[i].op == '+' ? 0 :
+                                      loop->reduce[i].op == '<' ? DBL_MAX : -DBL_MAX;
+                break;
+        }
+    }
+} /* ReduceInit */
+
+
+/* merge a copy of the locals' reduction variables into the function's */
+void
+VCLCLASS ReduceMerge (VCLLOOP *loop, char *ldata)
+{
+    char *          src;
+    char *          dst;
+    double          a;
+    double          b;
+    int             i;
+
+#ifdef VCL_PTHREADS
+    pthread_mutex_lock( &loop->lock );
+#endif
+    for ( i = 0; i < loop->nreduce; i++ )
+    {
+        src = ldata + loop->reduce[i].offset;
+        dst = loop->ldata + loop->reduce[i].offset;
+        switch ( loop->reduce[i].type )
+        {
+            case INT:
+                if ( loop->reduce[i].op == '+' )
+                    *(int *) dst += *(int *) src;
+                else if ( ( *(int *) src < *(int *) dst ) == ( loop->reduce[i].op == '<' ) )
+                    *(int *) dst = *(int *) src;
+                break;
+            case LONG:
+                if ( loop->reduce[i].op == '+' )
+                    *(long *) dst += *(long *) src;
+                else if ( ( *(long *) src < *(long *) dst ) == ( loop->reduce[i].op == '<' ) )
+                    *(long *) dst = *(long *) src;
+                break;
+            default:
+                if ( loop->reduce[i].size == sizeof( float ) )
+                {
+                    a = *(float *) src;
+                    b = *(float *) dst;
+                }
+                else
+                {
+                    a = *(double *) src;
+                    b = *(double *) dst;
+                }
+                if ( loop->reduce[i].op == '+' )
+                    a += b;
+                else if ( ( a < b ) != ( loop->reduce[i].op == '<' ) )
+                    a = b;
+                if ( loop->reduce[i].size == sizeof( float ) )
+                    *(float *) dst = (float) a;
+                else
+                    *(double *) dst = a;
+                break;
+        }
+    }
+#ifdef VCL_PTHREADS
+    pthread_mutex_unlock( &loop->lock );
+#endif
+} /* ReduceMerge */
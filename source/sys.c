@@ -1,796 +1,1488 @@
-/*
- * Licensed to the Apache Software Foundation (ASF) under one
- * or more contributor license agreements.  See the NOTICE file
- * distributed with this work for additional information
- * regarding copyright ownership.  The ASF licenses this file
- * to you under the Apache License, Version 2.0 (the
- * "License"); you may not use this file except in compliance
- * with the License.  You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-/*
-    Copyright (c) 1989-1993
-    by Todd R. Hill
-    All Rights Reserved
-*/
-
-/*unpubMan********************************************************************
- NAME
-    sys.c - System calls module
-
- DESCRIPTION
-    Handles calling bound library function arguments and calling functions.
-    Also tracks internally opened files.
-
- FUNCTIONS
-    CloseAllOpenFiles()
-    ClearHeap()
-    sys()
-
-    AddOpenFile()
-    RemoveOpenFile()
-    chkchannel()
-    cvtfmt()
-    pprintf()
-    pscanf()
-    psprintf()
-    psscanf()
-    pfprintf()
-    pfscanf()
-    pcprintf()
-    FixStacktmStructure()
-    unstkmem()
-
- FILES
-    vcldef.h
-
- SEE ALSO
-
- NOTES
-    !?! This module will be rewritten to provide .DLL dynamic library support.
-
- BUGS
-
-********************************************************************unpubMan*/
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <io.h>
-#include <conio.h>                      // For cprintf(), getch etc...
-#include <dos.h>
-#include <math.h>
-#include <setjmp.h>
-#include <stdarg.h>
-#include <dir.h>
-#include <time.h>
-#ifdef __cplusplus
-}
-#endif
-
-#ifdef WRAPVCL
-#include "vcl.hpp"
-#else
-#include "vcldef.h"
-#endif
-
-FILE *
-VCLCLASS AddOpenFile (FILE *fp)
-{
-    if ( fp )
-    {
-        if ( OpenFileCount == MAXOPENFILES )
-        {
-            fclose( fp );
-            return NULL;
-        }
-        OpenFiles[OpenFileCount++] = fp;
-    }
-    return fp;
-} /* AddOpenFile */
-
-
-void
-VCLCLASS RemoveOpenFile (FILE *fp)
-{
-    int             found;
-    int             i;
-
-    if ( fp )
-    {
-        /* find open file pointer */
-        for ( i = 0, found = FALSE; i < OpenFileCount; i++ )
-        {
-            if ( OpenFiles[i] == fp )
-            {
-                found = TRUE;
-                break;
-            }
-        }
-        /* shuffle remaining pointers down in array */
-        if ( found )
-            for ( --OpenFileCount; i < OpenFileCount; i++ )
-                OpenFiles[i] = OpenFiles[i + 1];
-    }
-} /* RemoveOpenFile */
-
-
-void
-VCLCLASS CloseAllOpenFiles (void)
-{
-    int             i;
-
-    for ( i = 0; i < OpenFileCount; i++ )
-        fclose( OpenFiles[i] );
-    OpenFileCount = 0;
-} /* CloseAllOpenFiles */
-
-
-FILE *
-VCLCLASS chkchannel (FILE *channel)
-{
-    long            lchan = (long) channel;
-
-#if DEBUGGER
-    /*
-     * Converts vcl std handles to real ones Opens screen display in IDE for
-     * stdout, stderr
-     */
-    WasFileFunction = 1;
-    if ( lchan < 5 )
-    {
-        switch ( lchan )
-        {
-            case 0:
-                /* stdin */
-                WasConsole = DupStdin == -1;
-                break;
-            case 1:
-                /* stdout */
-                WasConsole = DupStdout == -1;
-                break;
-            case 2:
-                /* stderr */
-                WasConsole = 1;
-                break;
-            default:
-                WasConsole = 0;
-                break;
-        }
-        if ( WasConsole )
-            OpenStdout();
-        return handles[(int) lchan];
-    }
-#else
-    if ( lchan < 5L )
-        return handles[(int) lchan];
-#endif
-    return channel;
-} /* chkchannel */
-
-
-/* convert scanf strings so that all %f or %Lf formats become %lf */
-char *
-VCLCLASS cvtfmt (char *f2)
-{
-    char *          f1;
-    char            ch;
-
-    f1 = ConvertedFormat;
-    while ( *f2 )
-    {
-        Assert( f1 < ConvertedFormat + 200 );
-        if ( ( *f1++ = *f2++ ) == '%' )
-        {
-            /*
-             * found a format specifier, bypass suppression char, width,
-             * and pointer size modifier
-             */
-            while ( *f2 == '*' || isdigit( *f2 ) || *f2 == 'L' )
-                *f1++ = *f2++;
-            ch = tolower( *f2 );
-            if ( ( *f2 == 'f' || ch == 'e' || ch == 'g' ) && *( f2 - 1 ) != 'l' )
-            {
-                if ( *( f2 - 1 ) == 'L' )       /* convert %Lf to %lf */
-                    *( f1 - 1 ) = 'l';
-                else
-                    *f1++ = 'l';        /* convert %f to %lf */
-            }
-        }
-    }
-    *f1 = '\0';
-    return ConvertedFormat;
-} /* cvtfmt */
-
-
-/*
- * need these functions to get variable arguments
- * on the stack, which is the only place that vprintf, etc,
- * will process them when DS != SS
- */
-int
-VCLCLASS pprintf (char *fmt, struct vstack vs)
-{
-    return vprintf( fmt, &vs );
-} /* pprintf */
-
-
-int
-VCLCLASS pscanf (char *fmt, struct vstack vs)
-{
-    return vscanf( cvtfmt( fmt ), &vs );
-} /* pscanf */
-
-
-int
-VCLCLASS psprintf (char *str, char *fmt, struct vstack vs)
-{
-    return vsprintf( str, fmt, &vs );
-} /* psprintf */
-
-
-int
-VCLCLASS psscanf (char *str, char *fmt, struct vstack vs)
-{
-    return vsscanf( str, cvtfmt( fmt ), &vs );
-} /* psscanf */
-
-
-int
-VCLCLASS pfprintf (FILE *fp, char *fmt, struct vstack vs)
-{
-    FILE *          fp1 = chkchannel( fp );
-
-    return vfprintf( fp1, fmt, &vs );
-} /* pfprintf */
-
-
-int
-VCLCLASS pfscanf (FILE *fp, char *fmt, struct vstack vs)
-{
-    FILE *          fp1 = chkchannel( fp );
-
-    return vfscanf( fp1, cvtfmt( fmt ), &vs );
-} /* pfscanf */
-
-
-int
-VCLCLASS pcprintf (char *fmt, struct vstack vs)
-{
-    char *          buf = (char *) getmem( 512 );
-    int             rtn;
-
-    vsprintf( buf, fmt, &vs );
-    rtn = cprintf( buf );
-    free( buf );
-    return rtn;
-} /* pcprintf */
-
-
-void
-VCLCLASS FixStacktmStructure (void)
-{
-    int             symbolid = FindSymbol( "tm" );
-
-    if ( symbolid )
-    {
-        VARIABLE *      tvar = SearchVariable( symbolid, 1 );
-
-        if ( tvar != NULL )
-            Ctx.Stackptr->vstruct = tvar->vstruct;
-    }
-} /* FixStacktmStructure */
-
-
-/*
- * keep track of memory allocations
- */
-
-/* remove all allocated blocks */
-void
-VCLCLASS ClearHeap (void)
-{
-    int             i;
-
-    for ( i = 0; i < memctr; i++ )
-    {
-        if ( allocs[i] )
-        {
-            free( allocs[i] );
-            allocs[i] = NULL;
-        }
-    }        
-    memctr = 0;
-} /* ClearHeap */
-
-
-/* remove an allocated block from the list */
-void
-VCLCLASS unstkmem (char *adr)
-{
-    int             i;
-
-    free( adr );
-    for ( i = 0; i < memctr; i++ )
-        if ( adr == allocs[i] )
-            break;
-    if ( i < memctr )
-    {
-        --memctr;
-        while ( i < memctr )
-        {
-            allocs[i] = allocs[i + 1];
-            i++;
-        }
-    }
-} /* unstkmem */
-
-
-/*
- * Call an internal binary bound library function
- */
-void
-VCLCLASS sys (void)
-{
-    FILE *          fp;
-    char *          cp,
-    *               cp1;
-    int             n;
-    int             l;
-    enum sysfuncs   c;
-    double          f1;
-    double          f2;
-    int             ch;
-
-#ifdef DEBUGGER
-    int             x;
-    int             y;
-#endif
-
-    /* first argument on stack is the sys function number */
-    c = (enum sysfuncs) popint();
-
-    /* note: as in C, arguments are pushed right-to-left */
-    WasFileFunction = WasConsole = 0;
-    switch ( c )
-    {
-            /*
-             * System functions
-             */
-        case SYSEXIT:
-            longjmp( Shelljmp, 5 );
-        case SYSSYSTEM:
-#ifdef DEBUGGER
-            OpenStdout();
-#endif
-            pushint( system( (char *) popptr() ), FALSE );
-#ifdef DEBUGGER
-            if ( Stepping )
-                PromptIDE();
-            CloseStdout();
-#endif
-            return;
-        case SYSFINDFIRST:
-            n = popint();
-            cp1 = (char *) popptr();
-            cp = (char *) popptr();
-            pushint( findfirst( cp, (struct ffblk *) cp1, n ), FALSE );
-            return;
-        case SYSFINDNEXT:
-            pushint( findnext( (struct ffblk *) popptr() ), FALSE );
-            return;
-            /*
-             * String conversion functions
-             */
-        case SYSATOF:
-            pushflt( atof( (const char *) popptr() ), FALSE );
-            return;
-        case SYSATOI:
-            pushint( atoi( (const char *) popptr() ), FALSE );
-            return;
-        case SYSATOL:
-            pushlng( atol( (const char *) popptr() ), FALSE );
-            return;
-            /*
-             * String functions
-             */
-        case SYSSTRCMP:
-            cp1 = (char *) popptr();
-            cp = (char *) popptr();
-            pushint( strcmp( cp, cp1 ), FALSE );
-            return;
-        case SYSSTRNCMP:
-            n = popint();
-            cp1 = (char *) popptr();
-            cp = (char *) popptr();
-            pushint( strncmp( cp, cp1, n ), FALSE );
-            return;
-        case SYSSTRCPY:
-            cp1 = (char *) popptr();
-            cp = (char *) popptr();
-            pushptr( strcpy( cp, cp1 ), CHAR, FALSE );
-            return;
-        case SYSSTRNCPY:
-            n = popint();
-            cp1 = (char *) popptr();
-            cp = (char *) popptr();
-            pushptr( strncpy( cp, cp1, n ), CHAR, FALSE );
-            return;
-        case SYSSTRLEN:
-            pushint( strlen( (const char *) popptr() ), TRUE );
-            return;
-        case SYSSTRCAT:
-            cp1 = (char *) popptr();
-            cp = (char *) popptr();
-            pushptr( strcat( cp, cp1 ), CHAR, FALSE );
-            return;
-        case SYSSTRNCAT:
-            n = popint();
-            cp1 = (char *) popptr();
-            cp = (char *) popptr();
-            pushptr( strncat( cp, cp1, n ), CHAR, FALSE );
-            return;
-            /*
-             * memory allocation functions
-             */
-        case SYSMALLOC:
-            {
-                int             siz = popint();
-                char *          mem = (char *) malloc( siz );
-
-                if ( mem != NULL && memctr < MAXALLOC )
-                    allocs[memctr++] = mem;
-                else
-                {
-                    free( mem );
-                    mem = NULL;
-                }
-                pushptr( mem, VOID, FALSE );
-                return;
-            }
-        case SYSFREE:
-            unstkmem( (char *) popptr() );
-            pushint( 0, FALSE );
-            return;
-            /*
-             * Format conversion functions
-             */
-        case SYSSSCANF:
-            pushint( psscanf( *(char **) Ctx.Curfunc->ldata,
-                              *(char **) ( Ctx.Curfunc->ldata + sizeof( char * ) ),
-                              *( struct vstack * ) ( Ctx.Curfunc->ldata + ( sizeof(char * ) * 2) ) ),
-                              FALSE );
-            return;
-        case SYSSPRINTF:
-            pushint( psprintf( *(char **) Ctx.Curfunc->ldata,
-                               *(char **) ( Ctx.Curfunc->ldata + sizeof( char * ) ),
-                               *( struct vstack * ) ( Ctx.Curfunc->ldata + ( sizeof(char * ) * 2) ) ),
-                               FALSE );
-            return;
-
-        case SYSABS:
-            pushint( abs( popint() ), FALSE );
-            return;
-            /*
-             * File I/O functions
-             */
-        case SYSFSEEK:
-            {
-                int             md = popint();
-                long            j = poplng();
-
-                fp = chkchannel( (FILE *) popptr() );
-                pushint( fseek( fp, j, md ), FALSE );
-                return;
-            }
-        case SYSFOPEN:
-            {
-                char *          md = (char *) popptr();
-                char *          fn = (char *) popptr();
-
-                if ( ( fp = fopen( fn, md ) ) != NULL )
-                    fp = AddOpenFile( fp );
-                pushptr( fp, INT, FALSE );
-                return;
-            }
-        case SYSTMPFILE:
-            if ( ( fp = tmpfile() ) != NULL )
-                fp = AddOpenFile( fp );
-            pushptr( fp, INT, FALSE );
-            return;
-        case SYSTMPNAM:
-            pushptr( tmpnam( (char *) popptr() ), CHAR, FALSE );
-            return;
-        case SYSREMOVE:
-            pushint( remove( (char *) popptr() ), FALSE );
-            return;
-        case SYSFCLOSE:
-            fp = (FILE *) popptr();
-            RemoveOpenFile( fp );
-            pushint( fclose( fp ), FALSE );
-            return;
-        case SYSFFLUSH:
-            fp = chkchannel( (FILE *) popptr() );
-            pushint( fflush( fp ), FALSE );
-            break;
-        case SYSFGETC:
-            fp = chkchannel( (FILE *) popptr() );
-            pushint( getc( fp ), FALSE );
-            break;
-        case SYSUNGETC:
-            fp = chkchannel( (FILE *) popptr() );
-            pushint( ungetc( popint(), fp ), FALSE );
-            break;
-        case SYSFPUTC:
-            fp = chkchannel( (FILE *) popptr() );
-            pushint( putc( popint(), fp ), FALSE );
-            break;
-        case SYSFGETS:
-            fp = chkchannel( (FILE *) popptr() );
-            n = popint();
-            pushptr( fgets( (char *) popptr(), n, fp ), CHAR, FALSE );
-            break;
-        case SYSFPUTS:
-            fp = chkchannel( (FILE *) popptr() );
-            pushint( fputs( (char *) popptr(), fp ), FALSE );
-            break;
-        case SYSFREAD:
-            fp = chkchannel( (FILE *) popptr() );
-            n = popint();
-            l = popint();
-            cp = (char *) popptr();
-            pushint( fread( cp, l, n, fp ), FALSE );
-            break;
-        case SYSFWRITE:
-            fp = chkchannel( (FILE *) popptr() );
-            n = popint();
-            l = popint();
-            cp = (char *) popptr();
-            pushint( fwrite( cp, l, n, fp ), FALSE );
-            break;
-        case SYSFTELL:
-            fp = chkchannel( (FILE *) popptr() );
-            pushlng( ftell( fp ), FALSE );
-            break;
-        case SYSRENAME:
-            cp1 = (char *) popptr();
-            cp = (char *) popptr();
-            pushint( rename( cp, cp1 ), FALSE );
-            return;
-        case SYSREWIND:
-            fp = chkchannel( (FILE *) popptr() );
-            rewind( fp );
-            pushint( 0, FALSE );
-            break;
-        case SYSFSCANF:
-            pushint( pfscanf( *(FILE **) Ctx.Curfunc->ldata,
-                              *(char **) ( Ctx.Curfunc->ldata + sizeof( char * ) ),
-                              *( struct vstack * ) ( Ctx.Curfunc->ldata + sizeof( FILE * ) + sizeof( char * ) ) ),
-                              FALSE );
-            break;
-        case SYSFPRINTF:
-            pushint( pfprintf( *(FILE **) Ctx.Curfunc->ldata,
-                               *(char **) ( Ctx.Curfunc->ldata + sizeof( char * ) ),
-                               *( struct vstack * ) ( Ctx.Curfunc->ldata + sizeof( FILE * ) + sizeof( char * ) ) ),
-                               FALSE );
-            break;
-        case SYSASCTIME:
-            pushptr( asctime( (const struct tm *) popptr() ), CHAR, FALSE );
-            return;
-        case SYSGMTIME:
-            pushptr( gmtime( (const long *) popptr() ), STRUCT, FALSE );
-            Ctx.Stackptr->size = sizeof( struct tm );
-            FixStacktmStructure();
-            return;
-        case SYSLOCALTIME:
-            pushptr( localtime( (const long *) popptr() ), STRUCT, FALSE );
-            Ctx.Stackptr->size = sizeof( struct tm );
-            FixStacktmStructure();
-            return;
-        case SYSMKTIME:
-            pushlng( mktime( (struct tm *) popptr() ), FALSE );
-            return;
-        case SYSTIME:
-            pushlng( time( (long *) popptr() ), FALSE );
-            return;
-        default:
-            if ( c >= SYSACOS )
-            {
-                /*
-                 * math function
-                 */
-                f2 = popflt();
-                if ( c == SYSPOW )
-                {
-                    f1 = popflt();
-                    pushflt( pow( f1, f2 ), FALSE );
-                }
-                else if ( c == SYSATAN2 )
-                {
-                    f1 = popflt();
-                    pushflt( atan2( f1, f2 ), FALSE );
-                }
-                else if ( c < SYSPOW )
-                    pushflt( ( *mfunc[c - SYSACOS] ) ( f2 ), FALSE );
-                else
-                    pushint( 0, FALSE );
-                return;
-            }
-            break;
-    }
-
-    if ( WasFileFunction )
-    {
-#if DEBUGGER
-        if ( WasConsole )
-            CloseStdout();
-#endif
-        return;
-    }
-
-    /* these functions will or might use the screen */
-    switch ( c )
-    {
-            /*
-             * Console input functions
-             */
-        case SYSGETCH:
-#ifdef DEBUGGER
-            OpenStdout();
-            if ( ( ch = getch() ) == 3 )
-                CBreak();
-#else
-            ch = getch();
-#endif
-            if ( ch == 0 )
-                ch = getch() | 0x80;    /* set the high bit */
-            pushint( ch, TRUE );
-#if DEBUGGER
-            CloseStdout();
-#endif
-            return;
-        case SYSPUTCH:
-#if DEBUGGER
-            OpenStdout();
-#endif
-            putch( popint() );
-            pushint( 0, FALSE );
-#if DEBUGGER
-            CloseStdout();
-#endif
-            return;
-        case SYSCLRSCRN:
-#if DEBUGGER
-            OpenStdout();
-            clearscreen();
-            pushint( 0 );
-            CloseStdout();
-#else
-            pushint( 0, FALSE );
-
-#endif
-            return;
-        case SYSCURSOR:
-#if DEBUGGER
-            OpenStdout();
-#endif
-#ifdef DEBUGGER
-            y = popint();
-            x = popint();
-            cursor( x, y );
-#else
-            popint();                   /* Get the x, and y off to keep the */
-            popint();                   /* ..stack straight */
-#endif
-            pushint( 0, FALSE );
-#if DEBUGGER
-            CloseStdout();
-#endif
-            return;
-        case SYSGETCHAR:
-#if DEBUGGER
-            if ( DupStdin == -1 )
-                OpenStdout();
-#endif
-            pushint( getchar(), FALSE );
-#if DEBUGGER
-            if ( DupStdin == -1 )
-                CloseStdout();
-#endif
-            return;
-        case SYSGETS:
-#if DEBUGGER
-            if ( DupStdin == -1 )
-                OpenStdout();
-#endif
-            pushptr( gets( (char *) popptr() ), CHAR, FALSE );
-#if DEBUGGER
-            if ( DupStdin == -1 )
-                CloseStdout();
-#endif
-            return;
-        case SYSSCANF:
-#if DEBUGGER
-            if ( DupStdin == -1 )
-                OpenStdout();
-#endif
-            pushint( pscanf( *(char **) Ctx.Curfunc->ldata,
-                             *( struct vstack * ) ( Ctx.Curfunc->ldata + sizeof( char * ) ) ),
-                             FALSE );
-#if DEBUGGER
-            if ( DupStdin == -1 )
-            {
-                fflush( stdin );
-                CloseStdout();
-            }
-#endif
-            return;
-        default:
-            break;
-    }
-
-    switch ( c )
-    {
-            /*
-             * Console output functions
-             */
-        case SYSPUTCHAR:
-#if DEBUGGER
-            if ( DupStdout == -1 )
-                OpenStdout();
-#endif
-            pushint( putchar( popint() ), FALSE );
-#if DEBUGGER
-            if ( DupStdout == -1 )
-                CloseStdout();
-#endif
-            break;
-        case SYSPUTS:
-#if DEBUGGER
-            if ( DupStdout == -1 )
-                OpenStdout();
-#endif
-            pushint( puts( (char *) popptr() ), FALSE );
-#if DEBUGGER
-            if ( DupStdout == -1 )
-                CloseStdout();
-#endif
-            break;
-        case SYSPRINTF:
-#if DEBUGGER
-            if ( DupStdout == -1 )
-                OpenStdout();
-#endif
-            pushint( pprintf( *(char **) Ctx.Curfunc->ldata,
-                              *( struct vstack * ) ( Ctx.Curfunc->ldata + sizeof( char * ) ) ),
-                              FALSE );
-#if DEBUGGER
-            if ( DupStdout == -1 )
-                CloseStdout();
-#endif
-            break;
-        case SYSCPRINTF:
-#if DEBUGGER
-            OpenStdout();
-#endif
-            pushint( pcprintf( *(char **) Ctx.Curfunc->ldata,
-                               *( struct vstack * ) ( Ctx.Curfunc->ldata + sizeof( char * ) ) ),
-                               FALSE );
-#if DEBUGGER
-            CloseStdout();
-#endif
-            break;
-        default:
-            break;
-    }
-} /* sys */
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+    Copyright (c) 1989-1993
+    by Todd R. Hill
+    All Rights Reserved
+*/
+
+/*unpubMan********************************************************************
+ NAME
+    sys.c - System calls module
+
+ DESCRIPTION
+    Handles calling bound library function arguments and calling functions.
+    Also tracks internally opened files.
+
+    The console functions (getchar(), printf(), etc.) and the VCL std
+    handles use the instance's handles[], set by vclStdio().
+
+    With a host I/O wait hook (see vclIoWait()) the character, line and
+    block I/O functions and sleep() and delay() call the hook instead of
+    blocking on a pipe, socket or timer.
+
+    The message channel functions, chan_open() etc., call the host's
+    channel hooks (see vclChannels()).  A heap block sent on a channel
+    moves from the sender's allocation list to the receiver's.
+
+    spawn() and join() call the host's spawn hooks (see vclSpawn()).  A
+    spawned function runs in an instance of its own which shares this
+    one's globals (see vclShareGlobals()); the blocks it allocates are
+    not freed when it ends.  parallel_map() calls the spawn map hook,
+    or, without one, MapSerial().
+
+    The atomic functions, atomic_load() etc., work on the int or long
+    their first argument points to, mutex_lock() and mutex_unlock() on an
+    int which starts at 0.  shm_alloc(name, size) gets a zeroed segment
+    which every instance of the process sharing the name gets too, so
+    tasks of a multi-threaded host can share counters and locks.  The
+    segments live as long as the process; free() leaves them alone.
+
+ FUNCTIONS
+    CloseAllOpenFiles()
+    ClearHeap()
+    sys()
+
+    AddOpenFile()
+    RemoveOpenFile()
+    chkchannel()
+    IoFd()
+    IoGetc()
+    IoGets()
+    IoRead()
+    IoPut()
+    IoSleep()
+    cvtfmt()
+    pprintf()
+    pscanf()
+    psprintf()
+    psscanf()
+    pfprintf()
+    pfscanf()
+    pcprintf()
+    FixStacktmStructure()
+    unstkmem()
+    stkmem()
+    unlinkmem()
+    PopValue()
+    PutValue()
+    MapSerial()
+    PtrToLong()
+    MutexLock()
+    MutexUnlock()
+    ShmAlloc()
+    ShmOwns()
+
+ FILES
+    vcldef.h
+
+ SEE ALSO
+
+ NOTES
+    !?! This module will be rewritten to provide .DLL dynamic library support.
+
+ BUGS
+
+********************************************************************unpubMan*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <io.h>
+#include <conio.h>                      // For cprintf(), getch etc...
+#include <dos.h>
+#include <math.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <dir.h>
+#include <time.h>
+#ifdef __GLIBC__
+#include <unistd.h>                     // For usleep()
+#include <sys/stat.h>                   // For IoFd()
+#include <malloc.h>                     // For malloc_usable_size()
+#endif
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>                // For MutexLock()
+#include <linux/futex.h>
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef WRAPVCL
+#include "vcl.hpp"
+#else
+#include "vcldef.h"
+#endif
+
+/* bytes buffered for reading, room left & bytes pending for writing */
+#ifdef __GLIBC__
+#define IoBuffered(fp)  ( (fp)->_IO_read_end - (fp)->_IO_read_ptr )
+#define IoRoom(fp)      ( (fp)->_IO_buf_end - (fp)->_IO_write_ptr )
+#define IoPending(fp)   ( (fp)->_IO_write_ptr - (fp)->_IO_write_base )
+#else
+#define IoBuffered(fp)  0
+#define IoRoom(fp)      0
+#define IoPending(fp)   0
+#endif
+
+/* the atomic functions, plain memory operations without threads */
+#ifdef __GNUC__
+#define AtomicLoad(p)       __atomic_load_n( (p), __ATOMIC_SEQ_CST )
+#define AtomicStore(p,v)    __atomic_store_n( (p), (v), __ATOMIC_SEQ_CST )
+#define AtomicAdd(p,v)      __atomic_fetch_add( (p), (v), __ATOMIC_SEQ_CST )
+#define AtomicCas(p,o,v)    __atomic_compare_exchange_n( (p), (o), (v), FALSE, \
+                                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST )
+#else
+#define AtomicLoad(p)       ( *(p) )
+#define AtomicStore(p,v)    ( *(p) = (v) )
+#define AtomicAdd(p,v)      ( ( *(p) += (v) ) - (v) )
+#define AtomicCas(p,o,v)    ( *(p) == *(o) ? ( *(p) = (v), TRUE ) : ( *(o) = *(p), FALSE ) )
+#endif
+
+/* wait while a mutex word holds v, wake one waiter */
+#ifdef __linux__
+#define FutexWait(p,v)      syscall( SYS_futex, (p), FUTEX_WAIT_PRIVATE, (v), NULL, NULL, 0 )
+#define FutexWake(p)        syscall( SYS_futex, (p), FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 )
+#else
+#define FutexWait(p,v)      IoSleep( 1 )
+#define FutexWake(p)
+#endif
+
+/* a shm_alloc() segment, its data follows; they are never freed */
+typedef struct shmseg
+{
+    struct shmseg * next;
+    int             size;               /* bytes of data */
+    char *          name;
+    double          data[1];            /* aligned for any type */
+} SHMSEG;
+
+/* the segments, common to all instances of the process */
+static SHMSEG *     ShmSegs = NULL;
+#ifdef VCL_PTHREADS
+static pthread_mutex_t ShmLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* guards the heap lists instances share, see vclHeap() */
+#ifdef VCL_PTHREADS
+static pthread_mutex_t HeapLock = PTHREAD_MUTEX_INITIALIZER;
+#define LockHeap()      ( Heap->shared ? pthread_mutex_lock( &HeapLock ) : 0 )
+#define UnlockHeap()    ( Heap->shared ? pthread_mutex_unlock( &HeapLock ) : 0 )
+#else
+#define LockHeap()
+#define UnlockHeap()
+#endif
+
+FILE *
+VCLCLASS AddOpenFile (FILE *fp)
+{
+    if ( fp )
+    {
+        if ( OpenFileCount == MAXOPENFILES )
+        {
+            fclose( fp );
+            return NULL;
+        }
+        OpenFiles[OpenFileCount++] = fp;
+        ++FilesOpened;
+    }
+    return fp;
+} /* AddOpenFile */
+
+
+void
+VCLCLASS RemoveOpenFile (FILE *fp)
+{
+    int             found;
+    int             i;
+
+    if ( fp )
+    {
+        /* find open file pointer */
+        for ( i = 0, found = FALSE; i < OpenFileCount; i++ )
+        {
+            if ( OpenFiles[i] == fp )
+            {
+                found = TRUE;
+                break;
+            }
+        }
+        /* shuffle remaining pointers down in array */
+        if ( found )
+            for ( --OpenFileCount; i < OpenFileCount; i++ )
+                OpenFiles[i] = OpenFiles[i + 1];
+    }
+} /* RemoveOpenFile */
+
+
+void
+VCLCLASS CloseAllOpenFiles (void)
+{
+    int             i;
+
+    for ( i = 0; i < OpenFileCount; i++ )
+        fclose( OpenFiles[i] );
+    OpenFileCount = 0;
+} /* CloseAllOpenFiles */
+
+
+FILE *
+VCLCLASS chkchannel (FILE *channel)
+{
+    long            lchan = (long) channel;
+
+#if DEBUGGER
+    /*
+     * Converts vcl std handles to real ones Opens screen display in IDE for
+     * stdout, stderr
+     */
+    WasFileFunction = 1;
+    if ( lchan < 5 )
+    {
+        switch ( lchan )
+        {
+            case 0:
+                /* stdin */
+                WasConsole = DupStdin == -1;
+                break;
+            case 1:
+                /* stdout */
+                WasConsole = DupStdout == -1;
+                break;
+            case 2:
+                /* stderr */
+                WasConsole = 1;
+                break;
+            default:
+                WasConsole = 0;
+                break;
+        }
+        if ( WasConsole )
+            OpenStdout();
+        return handles[(int) lchan];
+    }
+#else
+    if ( lchan < 5L )
+        return handles[(int) lchan];
+#endif
+    return channel;
+} /* chkchannel */
+
+
+/*
+ * Get the descriptor to wait on for a stream
+ *
+ * Returns -1 if there is no I/O wait hook, or the stream is not
+ * a pipe or socket, which are all the host can wait for.
+ */
+int
+VCLCLASS IoFd (FILE *fp)
+{
+#ifdef __GLIBC__
+    struct stat     sb;
+    int             fd;
+
+    if ( IoWaitHook == NULL || ( fd = fileno( fp )) < 0 || fstat( fd, &sb ) )
+        return -1;
+    if ( S_ISFIFO( sb.st_mode ) || S_ISSOCK( sb.st_mode ) )
+        return fd;
+#endif
+    return -1;
+} /* IoFd */
+
+
+/*
+ * getc(), waiting for input through the hook
+ */
+int
+VCLCLASS IoGetc (FILE *fp)
+{
+    int             fd;
+
+    if ( IoWaitHook != NULL && IoBuffered( fp ) <= 0 && ( fd = IoFd( fp )) >= 0 )
+        (*IoWaitHook)( IoWaitArg, fd, VCL_IOREAD, -1L );
+    return getc( fp );
+} /* IoGetc */
+
+
+/*
+ * fgets(), waiting for input through the hook
+ *
+ * Reads a character at a time, as a line may arrive in pieces.
+ */
+char *
+VCLCLASS IoGets (char *buf, int n, FILE *fp)
+{
+    char *          cp;
+    int             ch;
+
+    if ( IoWaitHook == NULL || n <= 0 )
+        return fgets( buf, n, fp );
+
+    for ( cp = buf; n > 1; --n )
+    {
+        if ( ( ch = IoGetc( fp )) == EOF )
+        {
+            if ( cp == buf || ferror( fp ) )
+                return NULL;
+            break;
+        }
+        *cp++ = (char) ch;
+        if ( ch == '\n' )
+            break;
+    }
+    *cp = '\0';
+    return buf;
+} /* IoGets */
+
+
+/*
+ * fread(), waiting for input through the hook
+ *
+ * Takes what is buffered, and waits before each refill.
+ */
+int
+VCLCLASS IoRead (char *buf, int size, int count, FILE *fp)
+{
+    long            total = (long) size * count;
+    long            got = 0;
+    long            n;
+    int             fd;
+    int             ch;
+
+    if ( size <= 0 || ( fd = IoFd( fp )) < 0 )
+        return fread( buf, size, count, fp );
+
+    while ( got < total )
+    {
+        if ( ( n = IoBuffered( fp )) <= 0 )
+        {
+            (*IoWaitHook)( IoWaitArg, fd, VCL_IOREAD, -1L );
+            if ( ( ch = getc( fp )) == EOF )
+                break;
+            buf[got++] = (char) ch;     /* the refill */
+            continue;
+        }
+        if ( n > total - got )
+            n = total - got;
+        got += fread( buf + got, 1, (size_t) n, fp );
+    }
+    return (int) ( got / size );
+} /* IoRead */
+
+
+/*
+ * Wait through the hook until a stream can be written, if
+ * writing len bytes, or flushing it for len 0, will write
+ * to its descriptor
+ */
+void
+VCLCLASS IoPut (FILE *fp, int len)
+{
+    int             fd;
+
+    if ( IoWaitHook == NULL )
+        return;
+    if ( len ? IoRoom( fp ) <= len : IoPending( fp ) > 0 )
+        if ( ( fd = IoFd( fp )) >= 0 )
+            (*IoWaitHook)( IoWaitArg, fd, VCL_IOWRITE, -1L );
+} /* IoPut */
+
+
+/*
+ * Sleep msecs milliseconds, through the hook if there is one
+ */
+void
+VCLCLASS IoSleep (long msecs)
+{
+    if ( IoWaitHook != NULL )
+        (*IoWaitHook)( IoWaitArg, -1, 0, msecs );
+    else
+#ifdef __GLIBC__
+        usleep( (useconds_t) msecs * 1000 );
+#else
+        delay( (unsigned) msecs );
+#endif
+} /* IoSleep */
+
+
+/* convert scanf strings so that all %f or %Lf formats become %lf */
+char *
+VCLCLASS cvtfmt (char *f2)
+{
+    char *          f1;
+    char            ch;
+
+    f1 = ConvertedFormat;
+    while ( *f2 )
+    {
+        Assert( f1 < ConvertedFormat + 200 );
+        if ( ( *f1++ = *f2++ ) == '%' )
+        {
+            /*
+             * found a format specifier, bypass suppression char, width,
+             * and pointer size modifier
+             */
+            while ( *f2 == '*' || isdigit( *f2 ) || *f2 == 'L' )
+                *f1++ = *f2++;
+            ch = tolower( *f2 );
+            if ( ( *f2 == 'f' || ch == 'e' || ch == 'g' ) && *( f2 - 1 ) != 'l' )
+            {
+                if ( *( f2 - 1 ) == 'L' )       /* convert %Lf to %lf */
+                    *( f1 - 1 ) = 'l';
+                else
+                    *f1++ = 'l';        /* convert %f to %lf */
+            }
+        }
+    }
+    *f1 = '\0';
+    return ConvertedFormat;
+} /* cvtfmt */
+
+
+/*
+ * need these functions to get variable arguments
+ * on the stack, which is the only place that vprintf, etc,
+ * will process them when DS != SS
+ */
+int
+VCLCLASS pprintf (char *fmt, struct vstack vs)
+{
+    return vfprintf( handles[1], fmt, &vs );
+} /* pprintf */
+
+
+int
+VCLCLASS pscanf (char *fmt, struct vstack vs)
+{
+    return vfscanf( handles[0], cvtfmt( fmt ), &vs );
+} /* pscanf */
+
+
+int
+VCLCLASS psprintf (char *str, char *fmt, struct vstack vs)
+{
+    return vsprintf( str, fmt, &vs );
+} /* psprintf */
+
+
+int
+VCLCLASS psscanf (char *str, char *fmt, struct vstack vs)
+{
+    return vsscanf( str, cvtfmt( fmt ), &vs );
+} /* psscanf */
+
+
+int
+VCLCLASS pfprintf (FILE *fp, char *fmt, struct vstack vs)
+{
+    FILE *          fp1 = chkchannel( fp );
+
+    return vfprintf( fp1, fmt, &vs );
+} /* pfprintf */
+
+
+int
+VCLCLASS pfscanf (FILE *fp, char *fmt, struct vstack vs)
+{
+    FILE *          fp1 = chkchannel( fp );
+
+    return vfscanf( fp1, cvtfmt( fmt ), &vs );
+} /* pfscanf */
+
+
+int
+VCLCLASS pcprintf (char *fmt, struct vstack vs)
+{
+    char *          buf = (char *) getmem( 512 );
+    int             rtn;
+
+    vsprintf( buf, fmt, &vs );
+    rtn = cprintf( buf );
+    free( buf );
+    return rtn;
+} /* pcprintf */
+
+
+void
+VCLCLASS FixStacktmStructure (void)
+{
+    int             symbolid = FindSymbol( "tm" );
+
+    if ( symbolid )
+    {
+        VARIABLE *      tvar = SearchVariable( symbolid, 1 );
+
+        if ( tvar != NULL )
+            Ctx.Stackptr->vstruct = tvar->vstruct;
+    }
+} /* FixStacktmStructure */
+
+
+/*
+ * keep track of memory allocations
+ */
+
+/* free all allocated blocks, a shared heap's are freed by its owner */
+void
+VCLCLASS ClearHeap (void)
+{
+    int             i;
+
+    if ( Heap != &OwnHeap )
+        return;
+
+    LockHeap();
+    for ( i = 0; i < Heap->count; i++ )
+        free( Heap->allocs[i] );
+    Heap->count = 0;
+    Heap->used = 0;
+    UnlockHeap();
+} /* ClearHeap */
+
+
+/* free an allocated block, unless it is not on the list */
+void
+VCLCLASS unstkmem (char *adr)
+{
+    if ( unlinkmem( adr ) )
+        free( adr );
+} /* unstkmem */
+
+
+/* add a block to the list, FALSE if it is full */
+int
+VCLCLASS stkmem (char *adr)
+{
+    LockHeap();
+    if ( Heap->count >= MAXALLOC )
+    {
+        UnlockHeap();
+        return FALSE;
+    }
+    Heap->allocs[Heap->count++] = adr;
+#ifdef __GLIBC__
+    Heap->used += (long) malloc_usable_size( adr );
+    if ( Heap->used > HeapPeak )
+        HeapPeak = Heap->used;
+#endif
+    UnlockHeap();
+    return TRUE;
+} /* stkmem */
+
+
+/* take a block off the list without freeing it, FALSE if not there */
+int
+VCLCLASS unlinkmem (char *adr)
+{
+    int             i;
+
+    LockHeap();
+    for ( i = 0; i < Heap->count; i++ )
+        if ( adr == Heap->allocs[i] )
+            break;
+    if ( i == Heap->count )
+    {
+        UnlockHeap();
+        return FALSE;
+    }
+
+    --Heap->count;
+#ifdef __GLIBC__
+    Heap->used -= (long) malloc_usable_size( adr );
+#endif
+    while ( i < Heap->count )
+    {
+        Heap->allocs[i] = Heap->allocs[i + 1];
+        i++;
+    }
+    UnlockHeap();
+    return TRUE;
+} /* unlinkmem */
+
+
+/*
+ * Pop a value off the stack, typed after the stack item
+ *
+ * With blocks TRUE a block of this program's heap comes back as
+ * VCL_BLOCK, for a message; it stays on the heap list until sent.
+ */
+void
+VCLCLASS PopValue (VCLVALUE *msg, int blocks)
+{
+    int             i;
+
+    if ( Ctx.Stackptr->cat )
+    {
+        msg->type = VCL_PTR;
+        msg->v.p = popptr();
+        LockHeap();
+        for ( i = 0; blocks && i < Heap->count; i++ )
+            if ( msg->v.p == Heap->allocs[i] )
+                msg->type = VCL_BLOCK;
+        UnlockHeap();
+    }
+    else switch ( Ctx.Stackptr->type )
+    {
+        case LONG:
+            msg->type = VCL_LONG;
+            msg->v.l = poplng();
+            break;
+        case FLOAT:
+            msg->type = VCL_DOUBLE;
+            msg->v.d = popflt();
+            break;
+        default:
+            msg->type = VCL_INT;
+            msg->v.i = popint();
+            break;
+    }
+} /* PopValue */
+
+
+/*
+ * Deliver a value, a received message or a return value
+ *
+ * Stores it at dest, which must point to its type, or pushes
+ * it if dest is NULL.  A block joins this program's heap.
+ */
+void
+VCLCLASS PutValue (VCLVALUE *msg, void *dest)
+{
+    switch ( msg->type )
+    {
+        case VCL_BLOCK:
+            stkmem( (char *) msg->v.p );
+            /* fall through */
+        case VCL_PTR:
+            if ( dest )
+                *(void **) dest = msg->v.p;
+            else
+                pushptr( msg->v.p, VOID, FALSE );
+            break;
+        case VCL_LONG:
+            if ( dest )
+                *(long *) dest = msg->v.l;
+            else
+                pushlng( msg->v.l, FALSE );
+            break;
+        case VCL_DOUBLE:
+            if ( dest )
+                *(double *) dest = msg->v.d;
+            else
+                pushflt( msg->v.d, FALSE );
+            break;
+        case VCL_VOID:
+            if ( dest == NULL )
+                pushint( 0, FALSE );
+            break;
+        default:
+            if ( dest )
+                *(int *) dest = msg->v.i;
+            else
+                pushint( msg->v.i, FALSE );
+            break;
+    }
+} /* PutValue */
+
+
+/*
+ * Call fn(in + i * size, out + i * size) for each i below count,
+ * parallel_map() without a host to spread the calls
+ *
+ * The calls nest in the running library call, as a function call
+ * nests in an expression.
+ */
+void
+VCLCLASS MapSerial (VCLFUNC fn, char *in, char *out, int count, int size)
+{
+    unsigned char * svprogptr = Ctx.Progptr;
+    FUNCTION *      svCurfunction = Ctx.Curfunction;
+    int             svFileno = Ctx.CurrFileno;
+    int             svLineno = Ctx.CurrLineno;
+    char            svSystem = inSystem;
+    ITEM *          args;
+    int             i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        args = Ctx.Stackptr + 1;
+        pushptr( in + (long) i * size, CHAR, FALSE );
+        pushptr( out + (long) i * size, CHAR, FALSE );
+        Ctx.Curfunction = fn;
+        CallFunction( 2, args );
+        pop();                          /* the return value */
+    }
+
+    Ctx.Progptr = svprogptr;
+    Ctx.Curfunction = svCurfunction;
+    Ctx.CurrFileno = svFileno;
+    Ctx.CurrLineno = svLineno;
+    inSystem = svSystem;
+} /* MapSerial */
+
+
+/*
+ * TRUE if the item on the top of the stack points to a long,
+ * for the atomic functions; anything else is taken as an int
+ */
+int
+VCLCLASS PtrToLong (void)
+{
+    return Ctx.Stackptr->cat == 1 && Ctx.Stackptr->type == LONG;
+} /* PtrToLong */
+
+
+/*
+ * Lock a mutex_lock() mutex
+ *
+ * The mutex is an int, 0 unlocked, 1 locked or 2 locked with
+ * waiters.  With a yield hook (see vclBudget()) a waiting task
+ * yields rather than sleeps, so it does not keep the holder off
+ * a worker thread of the host.
+ */
+void
+VCLCLASS MutexLock (int *m)
+{
+    int             c;
+    int             waited = FALSE;
+
+    for ( ;; )
+    {
+        /* a thread which has waited may leave others waiting */
+        c = 0;
+        if ( AtomicCas( m, &c, waited ? 2 : 1 ) )
+            return;
+        if ( c == 1 && ! AtomicCas( m, &c, 2 ) && c == 0 )
+            continue;                   /* unlocked meanwhile */
+
+        if ( YieldHook != NULL )
+            (*YieldHook)( YieldArg );
+        else
+            FutexWait( m, 2 );
+        waited = TRUE;
+    }
+} /* MutexLock */
+
+
+/* unlock a mutex_lock() mutex, waking a waiter if there are any */
+void
+VCLCLASS MutexUnlock (int *m)
+{
+    if ( AtomicAdd( m, -1 ) != 1 )
+    {
+        AtomicStore( m, 0 );
+        FutexWake( m );
+    }
+} /* MutexUnlock */
+
+
+/*
+ * Get the named shared segment, allocating it zeroed at first use
+ *
+ * Every instance of the process gets the same segment for a name.
+ * Returns NULL if out of memory or if the segment is smaller than size.
+ */
+void *
+VCLCLASS ShmAlloc (char *name, int size)
+{
+    SHMSEG *        seg;
+
+#ifdef VCL_PTHREADS
+    pthread_mutex_lock( &ShmLock );
+#endif
+    for ( seg = ShmSegs; seg != NULL; seg = seg->next )
+        if ( strcmp( seg->name, name ) == 0 )
+            break;
+
+    if ( seg == NULL && size > 0 &&
+         ( seg = (SHMSEG *) calloc( 1, sizeof( SHMSEG ) + size + strlen( name ) + 1 )) != NULL )
+    {
+        seg->size = size;
+        seg->name = (char *) seg->data + size;
+        strcpy( seg->name, name );
+        seg->next = ShmSegs;
+        ShmSegs = seg;
+    }
+#ifdef VCL_PTHREADS
+    pthread_mutex_unlock( &ShmLock );
+#endif
+
+    return ( seg && seg->size >= size ) ? seg->data : NULL;
+} /* ShmAlloc */
+
+
+/* TRUE if adr is a shared segment, which free() leaves alone */
+int
+VCLCLASS ShmOwns (void *adr)
+{
+    SHMSEG *        seg;
+
+#ifdef VCL_PTHREADS
+    pthread_mutex_lock( &ShmLock );
+#endif
+    for ( seg = ShmSegs; seg != NULL; seg = seg->next )
+        if ( adr == (void *) seg->data )
+            break;
+#ifdef VCL_PTHREADS
+    pthread_mutex_unlock( &ShmLock );
+#endif
+    return seg != NULL;
+} /* ShmOwns */
+
+
+/*
+ * Call an internal binary bound library function
+ */
+void
+VCLCLASS sys (void)
+{
+    FILE *          fp;
+    char *          cp,
+    *               cp1;
+    int             n;
+    int             l;
+    enum sysfuncs   c;
+    double          f1;
+    double          f2;
+    int             ch;
+
+#ifdef DEBUGGER
+    int             x;
+    int             y;
+#endif
+
+    /* first argument on stack is the sys function number */
+    c = (enum sysfuncs) popint();
+
+    /* note: as in C, arguments are pushed right-to-left */
+    WasFileFunction = WasConsole = 0;
+    switch ( c )
+    {
+            /*
+             * System functions
+             */
+        case SYSEXIT:
+            longjmp( Shelljmp, 5 );
+        case SYSSYSTEM:
+#ifdef DEBUGGER
+            OpenStdout();
+#endif
+            pushint( system( (char *) popptr() ), FALSE );
+#ifdef DEBUGGER
+            if ( Stepping )
+                PromptIDE();
+            CloseStdout();
+#endif
+            return;
+        case SYSFINDFIRST:
+            n = popint();
+            cp1 = (char *) popptr();
+            cp = (char *) popptr();
+            pushint( findfirst( cp, (struct ffblk *) cp1, n ), FALSE );
+            return;
+        case SYSFINDNEXT:
+            pushint( findnext( (struct ffblk *) popptr() ), FALSE );
+            return;
+            /*
+             * String conversion functions
+             */
+        case SYSATOF:
+            pushflt( atof( (const char *) popptr() ), FALSE );
+            return;
+        case SYSATOI:
+            pushint( atoi( (const char *) popptr() ), FALSE );
+            return;
+        case SYSATOL:
+            pushlng( atol( (const char *) popptr() ), FALSE );
+            return;
+            /*
+             * String functions
+             */
+        case SYSSTRCMP:
+            cp1 = (char *) popptr();
+            cp = (char *) popptr();
+            pushint( strcmp( cp, cp1 ), FALSE );
+            return;
+        case SYSSTRNCMP:
+            n = popint();
+            cp1 = (char *) popptr();
+            cp = (char *) popptr();
+            pushint( strncmp( cp, cp1, n ), FALSE );
+            return;
+        case SYSSTRCPY:
+            cp1 = (char *) popptr();
+            cp = (char *) popptr();
+            pushptr( strcpy( cp, cp1 ), CHAR, FALSE );
+            return;
+        case SYSSTRNCPY:
+            n = popint();
+            cp1 = (char *) popptr();
+            cp = (char *) popptr();
+            pushptr( strncpy( cp, cp1, n ), CHAR, FALSE );
+            return;
+        case SYSSTRLEN:
+            pushint( strlen( (const char *) popptr() ), TRUE );
+            return;
+        case SYSSTRCAT:
+            cp1 = (char *) popptr();
+            cp = (char *) popptr();
+            pushptr( strcat( cp, cp1 ), CHAR, FALSE );
+            return;
+        case SYSSTRNCAT:
+            n = popint();
+            cp1 = (char *) popptr();
+            cp = (char *) popptr();
+            pushptr( strncat( cp, cp1, n ), CHAR, FALSE );
+            return;
+            /*
+             * memory allocation functions
+             */
+        case SYSMALLOC:
+            {
+                int             siz = popint();
+                char *          mem = (char *) malloc( siz );
+
+                if ( mem == NULL || ! stkmem( mem ) )
+                {
+                    free( mem );
+                    mem = NULL;
+                }
+                pushptr( mem, VOID, FALSE );
+                return;
+            }
+        case SYSFREE:
+            cp = (char *) popptr();
+            if ( ! ShmOwns( cp ) )
+                unstkmem( cp );
+            pushint( 0, FALSE );
+            return;
+            /*
+             * message channel functions
+             */
+        case SYSCHANOPEN:
+            n = popint();
+            cp = (char *) popptr();
+            pushint( ChanHooks ? (*ChanHooks->open)( ChanArg, cp, n ) : -1, FALSE );
+            return;
+        case SYSCHANSEND:
+            {
+                VCLVALUE        msg;
+                int             rtn = -1;
+
+                PopValue( &msg, TRUE );
+                n = popint();
+                if ( ChanHooks && ( rtn = (*ChanHooks->send)( ChanArg, n, &msg, TRUE )) > 0 &&
+                     msg.type == VCL_BLOCK )
+                    unlinkmem( (char *) msg.v.p );  /* the receiver's now */
+                pushint( rtn > 0 ? 0 : -1, FALSE );
+                return;
+            }
+        case SYSCHANRECV:
+            {
+                VCLVALUE        msg;
+
+                n = popint();
+                if ( ChanHooks && (*ChanHooks->recv)( ChanArg, n, &msg, TRUE ) > 0 )
+                    PutValue( &msg, NULL );
+                else
+                    pushint( 0, FALSE );
+                return;
+            }
+        case SYSCHANTRYRECV:
+            {
+                VCLVALUE        msg;
+                void *          dest = popptr();
+                int             rtn = -1;
+
+                n = popint();
+                if ( ChanHooks && ( rtn = (*ChanHooks->recv)( ChanArg, n, &msg, FALSE )) > 0 )
+                    PutValue( &msg, dest );
+                pushint( rtn, FALSE );
+                return;
+            }
+            /*
+             * parallel functions
+             */
+        case SYSSPAWN:
+            {
+                VCLVALUE        arg;
+                VCLFUNC         fn;
+
+                PopValue( &arg, FALSE );
+                cp = (char *) popptr();
+                if ( SpawnHooks && ( fn = vclFindFunction( cp )) != NULL )
+                    pushint( (*SpawnHooks->spawn)( SpawnArg, fn, &arg ), FALSE );
+                else
+                    pushint( -1, FALSE );
+                return;
+            }
+        case SYSJOIN:
+            {
+                VCLVALUE        ret;
+
+                n = popint();
+                if ( SpawnHooks && (*SpawnHooks->join)( SpawnArg, n, &ret ) == 0 )
+                    PutValue( &ret, NULL );
+                else
+                    pushint( -1, FALSE );
+                return;
+            }
+        case SYSPARALLELMAP:
+            {
+                char *          out = (char *) popptr();
+                VCLFUNC         fn = vclFindFunction( (char *) popptr() );
+                int             size = popint();
+                char *          in;
+                int             rtn = -1;
+
+                n = popint();
+                in = (char *) popptr();
+                if ( fn != NULL )
+                {
+                    if ( SpawnHooks != NULL && SpawnHooks->map != NULL )
+                        rtn = (*SpawnHooks->map)( SpawnArg, fn, in, out, n, size );
+                    if ( rtn == -1 )    /* no calls made, not even some */
+                    {
+                        MapSerial( fn, in, out, n, size );
+                        rtn = 0;
+                    }
+                }
+                pushint( rtn ? -1 : 0, FALSE );
+                return;
+            }
+        case SYSATOMICLOAD:
+            if ( PtrToLong() )
+                pushlng( AtomicLoad( (long *) popptr() ), FALSE );
+            else
+                pushint( AtomicLoad( (int *) popptr() ), FALSE );
+            return;
+        case SYSATOMICSTORE:
+            {
+                long            v = poplng();
+
+                if ( PtrToLong() )
+                    AtomicStore( (long *) popptr(), v );
+                else
+                    AtomicStore( (int *) popptr(), (int) v );
+                pushint( 0, FALSE );
+                return;
+            }
+        case SYSATOMICADD:
+            {
+                long            v = poplng();
+
+                /* the value before the add */
+                if ( PtrToLong() )
+                    pushlng( AtomicAdd( (long *) popptr(), v ), FALSE );
+                else
+                    pushint( AtomicAdd( (int *) popptr(), (int) v ), FALSE );
+                return;
+            }
+        case SYSATOMICCAS:
+            {
+                long            v = poplng();
+                long            o = poplng();
+
+                if ( PtrToLong() )
+                    n = AtomicCas( (long *) popptr(), &o, v );
+                else
+                {
+                    int         io = (int) o;
+
+                    n = AtomicCas( (int *) popptr(), &io, (int) v );
+                }
+                pushint( n ? TRUE : FALSE, FALSE );
+                return;
+            }
+        case SYSMUTEXLOCK:
+            MutexLock( (int *) popptr() );
+            pushint( 0, FALSE );
+            return;
+        case SYSMUTEXUNLOCK:
+            MutexUnlock( (int *) popptr() );
+            pushint( 0, FALSE );
+            return;
+        case SYSSHMALLOC:
+            n = popint();
+            pushptr( ShmAlloc( (char *) popptr(), n ), VOID, FALSE );
+            return;
+            /*
+             * Format conversion functions
+             */
+        case SYSSSCANF:
+            pushint( psscanf( *(char **) Ctx.Curfunc->ldata,
+                              *(char **) ( Ctx.Curfunc->ldata + sizeof( char * ) ),
+                              *( struct vstack * ) ( Ctx.Curfunc->ldata + ( sizeof(char * ) * 2) ) ),
+                              FALSE );
+            return;
+        case SYSSPRINTF:
+            pushint( psprintf( *(char **) Ctx.Curfunc->ldata,
+                               *(char **) ( Ctx.Curfunc->ldata + sizeof( char * ) ),
+                               *( struct vstack * ) ( Ctx.Curfunc->ldata + ( sizeof(char * ) * 2) ) ),
+                               FALSE );
+            return;
+
+        case SYSABS:
+            pushint( abs( popint() ), FALSE );
+            return;
+            /*
+             * File I/O functions
+             */
+        case SYSFSEEK:
+            {
+                int             md = popint();
+                long            j = poplng();
+
+                fp = chkchannel( (FILE *) popptr() );
+                pushint( fseek( fp, j, md ), FALSE );
+                return;
+            }
+        case SYSFOPEN:
+            {
+                char *          md = (char *) popptr();
+                char *          fn = (char *) popptr();
+
+                if ( ( fp = fopen( fn, md ) ) != NULL )
+                    fp = AddOpenFile( fp );
+                pushptr( fp, INT, FALSE );
+                return;
+            }
+        case SYSTMPFILE:
+            if ( ( fp = tmpfile() ) != NULL )
+                fp = AddOpenFile( fp );
+            pushptr( fp, INT, FALSE );
+            return;
+        case SYSTMPNAM:
+            pushptr( tmpnam( (char *) popptr() ), CHAR, FALSE );
+            return;
+        case SYSREMOVE:
+            pushint( remove( (char *) popptr() ), FALSE );
+            return;
+        case SYSFCLOSE:
+            fp = (FILE *) popptr();
+            RemoveOpenFile( fp );
+            pushint( fclose( fp ), FALSE );
+            return;
+        case SYSFFLUSH:
+            fp = chkchannel( (FILE *) popptr() );
+            IoPut( fp, 0 );
+            pushint( fflush( fp ), FALSE );
+            break;
+        case SYSFGETC:
+            fp = chkchannel( (FILE *) popptr() );
+            pushint( IoGetc( fp ), FALSE );
+            break;
+        case SYSUNGETC:
+            fp = chkchannel( (FILE *) popptr() );
+            pushint( ungetc( popint(), fp ), FALSE );
+            break;
+        case SYSFPUTC:
+            fp = chkchannel( (FILE *) popptr() );
+            IoPut( fp, 1 );
+            pushint( putc( popint(), fp ), FALSE );
+            break;
+        case SYSFGETS:
+            fp = chkchannel( (FILE *) popptr() );
+            n = popint();
+            pushptr( IoGets( (char *) popptr(), n, fp ), CHAR, FALSE );
+            break;
+        case SYSFPUTS:
+            fp = chkchannel( (FILE *) popptr() );
+            cp = (char *) popptr();
+            IoPut( fp, strlen( cp ) );
+            pushint( fputs( cp, fp ), FALSE );
+            break;
+        case SYSFREAD:
+            fp = chkchannel( (FILE *) popptr() );
+            n = popint();
+            l = popint();
+            cp = (char *) popptr();
+            pushint( IoRead( cp, l, n, fp ), FALSE );
+            break;
+        case SYSFWRITE:
+            fp = chkchannel( (FILE *) popptr() );
+            n = popint();
+            l = popint();
+            cp = (char *) popptr();
+            IoPut( fp, l * n );
+            pushint( fwrite( cp, l, n, fp ), FALSE );
+            break;
+        case SYSFTELL:
+            fp = chkchannel( (FILE *) popptr() );
+            pushlng( ftell( fp ), FALSE );
+            break;
+        case SYSRENAME:
+            cp1 = (char *) popptr();
+            cp = (char *) popptr();
+            pushint( rename( cp, cp1 ), FALSE );
+            return;
+        case SYSREWIND:
+            fp = chkchannel( (FILE *) popptr() );
+            rewind( fp );
+            pushint( 0, FALSE );
+            break;
+        case SYSFSCANF:
+            pushint( pfscanf( *(FILE **) Ctx.Curfunc->ldata,
+                              *(char **) ( Ctx.Curfunc->ldata + sizeof( char * ) ),
+                              *( struct vstack * ) ( Ctx.Curfunc->ldata + sizeof( FILE * ) + sizeof( char * ) ) ),
+                              FALSE );
+            break;
+        case SYSFPRINTF:
+            pushint( pfprintf( *(FILE **) Ctx.Curfunc->ldata,
+                               *(char **) ( Ctx.Curfunc->ldata + sizeof( char * ) ),
+                               *( struct vstack * ) ( Ctx.Curfunc->ldata + sizeof( FILE * ) + sizeof( char * ) ) ),
+                               FALSE );
+            break;
+        case SYSASCTIME:
+            pushptr( asctime( (const struct tm *) popptr() ), CHAR, FALSE );
+            return;
+        case SYSGMTIME:
+            pushptr( gmtime( (const long *) popptr() ), STRUCT, FALSE );
+            Ctx.Stackptr->size = sizeof( struct tm );
+            FixStacktmStructure();
+            return;
+        case SYSLOCALTIME:
+            pushptr( localtime( (const long *) popptr() ), STRUCT, FALSE );
+            Ctx.Stackptr->size = sizeof( struct tm );
+            FixStacktmStructure();
+            return;
+        case SYSMKTIME:
+            pushlng( mktime( (struct tm *) popptr() ), FALSE );
+            return;
+        case SYSTIME:
+            pushlng( time( (long *) popptr() ), FALSE );
+            return;
+        case SYSSLEEP:
+            IoSleep( popint() * 1000L );
+            pushint( 0, FALSE );
+            return;
+        case SYSDELAY:
+            IoSleep( (unsigned) popint() );
+            pushint( 0, FALSE );
+            return;
+        default:
+            if ( c >= SYSACOS )
+            {
+                /*
+                 * math function
+                 */
+                f2 = popflt();
+                if ( c == SYSPOW )
+                {
+                    f1 = popflt();
+                    pushflt( pow( f1, f2 ), FALSE );
+                }
+                else if ( c == SYSATAN2 )
+                {
+                    f1 = popflt();
+                    pushflt( atan2( f1, f2 ), FALSE );
+                }
+                else if ( c < SYSPOW )
+                    pushflt( ( *mfunc[c - SYSACOS] ) ( f2 ), FALSE );
+                else
+                    pushint( 0, FALSE );
+                return;
+            }
+            break;
+    }
+
+    if ( WasFileFunction )
+    {
+#if DEBUGGER
+        if ( WasConsole )
+            CloseStdout();
+#endif
+        return;
+    }
+
+    /* these functions will or might use the screen */
+    switch ( c )
+    {
+            /*
+             * Console input functions
+             */
+        case SYSGETCH:
+#ifdef DEBUGGER
+            OpenStdout();
+            if ( ( ch = getch() ) == 3 )
+                CBreak();
+#else
+            ch = getch();
+#endif
+            if ( ch == 0 )
+                ch = getch() | 0x80;    /* set the high bit */
+            pushint( ch, TRUE );
+#if DEBUGGER
+            CloseStdout();
+#endif
+            return;
+        case SYSPUTCH:
+#if DEBUGGER
+            OpenStdout();
+#endif
+            putch( popint() );
+            pushint( 0, FALSE );
+#if DEBUGGER
+            CloseStdout();
+#endif
+            return;
+        case SYSCLRSCRN:
+#if DEBUGGER
+            OpenStdout();
+            clearscreen();
+            pushint( 0 );
+            CloseStdout();
+#else
+            pushint( 0, FALSE );
+
+#endif
+            return;
+        case SYSCURSOR:
+#if DEBUGGER
+            OpenStdout();
+#endif
+#ifdef DEBUGGER
+            y = popint();
+            x = popint();
+            cursor( x, y );
+#else
+            popint();                   /* Get the x, and y off to keep the */
+            popint();                   /* ..stack straight */
+#endif
+            pushint( 0, FALSE );
+#if DEBUGGER
+            CloseStdout();
+#endif
+            return;
+        case SYSGETCHAR:
+#if DEBUGGER
+            if ( DupStdin == -1 )
+                OpenStdout();
+#endif
+            pushint( IoGetc( handles[0] ), FALSE );
+#if DEBUGGER
+            if ( DupStdin == -1 )
+                CloseStdout();
+#endif
+            return;
+        case SYSGETS:
+#if DEBUGGER
+            if ( DupStdin == -1 )
+                OpenStdout();
+#endif
+            {
+                char *      s = (char *) popptr();
+                char *      p = s;
+                int         ch;
+
+                /* gets() from the instance's stdin */
+                while ( ( ch = IoGetc( handles[0] )) != EOF && ch != '\n' )
+                    *p++ = (char) ch;
+                *p = '\0';
+                pushptr( ( ch == EOF && p == s ) ? NULL : s, CHAR, FALSE );
+            }
+#if DEBUGGER
+            if ( DupStdin == -1 )
+                CloseStdout();
+#endif
+            return;
+        case SYSSCANF:
+#if DEBUGGER
+            if ( DupStdin == -1 )
+                OpenStdout();
+#endif
+            pushint( pscanf( *(char **) Ctx.Curfunc->ldata,
+                             *( struct vstack * ) ( Ctx.Curfunc->ldata + sizeof( char * ) ) ),
+                             FALSE );
+#if DEBUGGER
+            if ( DupStdin == -1 )
+            {
+                fflush( handles[0] );
+                CloseStdout();
+            }
+#endif
+            return;
+        default:
+            break;
+    }
+
+    switch ( c )
+    {
+            /*
+             * Console output functions
+             */
+        case SYSPUTCHAR:
+#if DEBUGGER
+            if ( DupStdout == -1 )
+                OpenStdout();
+#endif
+            pushint( putc( popint(), handles[1] ), FALSE );
+#if DEBUGGER
+            if ( DupStdout == -1 )
+                CloseStdout();
+#endif
+            break;
+        case SYSPUTS:
+#if DEBUGGER
+            if ( DupStdout == -1 )
+                OpenStdout();
+#endif
+            {
+                int         rtn = fputs( (char *) popptr(), handles[1] );
+
+                pushint( rtn < 0 ? rtn : putc( '\n', handles[1] ), FALSE );
+            }
+#if DEBUGGER
+            if ( DupStdout == -1 )
+                CloseStdout();
+#endif
+            break;
+        case SYSPRINTF:
+#if DEBUGGER
+            if ( DupStdout == -1 )
+                OpenStdout();
+#endif
+            pushint( pprintf( *(char **) Ctx.Curfunc->ldata,
+                              *( struct vstack * ) ( Ctx.Curfunc->ldata + sizeof( char * ) ) ),
+                              FALSE );
+#if DEBUGGER
+            if ( DupStdout == -1 )
+                CloseStdout();
+#endif
+            break;
+        case SYSCPRINTF:
+#if DEBUGGER
+            OpenStdout();
+#endif
+            pushint( pcprintf( *(char **) Ctx.Curfunc->ldata,
+                               *( struct vstack * ) ( Ctx.Curfunc->ldata + sizeof( char * ) ) ),
+                               FALSE );
+#if DEBUGGER
+            CloseStdout();
+#endif
+            break;
+        default:
+            break;
+    }
+} /* sys */
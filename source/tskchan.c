@@ -0,0 +1,409 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*unpubModule*****************************************************************
+ NAME
+    tskchan.c - VAST message channels for POSIX threads tasks
+
+ DESCRIPTION
+    The message channels behind the VCL chan_open(), chan_send(),
+    chan_recv() and chan_try_recv() library functions for the tasks of
+    vci-pt (see vclChannels()).
+
+    A channel is found by name, so tasks running different programs can
+    meet on it, and lives as long as the worker pool.  Each is a bounded
+    ring of typed messages which any number of tasks may send to and
+    receive from at once without a lock: a slot carries a sequence
+    number telling whether it is free for the sender or full for the
+    receiver at a given position, and the positions are claimed with
+    compare-and-swap.
+
+    A sender finding the ring full, or a receiver finding it empty, is
+    held up (backpressure): a task blocks in TskBlock(), freeing its
+    worker, and any other thread waits on the channel's condition.  The
+    lock is taken only to wait and to wake waiters, and a send or
+    receive looks for waiters with a single atomic load.
+
+    A malloc()'d block is sent by handing over the pointer, see sys.c,
+    so messages cost the same whatever their size.
+
+ FUNCTIONS
+    TskChanStart()
+    TskChanStop()
+
+    TskChanOpen()
+    TskChanSend()
+    TskChanRecv()
+    TskChanPut()
+    TskChanGet()
+    TskChanWait()
+    TskChanWake()
+
+ FILES
+    tskmgmt.h, vcl.h
+
+ SEE ALSO
+    tskpool.c, vclptin.cpp, sys.c
+
+ NOTES
+    Every waiter is woken when a channel it may be waiting for changes,
+    and tries again; those who lose the race wait again.
+
+    A block still in a channel when the pool stops is freed with it.
+    RunIni.boxSlots is the size of a channel opened with 0 slots.
+
+**********************************************************************unpubModule*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include <scdef.h>
+
+#include "tskmgmt.h"                    /* must be after pthread.h */
+#include "vcl.h"                        /* VCLCHANNELS, VCLVALUE */
+
+/* definitions */
+#define TSKCHANS            64          /* most channels */
+#define CHANNAMESZ          31          /* longest channel name */
+
+/* ring slot */
+typedef struct TSKSLOT
+{
+    unsigned long   seq;                /* position it is free or full for */
+    VCLVALUE        msg;
+} TskSlot_t;
+
+/* message channel */
+typedef struct TSKCHAN
+{
+    char            name[CHANNAMESZ + 1];
+    TskSlot_t *     ring;               /* allocated array of slots */
+    unsigned long   mask;               /* slots - 1, slots a power of 2 */
+    unsigned long   head;               /* next position to receive */
+    unsigned long   tail;               /* next position to send */
+    int             waiters;            /* tasks & threads waiting */
+    pthread_mutex_t lock;               /* guards the lists of waiters */
+    pthread_cond_t  cond;               /* threads wait here */
+    int *           tasks;              /* allocated array, waiting tasks */
+    int             ntasks;
+} TskChan_t;
+
+/* externals */
+extern VCLCHANNELS * VclPtChans;        /* in vclptin.cpp */
+
+/* locals */
+static pthread_mutex_t  ChanLock = PTHREAD_MUTEX_INITIALIZER;
+static TskChan_t *      Chans[TSKCHANS];    /* channel n is Chans[n - 1] */
+static int              ChanCount = 0;
+
+/* prototypes */
+static int          TskChanOpen (void *, char *, int);
+static int          TskChanSend (void *, int, VCLVALUE *, int);
+static int          TskChanRecv (void *, int, VCLVALUE *, int);
+static int          TskChanPut (TskChan_t *, VCLVALUE *);
+static int          TskChanGet (TskChan_t *, VCLVALUE *);
+static void         TskChanWait (TskChan_t *, int (*) (TskChan_t *, VCLVALUE *), VCLVALUE *);
+static void         TskChanWake (TskChan_t *);
+
+static VCLCHANNELS  TskChans = { TskChanOpen, TskChanSend, TskChanRecv };
+
+
+/*
+ * Make the channels available to the VCL programs
+ *-------------------------------------------------*/
+int
+TskChanStart (void)
+{
+    VclPtChans = &TskChans;
+    return TRUE;
+} /* TskChanStart */
+
+
+/*
+ * Free all channels
+ *
+ * Only once no task can use them, i.e. after the workers have stopped
+ *-----------------------------------------------------------------------*/
+void
+TskChanStop (void)
+{
+    TskChan_t *     ch;
+    VCLVALUE        msg;
+    int             i;
+
+    VclPtChans = NULL;
+
+    pthread_mutex_lock( &ChanLock );
+    for ( i = 0; i < ChanCount; ++i )
+    {
+        ch = Chans[i];
+        while ( TskChanGet( ch, &msg ) )
+            if ( msg.type == VCL_BLOCK )
+                free( msg.v.p );        /* nobody took it */
+        pthread_mutex_destroy( &ch->lock );
+        pthread_cond_destroy( &ch->cond );
+        free( ch->tasks );
+        free( ch->ring );
+        free( ch );
+        Chans[i] = NULL;
+    }
+    ChanCount = 0;
+    pthread_mutex_unlock( &ChanLock );
+} /* TskChanStop */
+
+
+/*
+ * Open a channel, creating it if there is none of that name
+ *
+ * Returns the channel number, or -1
+ *-----------------------------------------------------------*/
+static int
+TskChanOpen (void *arg, char *name, int slots)
+{
+    TskChan_t *     ch;
+    unsigned long   n;
+    int             i;
+
+    arg = arg;                          /* avoid 'not used' compiler warning */
+
+    if ( name == NULL || strlen( name ) > CHANNAMESZ )
+        return -1;
+
+    pthread_mutex_lock( &ChanLock );
+    for ( i = 0; i < ChanCount; ++i )
+        if ( ! strcmp( Chans[i]->name, name ) )
+        {
+            pthread_mutex_unlock( &ChanLock );
+            return i + 1;
+        }
+
+    /* room for at least slots messages, in a power of 2 */
+    if ( slots <= 0 )
+        slots = (int) RunIni.boxSlots;
+    for ( n = 2; n < (unsigned long) slots; n <<= 1 )
+        ;
+
+    if ( ChanCount == TSKCHANS ||
+         ( ch = (TskChan_t *) calloc( 1, sizeof( TskChan_t ) )) == NULL )
+    {
+        pthread_mutex_unlock( &ChanLock );
+        return -1;
+    }
+    ch->ring = (TskSlot_t *) calloc( n, sizeof( TskSlot_t ) );
+    ch->tasks = (int *) calloc( RunIni.maxTasks + 1, sizeof( int ) );
+    if ( ch->ring == NULL || ch->tasks == NULL )
+    {
+        free( ch->ring );
+        free( ch->tasks );
+        free( ch );
+        pthread_mutex_unlock( &ChanLock );
+        return -1;
+    }
+    strcpy( ch->name, name );
+    ch->mask = n - 1;
+    for ( n = 0; n <= ch->mask; ++n )
+        ch->ring[n].seq = n;            /* each slot free for its position */
+    pthread_mutex_init( &ch->lock, NULL );
+    pthread_cond_init( &ch->cond, NULL );
+
+    /* publish it, TskChanSend() & TskChanRecv() don't take ChanLock */
+    Chans[ChanCount] = ch;
+    __atomic_store_n( &ChanCount, ChanCount + 1, __ATOMIC_RELEASE );
+    i = ChanCount;
+
+    pthread_mutex_unlock( &ChanLock );
+    return i;
+} /* TskChanOpen */
+
+
+/*
+ * Send a message, waiting while the channel is full if wait is TRUE
+ *
+ * Returns 1 if sent, 0 if full, -1 for a bad channel
+ *---------------------------------------------------------------------*/
+static int
+TskChanSend (void *arg, int chan, VCLVALUE *msg, int wait)
+{
+    TskChan_t *     ch;
+
+    arg = arg;                          /* avoid 'not used' compiler warning */
+
+    if ( chan < 1 || chan > __atomic_load_n( &ChanCount, __ATOMIC_ACQUIRE ) )
+        return -1;
+    ch = Chans[chan - 1];
+
+    if ( ! TskChanPut( ch, msg ) )
+    {
+        if ( ! wait )
+            return 0;
+        TskChanWait( ch, TskChanPut, msg );
+    }
+    TskChanWake( ch );
+    return 1;
+} /* TskChanSend */
+
+
+/*
+ * Receive a message, waiting while the channel is empty if wait is TRUE
+ *
+ * Returns 1 if received, 0 if empty, -1 for a bad channel
+ *-------------------------------------------------------------------------*/
+static int
+TskChanRecv (void *arg, int chan, VCLVALUE *msg, int wait)
+{
+    TskChan_t *     ch;
+
+    arg = arg;                          /* avoid 'not used' compiler warning */
+
+    if ( chan < 1 || chan > __atomic_load_n( &ChanCount, __ATOMIC_ACQUIRE ) )
+        return -1;
+    ch = Chans[chan - 1];
+
+    if ( ! TskChanGet( ch, msg ) )
+    {
+        if ( ! wait )
+            return 0;
+        TskChanWait( ch, TskChanGet, msg );
+    }
+    TskChanWake( ch );
+    return 1;
+} /* TskChanRecv */
+
+
+/*
+ * Put a message in the ring, FALSE if it is full
+ *------------------------------------------------*/
+static int
+TskChanPut (TskChan_t *ch, VCLVALUE *msg)
+{
+    TskSlot_t *     slot;
+    unsigned long   pos = __atomic_load_n( &ch->tail, __ATOMIC_RELAXED );
+    long            diff;
+
+    for ( ;; )
+    {
+        slot = &ch->ring[pos & ch->mask];
+        diff = (long) ( __atomic_load_n( &slot->seq, __ATOMIC_ACQUIRE ) - pos );
+        if ( diff == 0 )
+        {
+            /* free for this position, claim it */
+            if ( __atomic_compare_exchange_n( &ch->tail, &pos, pos + 1, TRUE,
+                                              __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+                break;
+        }
+        else if ( diff < 0 )
+            return FALSE;               /* not yet received, full */
+        else
+            pos = __atomic_load_n( &ch->tail, __ATOMIC_RELAXED );
+    }
+    slot->msg = *msg;
+    __atomic_store_n( &slot->seq, pos + 1, __ATOMIC_RELEASE );
+    return TRUE;
+} /* TskChanPut */
+
+
+/*
+ * Take a message out of the ring, FALSE if it is empty
+ *------------------------------------------------------*/
+static int
+TskChanGet (TskChan_t *ch, VCLVALUE *msg)
+{
+    TskSlot_t *     slot;
+    unsigned long   pos = __atomic_load_n( &ch->head, __ATOMIC_RELAXED );
+    long            diff;
+
+    for ( ;; )
+    {
+        slot = &ch->ring[pos & ch->mask];
+        diff = (long) ( __atomic_load_n( &slot->seq, __ATOMIC_ACQUIRE ) - ( pos + 1 ) );
+        if ( diff == 0 )
+        {
+            /* full for this position, claim it */
+            if ( __atomic_compare_exchange_n( &ch->head, &pos, pos + 1, TRUE,
+                                              __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+                break;
+        }
+        else if ( diff < 0 )
+            return FALSE;               /* not yet sent, empty */
+        else
+            pos = __atomic_load_n( &ch->head, __ATOMIC_RELAXED );
+    }
+    *msg = slot->msg;
+    __atomic_store_n( &slot->seq, pos + ch->mask + 1, __ATOMIC_RELEASE );
+    return TRUE;
+} /* TskChanGet */
+
+
+/*
+ * Wait until op, TskChanPut() or TskChanGet(), succeeds
+ *
+ * The waiter is counted before it tries again, so a send or receive
+ * completing meanwhile either is seen by the try or sees the waiter.
+ *---------------------------------------------------------------------*/
+static void
+TskChanWait (TskChan_t *ch, int (* op) (TskChan_t *, VCLVALUE *), VCLVALUE *msg)
+{
+    int             hTsk = TskSelf();
+    int             i;
+
+    pthread_mutex_lock( &ch->lock );
+    __atomic_add_fetch( &ch->waiters, 1, __ATOMIC_SEQ_CST );
+    while ( ! (*op)( ch, msg ) )
+    {
+        if ( hTsk )
+        {
+            /* free the worker, TskChanWake() resumes the task */
+            for ( i = 0; i < ch->ntasks && ch->tasks[i] != hTsk; ++i )
+                ;
+            if ( i == ch->ntasks )
+                ch->tasks[ch->ntasks++] = hTsk;
+            pthread_mutex_unlock( &ch->lock );
+            TskBlock();
+            pthread_mutex_lock( &ch->lock );
+        }
+        else
+            pthread_cond_wait( &ch->cond, &ch->lock );
+    }
+    __atomic_sub_fetch( &ch->waiters, 1, __ATOMIC_SEQ_CST );
+    pthread_mutex_unlock( &ch->lock );
+} /* TskChanWait */
+
+
+/*
+ * Wake the waiters of a channel after a send or receive
+ *-------------------------------------------------------*/
+static void
+TskChanWake (TskChan_t *ch)
+{
+    int             i;
+
+    __atomic_thread_fence( __ATOMIC_SEQ_CST );
+    if ( __atomic_load_n( &ch->waiters, __ATOMIC_RELAXED ) == 0 )
+        return;                         /* the usual case */
+
+    pthread_mutex_lock( &ch->lock );
+    for ( i = 0; i < ch->ntasks; ++i )
+        TskResume( ch->tasks[i] );
+    ch->ntasks = 0;
+    pthread_cond_broadcast( &ch->cond );
+    pthread_mutex_unlock( &ch->lock );
+} /* TskChanWake */
@@ -1,105 +1,191 @@
-/*
- * Licensed to the Apache Software Foundation (ASF) under one
- * or more contributor license agreements.  See the NOTICE file
- * distributed with this work for additional information
- * regarding copyright ownership.  The ASF licenses this file
- * to you under the Apache License, Version 2.0 (the
- * "License"); you may not use this file except in compliance
- * with the License.  You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-/*pubMan**********************************************************************
- NAME
-    tskmgmt.h - VAST Task Management definitions
-
- DESCRIPTION
-    Contains definitions of symbols and structures used by VAST for real-
-    time task management.  Used only in multitasking implementations of
-    VAST.
-
- GLOBAL VARIABLES
-    TskMgmt_t *     TskList;            allocated array of structures
-    ulong           TskCount;           perpetual task-run count metrix
-
- NOTES
-
-**********************************************************************pubMan*/
-
-#ifndef TSKMGMT_H                       /* avoid multiple inclusion */
-#define TSKMGMT_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/* enums */
-enum TSKSTATES
-{
-    TSK_FREE = 0,                       /* slot is not in use */
-    TSK_RUNNING,                        /* running */
-    TSK_WAITING,                        /* waiting for something, running */
-    TSK_SUSPENDED,                      /* suspended, running */
-    TSK_DEADLOCKED,                     /* send-blocked by halted task, running */
-    TSK_HALTED,                         /* halted, pending kill */
-    TSK_UNKNOWN                         /* unknown state, internal exception */
-};
-
-enum RUNMODES
-{
-    RUN_NOW = 1,
-    RUN_ONDEMAND
-};
-
-/* typedefs */
-typedef struct TSKMGMT
-{
-    int             state;              /* our definition of task states */
-    TaskHandle      tskp;               /* pointer (handle) to engine task */
-    Mailbox         boxp;               /* pointer (handle) to IPC mailbox */
-    char *          cmdline;            /* pointer to allocated command line */
-    int             retval;             /* return value of task */
-} TskMgmt_t;
-
-/* global references */
-extern TskMgmt_t *  TskList;            /* allocated array of structures */
-extern ulong        TskCount;           /* perpetual task-run count metrix */
-
-/* macros */
-#define hTskValid(th)           (th && th <= RunIni.maxTasks)
-#define TskGetBox(th)           (TskList[th].boxp)
-#define TskGetCmd(th)           (TskList[th].cmdline)
-#define TskGetHandle(th)        (TskList[th].tskp)
-#define TskGetRetval(th)        (TskList[th].retval)
-#define TskPtrTo(th)            (&TskList[th])
-#define TskSetBox(th,p)         (TskList[th].boxp = p)
-#define TskSetCmd(th,p)         (TskList[th].cmdline = p)
-#define TskSetState(th,i)       (TskList[th].state = i)
-#define TskSetHandle(th,p)      (TskList[th].tskp = p)
-#define TskSetRetval(th,i)      (TskList[th].retval = i)
-#define TskRunning(th)          (TskList[th].state == TSK_RUNNING || \
-                                 TskList[th].state == TSK_WAITING || \
-                                 TskList[th].state == TSK_SUSPENDED || \
-                                 TskList[th].state == TSK_DEADLOCKED)
-
-/* prototypes */
-int             TskAlloc (void);
-int             TskExec (char *);
-int             TskGetState (int);
-int             TskKill (int);
-int             TskKillAll (void);
-void            TskYield (void);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* avoid mutiple inclusion */
-
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*pubMan**********************************************************************
+ NAME
+    tskmgmt.h - VAST Task Management definitions
+
+ DESCRIPTION
+    Contains definitions of symbols and structures used by VAST for real-
+    time task management.  Used only in multitasking implementations of
+    VAST.
+
+ GLOBAL VARIABLES
+    TskMgmt_t *     TskList;            allocated array of structures
+    ulong           TskCount;           perpetual task-run count metrix
+    RunIni_t        RunIni;             runtime .INI file parameters
+
+ NOTES
+    The RT-Kernel implementation (vci-mt.c) must include the RT-Kernel
+    headers before this header for TaskHandle and Mailbox.  The POSIX
+    threads implementation (vci-pt.c, tskpool.c) defines VCL_PTHREADS
+    and gets its own definitions of those handles below.
+
+    TSK_READY and TSK_BLOCKED are used only by the POSIX threads
+    implementation, whose tasks are coroutines which can be suspended.
+
+**********************************************************************pubMan*/
+
+#ifndef TSKMGMT_H                       /* avoid multiple inclusion */
+#define TSKMGMT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* enums */
+enum TSKSTATES
+{
+    TSK_FREE = 0,                       /* slot is not in use */
+    TSK_RUNNING,                        /* running */
+    TSK_WAITING,                        /* waiting for something, running */
+    TSK_SUSPENDED,                      /* suspended, running */
+    TSK_DEADLOCKED,                     /* send-blocked by halted task, running */
+    TSK_HALTED,                         /* halted, pending kill */
+    TSK_READY,                          /* yielded, queued to resume, running */
+    TSK_BLOCKED,                        /* suspended until TskResume(), running */
+    TSK_UNKNOWN                         /* unknown state, internal exception */
+};
+
+enum RUNMODES
+{
+    RUN_NOW = 1,
+    RUN_ONDEMAND
+};
+
+enum TSKOUTMODES                        /* task stdout, see tskout.c */
+{
+    TSKOUT_DIRECT,
+    TSKOUT_BUFFERED,
+    TSKOUT_ORDERED,
+    TSKOUT_TAGGED
+};
+
+/* typedefs */
+#ifdef VCL_PTHREADS
+typedef struct TSKCORO *    TaskHandle; /* task's coroutine, or NULL */
+typedef void *              Mailbox;    /* unused, channels are found */
+                                        /* by name, see tskchan.c */
+
+typedef struct TSKSTATS                 /* what a task cost, see TskStats() */
+{
+    ulong       run;                    /* TskCount when it was started */
+    long long   start;                  /* first ran, CLOCK_MONOTONIC us, or 0 */
+    long long   wall;                   /* us from start to halt, or so far */
+    long long   cpu;                    /* us of its workers' processor time */
+    long long   blocked;                /* us in TSK_BLOCKED */
+    ulong       statements;             /* VCL statements, see vclStats() */
+    long        data;                   /* peak data space, bytes */
+    long        stack;                  /* peak VCL stack, bytes */
+    long        heap;                   /* peak malloc() heap, bytes */
+    int         files;                  /* files opened */
+} TskStats_t;
+#endif
+
+typedef struct RUNINI                   /* runtime .INI file parameters */
+{
+    uint        boxSize;
+    uint        boxSlots;
+    uint        mainPriority;
+    int         maxTasks;
+    uint        priority;
+    uint        stack;
+    int         yield;
+    int         workers;                /* POSIX threads worker pool size */
+    int         warm;                   /* prepared instances per program */
+    int         reload;                 /* seconds between source checks */
+    long        budget;                 /* VCL ticks between yields */
+    int         output;                 /* TSKOUT_DIRECT, etc. */
+    int         outBuf;                 /* task stdout buffer size */
+    char *      statsFile;              /* task metrics dump, NULL for none */
+    int         statsEvery;             /* seconds between dumps of those running */
+} RunIni_t;
+
+typedef struct TSKMGMT
+{
+    int             state;              /* our definition of task states */
+    TaskHandle      tskp;               /* pointer (handle) to engine task */
+    Mailbox         boxp;               /* pointer (handle) to IPC mailbox */
+    char *          cmdline;            /* pointer to allocated command line */
+    int             retval;             /* return value of task */
+    ulong           yields;             /* times the task used its budget */
+#ifdef VCL_PTHREADS
+    TskStats_t      stats;              /* what it cost */
+#endif
+} TskMgmt_t;
+
+/* global references */
+extern TskMgmt_t *  TskList;            /* allocated array of structures */
+extern ulong        TskCount;           /* perpetual task-run count metrix */
+extern RunIni_t     RunIni;             /* runtime .INI file parameters */
+
+/* macros */
+#define hTskValid(th)           (th && th <= RunIni.maxTasks)
+#define TskGetBox(th)           (TskList[th].boxp)
+#define TskGetCmd(th)           (TskList[th].cmdline)
+#define TskGetHandle(th)        (TskList[th].tskp)
+#define TskGetRetval(th)        (TskList[th].retval)
+#define TskGetYields(th)        (TskList[th].yields)
+#define TskPtrTo(th)            (&TskList[th])
+#define TskSetBox(th,p)         (TskList[th].boxp = p)
+#define TskSetCmd(th,p)         (TskList[th].cmdline = p)
+#define TskSetState(th,i)       (TskList[th].state = i)
+#define TskSetHandle(th,p)      (TskList[th].tskp = p)
+#define TskSetRetval(th,i)      (TskList[th].retval = i)
+#define TskSetYields(th,n)      (TskList[th].yields = n)
+#define TskRunning(th)          (TskList[th].state == TSK_RUNNING || \
+                                 TskList[th].state == TSK_WAITING || \
+                                 TskList[th].state == TSK_SUSPENDED || \
+                                 TskList[th].state == TSK_DEADLOCKED || \
+                                 TskList[th].state == TSK_READY || \
+                                 TskList[th].state == TSK_BLOCKED)
+
+/* prototypes */
+int             TskAlloc (void);
+int             TskExec (char *);
+int             TskGetState (int);
+int             TskKill (int);
+int             TskKillAll (void);
+void            TskYield (void);
+#ifdef VCL_PTHREADS
+int             TskPoolStart (void);
+void            TskPoolStop (void);
+int             TskWait (void);
+ulong           TskYields (int);
+int             TskStats (int, TskStats_t *);
+void            TskSwitch (void *);
+int             TskBlock (void);
+int             TskSelf (void);
+int             TskResume (int);
+#ifdef __linux__
+int             TskIoWait (void *, int, int, long);
+#endif
+int             TskChanStart (void);
+void            TskChanStop (void);
+int             TskOutStart (void);
+void            TskOutStop (void);
+FILE *          TskOutOpen (int);
+void            TskOutSkip (int);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* avoid mutiple inclusion */
+
@@ -0,0 +1,405 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*unpubModule*****************************************************************
+ NAME
+    tskout.c - VAST per-task output buffers for POSIX threads tasks
+
+ DESCRIPTION
+    The stdout of the tasks of vci-pt.  With RunIni.output TSKOUT_DIRECT
+    the tasks write the process's stdout, as before, and share its stdio
+    lock.  Otherwise each task gets a stream of its own, unbuffered by
+    stdio, whose writes are copied into the task's buffer; no lock is
+    shared by the tasks until the buffer is written out with write(),
+    under a lock only taken for that.
+
+    TSKOUT_BUFFERED
+        A task's buffer is written out when it holds RunIni.outBuf bytes,
+        up to its last whole line, and when the task ends.  Lines of the
+        tasks are not mixed, and each write is a large chunk.
+
+    TSKOUT_ORDERED
+        A task's output is kept until the task ends, and written out
+        once every task loaded before it has been, so the output is in
+        the order of their Load entries (see TskExec()).
+
+    TSKOUT_TAGGED
+        As TSKOUT_BUFFERED, with each line starting with the number of
+        the task, in the order the tasks were loaded, and a ':', to merge
+        the tasks' output into one log.
+
+ FUNCTIONS
+    TskOutStart()
+    TskOutStop()
+    TskOutOpen()
+    TskOutSkip()
+
+    TskOutWrite()
+    TskOutClose()
+    TskOutTurn()
+    TskOutAdd()
+    TskOutFlush()
+    TskOutEmit()
+
+ FILES
+    tskmgmt.h
+
+ SEE ALSO
+    tskpool.c, vci-pt.c
+
+ NOTES
+    A task's stream has no descriptor, so its writes never suspend the
+    task (see TskIoWait()); the worker writes the chunks itself.
+
+    The output of a task which never ends, one still blocked when the
+    pool stops, is not written out.  In TSKOUT_ORDERED the tasks after
+    it are then written out at TskOutStop().
+
+**********************************************************************unpubModule*/
+
+#define _GNU_SOURCE                     /* fopencookie() */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <scdef.h>
+
+#include "tskmgmt.h"                    /* must be after pthread.h */
+
+/* definitions */
+#define TAGSZ               16          /* longest line tag */
+
+/* output of a task */
+typedef struct TSKOUT
+{
+    int             seq;                /* 1-based, in the order loaded */
+    char *          buf;                /* allocated, not yet written out */
+    size_t          len;
+    size_t          max;                /* size of buf */
+    int             bol;                /* next byte starts a line */
+} TskOut_t;
+
+/* locals */
+static pthread_mutex_t  OutLock = PTHREAD_MUTEX_INITIALIZER;    /* writes out */
+static int              OutNext = 1;    /* next written out, ordered */
+static TskOut_t **      OutDone = NULL; /* ended, not written out, ordered */
+static int              OutDoneMax = 0;
+static TskOut_t         OutNone;        /* in OutDone, a task without output */
+
+/* prototypes */
+static ssize_t      TskOutWrite (void *, const char *, size_t);
+static int          TskOutClose (void *);
+static int          TskOutAdd (TskOut_t *, const char *, size_t);
+static void         TskOutTurn (TskOut_t *, int);
+static void         TskOutFlush (TskOut_t *, int);
+static void         TskOutEmit (char *, size_t);
+
+static cookie_io_functions_t    TskOutIo = { NULL, TskOutWrite, NULL, TskOutClose };
+
+
+/*
+ * Get ready for the tasks' output
+ *---------------------------------*/
+int
+TskOutStart (void)
+{
+    if ( RunIni.outBuf < BUFSIZ )
+        RunIni.outBuf = BUFSIZ;
+    return TRUE;
+} /* TskOutStart */
+
+
+/*
+ * Write out what the tasks which ended left, in order
+ *
+ * Only once no task can write, i.e. after the workers have stopped
+ *------------------------------------------------------------------*/
+void
+TskOutStop (void)
+{
+    TskOut_t *      o;
+    int             i;
+
+    pthread_mutex_lock( &OutLock );
+    for ( i = 0; i < OutDoneMax; ++i )
+    {
+        if ( ( o = OutDone[i] ) != NULL && o != &OutNone )
+        {
+            TskOutEmit( o->buf, o->len );
+            free( o->buf );
+            free( o );
+        }
+    }
+    free( OutDone );
+    OutDone = NULL;
+    OutDoneMax = 0;
+    pthread_mutex_unlock( &OutLock );
+} /* TskOutStop */
+
+
+/*
+ * Open the stdout of a task starting
+ *
+ * seq is the task's number in the order loaded, set by TskExec().
+ * Returns the stream, or NULL for the process's stdout
+ *-----------------------------------------------------------------*/
+FILE *
+TskOutOpen (int seq)
+{
+    TskOut_t *      o;
+    FILE *          fp;
+
+    if ( RunIni.output == TSKOUT_DIRECT )
+        return NULL;
+
+    if ( ( o = (TskOut_t *) calloc( 1, sizeof( TskOut_t ) )) == NULL ||
+         ( fp = fopencookie( o, "w", TskOutIo )) == NULL )
+    {
+        free( o );
+        TskOutSkip( seq );
+        return NULL;
+    }
+    setvbuf( fp, NULL, _IONBF, 0 );     /* buffered here instead */
+    o->seq = seq;
+    o->bol = TRUE;
+
+    return fp;
+} /* TskOutOpen */
+
+
+/*
+ * Pass over a task which will not open its stdout
+ *
+ * One not run or without a stream of its own, so the tasks
+ * after it do not wait for its turn
+ *-----------------------------------------------------------*/
+void
+TskOutSkip (int seq)
+{
+    if ( RunIni.output != TSKOUT_ORDERED )
+        return;
+
+    pthread_mutex_lock( &OutLock );
+    TskOutTurn( &OutNone, seq );
+    pthread_mutex_unlock( &OutLock );
+} /* TskOutSkip */
+
+
+/*
+ * Write a task's stream, into its buffer
+ *
+ * Writes out whole lines when the buffer is full, unless ordered.
+ * Returns size, or the bytes taken with errno ENOMEM if there is no
+ * memory; fopencookie() takes a negative return for a count
+ *-----------------------------------------------------------------*/
+static ssize_t
+TskOutWrite (void *cookie, const char *buf, size_t size)
+{
+    TskOut_t *      o = (TskOut_t *) cookie;
+    const char *    nl;
+    char            tag[TAGSZ];
+    size_t          n;
+    size_t          done = 0;
+
+    if ( RunIni.output != TSKOUT_TAGGED )
+    {
+        if ( ! TskOutAdd( o, buf, size ) )
+        {
+            errno = ENOMEM;
+            return 0;
+        }
+    }
+    else for ( done = 0; done < size; done += n )
+    {
+        /* a line at a time, each starting with the tag */
+        if ( o->bol )
+        {
+            sprintf( tag, "%d:", o->seq );
+            if ( ! TskOutAdd( o, tag, strlen( tag ) ) )
+            {
+                errno = ENOMEM;
+                return done;
+            }
+        }
+        nl = (const char *) memchr( buf + done, '\n', size - done );
+        n = nl ? (size_t) ( nl - ( buf + done ) ) + 1 : size - done;
+        if ( ! TskOutAdd( o, buf + done, n ) )
+        {
+            errno = ENOMEM;
+            return done;
+        }
+        o->bol = ( nl != NULL );
+    }
+
+    if ( RunIni.output != TSKOUT_ORDERED && o->len >= (size_t) RunIni.outBuf )
+        TskOutFlush( o, FALSE );
+    return size;
+} /* TskOutWrite */
+
+
+/*
+ * Close a task's stream, as the task ends
+ *
+ * Writes out the rest, or if ordered, the tasks ended
+ * whose turn it is
+ *-----------------------------------------------------*/
+static int
+TskOutClose (void *cookie)
+{
+    TskOut_t *      o = (TskOut_t *) cookie;
+
+    if ( RunIni.output != TSKOUT_ORDERED )
+    {
+        TskOutFlush( o, TRUE );
+        free( o->buf );
+        free( o );
+        return 0;
+    }
+
+    pthread_mutex_lock( &OutLock );
+    TskOutTurn( o, o->seq );
+    pthread_mutex_unlock( &OutLock );
+    return 0;
+} /* TskOutClose */
+
+
+/*
+ * Keep an ended task's output until its turn, with OutLock held
+ *
+ * Then writes it out with those after it which have ended.  o is
+ * &OutNone for a task with no output.
+ *-----------------------------------------------------------------*/
+static void
+TskOutTurn (TskOut_t *o, int seq)
+{
+    TskOut_t **     done;
+    int             max;
+
+    if ( seq - OutNext >= OutDoneMax )
+    {
+        max = ( seq - OutNext + 1 ) * 2;
+        if ( ( done = (TskOut_t **) realloc( OutDone, max * sizeof( TskOut_t * ) )) == NULL )
+        {
+            /* out of turn rather than not at all */
+            if ( o != &OutNone )
+            {
+                TskOutEmit( o->buf, o->len );
+                free( o->buf );
+                free( o );
+            }
+            return;
+        }
+        memset( done + OutDoneMax, 0, ( max - OutDoneMax ) * sizeof( TskOut_t * ) );
+        OutDone = done;
+        OutDoneMax = max;
+    }
+    OutDone[seq - OutNext] = o;
+
+    /* those whose turn it is, OutDone[0] is task OutNext */
+    while ( OutDoneMax > 0 && ( o = OutDone[0] ) != NULL )
+    {
+        if ( o != &OutNone )
+        {
+            TskOutEmit( o->buf, o->len );
+            free( o->buf );
+            free( o );
+        }
+        memmove( OutDone, OutDone + 1, ( OutDoneMax - 1 ) * sizeof( TskOut_t * ) );
+        OutDone[OutDoneMax - 1] = NULL;
+        ++OutNext;
+    }
+} /* TskOutTurn */
+
+
+/*
+ * Add to a task's buffer
+ *
+ * Returns FALSE if there is no memory
+ *-------------------------------------*/
+static int
+TskOutAdd (TskOut_t *o, const char *buf, size_t size)
+{
+    char *          p;
+    size_t          max;
+
+    if ( o->len + size > o->max )
+    {
+        max = o->max ? o->max : (size_t) RunIni.outBuf;
+        while ( max < o->len + size )
+            max *= 2;
+        if ( ( p = (char *) realloc( o->buf, max )) == NULL )
+            return FALSE;
+        o->buf = p;
+        o->max = max;
+    }
+    memcpy( o->buf + o->len, buf, size );
+    o->len += size;
+    return TRUE;
+} /* TskOutAdd */
+
+
+/*
+ * Write out a task's buffer, up to the last whole line unless all
+ *-----------------------------------------------------------------*/
+static void
+TskOutFlush (TskOut_t *o, int all)
+{
+    size_t          n = o->len;
+
+    if ( ! all )
+        while ( n > 0 && o->buf[n - 1] != '\n' )
+            --n;
+    if ( n == 0 )
+        return;
+
+    pthread_mutex_lock( &OutLock );
+    TskOutEmit( o->buf, n );
+    pthread_mutex_unlock( &OutLock );
+
+    memmove( o->buf, o->buf + n, o->len - n );
+    o->len -= n;
+} /* TskOutFlush */
+
+
+/*
+ * Write a chunk to the process's stdout, with OutLock held
+ *
+ * After what the host has written to it with stdio
+ *----------------------------------------------------------*/
+static void
+TskOutEmit (char *buf, size_t len)
+{
+    ssize_t         n;
+
+    fflush( stdout );
+    while ( len )
+    {
+        if ( ( n = write( STDOUT_FILENO, buf, len )) < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+            return;                     /* nowhere to put it */
+        }
+        buf += n;
+        len -= n;
+    }
+} /* TskOutEmit */
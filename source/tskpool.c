@@ -0,0 +1,1400 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*unpubModule*****************************************************************
+ NAME
+    tskpool.c - VAST Task Management for POSIX threads
+
+ DESCRIPTION
+    Task management routines for the POSIX threads multi-task host,
+    vci-pt.  These replace the RT-Kernel routines at the end of vci-mt.c.
+
+    A task is a slot in TskList, exactly as in vci-mt.  Instead of creating
+    an RT-Kernel task for each slot, TskExec() places the slot's handle on
+    a job queue which is served by a fixed pool of worker threads.  The
+    pool size comes from RunIni.workers, and each worker runs with a
+    scheduling priority derived from RunIni.priority relative to
+    RunIni.mainPriority.
+
+    Each task is a coroutine with its own stack of RunIni.stack bytes, so
+    many more tasks than workers can be under way at once.  A worker runs
+    a task until it suspends itself, then takes the next one off the job
+    queue.  A task suspends when its budget is used up (TskSwitch(), the
+    VCL yield hook), going back to the end of the job queue as TSK_READY,
+    or in TskBlock(), as TSK_BLOCKED until TskResume().  A task may be
+    resumed by a different worker than the one it suspended on.
+
+    When a task halts its worker puts the handle on a completion queue and
+    signals the supervisor, which sleeps in TskWait() until then.  Nothing
+    scans TskList to find out what finished.
+
+    A worker cannot be preempted in the middle of the interpreter, so a
+    task runs with a budget of RunIni.budget loop iterations and calls
+    and gives up the processor each time it is used up.  The count is
+    kept in the task's slot when it halts, see TskYields().
+
+    Each slot also keeps what its task costs, see TskStats(): the time
+    from when it first ran until it halted, the processor time of the
+    workers while they ran it, and the time it spent TSK_BLOCKED.  When
+    it halts the counts of its interpreter are added, the statements
+    executed, its peak data space, stack and heap, and the files it
+    opened (see vclStats()).  If RunIni.statsFile is set a JSON line
+    with those is appended to it as each task halts, and every
+    RunIni.statsEvery seconds one for each task under way, to find the
+    tasks which hog the pool.
+
+    On Linux a task also suspends, as TSK_BLOCKED, when a VCL stdio call
+    would wait for a pipe or socket, or in sleep() and delay().  TskIoWait(),
+    the VCL I/O wait hook, registers the descriptor and time limit with an
+    I/O loop thread, which waits on epoll for all the tasks at once and
+    resumes each when its descriptor is ready or its time is up.  The
+    worker meanwhile runs other tasks.
+
+ FUNCTIONS
+    TskPoolStart()
+    TskPoolStop()
+    TskAlloc()
+    TskExec()
+    TskGetState()
+    TskKill()
+    TskKillAll()
+    TskWait()
+    TskYield()
+    TskYields()
+    TskIoWait()
+    TskSwitch()
+    TskBlock()
+    TskSelf()
+    TskResume()
+    TskStats()
+
+    TskWorker()
+    TskEntry()
+    TskSuspend()
+    TskQueue()
+    TskNice()
+    TskUnqueue()
+    TskIoStart()
+    TskIoStop()
+    TskIoLoop()
+    TskNow()
+    TskStatsStart()
+    TskStatsStop()
+    TskStatsLoop()
+    TskStatsNow()
+    TskStatsPut()
+    TskStatsStr()
+    TskMicros()
+
+ FILES
+    tskmgmt.h
+
+ SEE ALSO
+    vci-pt.c, vclptin.cpp, tskchan.c, tskout.c
+
+ NOTES
+    A task which is running cannot be killed; POSIX threads offer no safe
+    way to terminate a thread in the middle of the interpreter.  TskKill()
+    of a running task fails with EBUSY.  A task still waiting in the job
+    queue is removed from the queue and freed.
+
+    The state of a slot is changed only while holding TskLock.  The macros
+    in tskmgmt.h are used only by the code here, under the lock.
+
+    A task which has started, i.e. is TSK_RUNNING, TSK_READY or
+    TSK_BLOCKED, cannot be killed either; its interpreter is in the
+    middle of a call on the coroutine's stack.
+
+    errno is per thread and does not follow a task to another worker.
+
+    A task's stdout is its own stream when RunIni.output asks for it,
+    see tskout.c.
+
+    The I/O loop finds the nearest time limit by scanning the waits of
+    all slots, which is cheap for the slot counts of vci-pt.ini.  A
+    descriptor which another task is already waiting for is registered
+    through a dup(), epoll takes each only once.  Regular files cannot
+    be waited for; their calls never suspend.
+
+    The dump is written under TskLock, into the stdio buffer of the
+    file, and flushed by the periodic dump.  Processor time is that of
+    the worker threads; the helper threads of spawn() and parallel_map()
+    (see vclspawn.cpp) are not counted.  The interpreter's counts are
+    only known once a task halts, so the periodic lines have the times.
+
+**********************************************************************unpubModule*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sched.h>
+#include <ucontext.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+#include <poll.h>
+#include <time.h>
+
+#include <scdef.h>
+
+#include "tskmgmt.h"                    /* must be after pthread.h */
+#include "vcl.h"                        /* VCL_IOREAD, VCL_IOWRITE */
+
+/* definitions */
+#define MINSTACK            65536U      /* smallest sensible worker stack */
+#define IOEVENTS            64          /* epoll events taken at once */
+
+/* worker thread */
+typedef struct TSKWORKER
+{
+    pthread_t       thread;             /* the POSIX thread */
+    int             id;                 /* 1-based worker number */
+    int             hTsk;               /* task being run, 0 when idle */
+    ucontext_t      sched;              /* worker's context, tasks return here */
+} TskWorker_t;
+
+/* task coroutine */
+typedef struct TSKCORO
+{
+    ucontext_t      ctx;                /* task's context while suspended */
+    char *          stack;              /* its stack */
+    TskWorker_t *   wp;                 /* worker running it */
+    int             hTsk;               /* its task */
+    int             suspend;            /* TSK_READY or TSK_BLOCKED */
+    int             wake;               /* TskResume() before it suspended */
+    int             done;               /* VclPtRun() has returned */
+    int             ret;                /* its return value */
+    VCLSTATS        stats;              /* its interpreter's counts */
+    long long       blocked;            /* TSK_BLOCKED since, TskMicros() */
+} TskCoro_t;
+
+#ifdef __linux__
+/* I/O wait of a task, one for each task slot */
+typedef struct TSKIOWAIT
+{
+    int             armed;              /* waiting, the I/O loop may wake it */
+    unsigned        seq;                /* tells this wait from earlier ones */
+    int             fd;                 /* descriptor registered, -1 for none */
+    int             dup;                /* fd is a dup() of the task's */
+    long long       due;                /* time limit, TskNow() ms, or -1 */
+    int             timedout;           /* woken by the time limit */
+} TskIoWait_t;
+#endif
+
+/* externals */
+extern int          GlobalReturnValue;
+int                 VclPtRun (char *, FILE *, FILE *, FILE *, VCLSTATS *);    /* in vclptin.cpp */
+void                VclPtFlush (void);      /* in vclptin.cpp */
+extern void         (* VclPtYield) (void *);    /* in vclptin.cpp */
+extern int          (* VclPtIoWait) (void *, int, int, long);  /* in vclptin.cpp */
+
+/* locals */
+static pthread_mutex_t  TskLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   TskQueued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t   TskDone = PTHREAD_COND_INITIALIZER;
+static TskWorker_t *    Workers = NULL; /* allocated array of workers */
+static int              WorkerCount = 0;
+static int *            JobQueue = NULL;/* ring of queued task handles */
+static int              JobHead = 0;    /* next to be taken */
+static int              JobCount = 0;   /* number in the ring */
+static int *            DoneQueue = NULL;   /* ring of halted task handles */
+static int              DoneHead = 0;   /* next to be reaped */
+static int              DoneCount = 0;  /* number in the ring */
+static int              TskActive = 0;  /* tasks queued or running */
+static int              PoolStopping = FALSE;
+static size_t           CoroStack;      /* task coroutine stack size */
+static pthread_key_t    CoroKey;        /* task a worker is running */
+#ifdef __linux__
+static pthread_mutex_t  IoLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t        IoThread;       /* the I/O loop */
+static TskIoWait_t *    IoWaits = NULL; /* allocated array, one per slot */
+static int              IoEpoll = -1;   /* the loop's epoll instance */
+static int              IoWake = -1;    /* eventfd, wakes the loop */
+static int              IoStopping = FALSE;
+#endif
+static pthread_cond_t   StatsWake = PTHREAD_COND_INITIALIZER;
+static pthread_t        StatsThread;    /* the periodic dump */
+static FILE *           StatsFp = NULL; /* RunIni.statsFile, or NULL */
+static int              StatsLooping = FALSE;   /* StatsThread started */
+static int              StatsStopping = FALSE;
+static const char *     StateNames[] = { "free", "running", "waiting",
+                            "suspended", "deadlocked", "halted", "ready",
+                            "blocked", "unknown" };
+
+/* prototypes */
+static void *       TskWorker (void *);
+static void         TskEntry (int);
+static void         TskSuspend (int);
+static void         TskQueue (int);
+static void         TskNice (void);
+static int          TskUnqueue (int *, int, int *, int);
+#ifdef __linux__
+static int          TskIoStart (void);
+static void         TskIoStop (void);
+static void *       TskIoLoop (void *);
+static long long    TskNow (void);
+#endif
+static int          TskStatsStart (void);
+static void         TskStatsStop (void);
+static void *       TskStatsLoop (void *);
+static void         TskStatsNow (int, TskStats_t *);
+static void         TskStatsPut (int, const char *);
+static void         TskStatsStr (const char *);
+static long long    TskMicros (clockid_t);
+
+
+/*
+ * Start the worker pool
+ *
+ * Must be called after TskList is allocated.
+ *--------------------------------------------*/
+int
+TskPoolStart (void)
+{
+    pthread_attr_t  attr;
+    size_t          stack;
+    int             i;
+
+    /* one job and one completion queue entry for every task slot */
+    JobQueue = (int *) calloc( RunIni.maxTasks + 1, sizeof( int ) );
+    DoneQueue = (int *) calloc( RunIni.maxTasks + 1, sizeof( int ) );
+    if ( JobQueue == NULL || DoneQueue == NULL )
+    {
+        errno = ENOMEM;
+        return FALSE;
+    }
+
+    /* fixed pool, one worker per processor unless .INI says otherwise */
+    WorkerCount = RunIni.workers;
+    if ( WorkerCount <= 0 )
+        WorkerCount = (int) sysconf( _SC_NPROCESSORS_ONLN );
+    if ( WorkerCount <= 0 )
+        WorkerCount = 1;
+    if ( WorkerCount > RunIni.maxTasks )
+        WorkerCount = RunIni.maxTasks;
+
+    Workers = (TskWorker_t *) calloc( WorkerCount, sizeof( TskWorker_t ) );
+    if ( Workers == NULL )
+    {
+        errno = ENOMEM;
+        return FALSE;
+    }
+
+    /* the interpreter recurses on the task's stack, don't go below a minimum */
+    CoroStack = RunIni.stack;
+    if ( CoroStack < MINSTACK )
+        CoroStack = MINSTACK;
+
+    /* the workers themselves only schedule */
+    stack = MINSTACK;
+    if ( stack < PTHREAD_STACK_MIN )
+        stack = PTHREAD_STACK_MIN;
+
+    if ( (errno = pthread_key_create( &CoroKey, NULL )) != 0 )
+        return FALSE;
+    VclPtYield = TskSwitch;             /* budget used up, switch tasks */
+
+#ifdef __linux__
+    if ( ! TskIoStart() )
+        return FALSE;
+#endif
+    if ( ! TskChanStart() )
+        return FALSE;
+    if ( ! TskOutStart() )
+        return FALSE;
+    if ( ! TskStatsStart() )
+        return FALSE;
+
+    pthread_attr_init( &attr );
+    pthread_attr_setstacksize( &attr, stack );
+
+    for ( i = 0; i < WorkerCount; ++i )
+    {
+        Workers[i].id = i + 1;
+        if ( (errno = pthread_create( &Workers[i].thread, &attr,
+                                      TskWorker, &Workers[i] )) != 0 )
+        {
+            WorkerCount = i;
+            pthread_attr_destroy( &attr );
+            return FALSE;
+        }
+    }
+
+    pthread_attr_destroy( &attr );
+    return TRUE;
+} /* TskPoolStart */
+
+
+/*
+ * Stop the worker pool
+ *
+ * Waits for the started tasks to finish, except any which are
+ * blocked.  Tasks still waiting in the job queue are not started.
+ *-----------------------------------------------------------------*/
+void
+TskPoolStop (void)
+{
+    int         i;
+
+    pthread_mutex_lock( &TskLock );
+    PoolStopping = TRUE;
+    pthread_cond_broadcast( &TskQueued );
+    pthread_cond_broadcast( &TskDone );
+    pthread_mutex_unlock( &TskLock );
+
+    for ( i = 0; i < WorkerCount; ++i )
+        pthread_join( Workers[i].thread, NULL );
+    pthread_key_delete( CoroKey );
+#ifdef __linux__
+    TskIoStop();                        /* after the workers, they may wait */
+#endif
+    TskChanStop();
+    TskOutStop();
+    TskStatsStop();                     /* the tasks left blocked */
+
+    VclPtFlush();                       /* free the compiled programs */
+
+    free( Workers );
+    free( JobQueue );
+    free( DoneQueue );
+    Workers = NULL;
+    JobQueue = NULL;
+    DoneQueue = NULL;
+    WorkerCount = 0;
+} /* TskPoolStop */
+
+
+/*
+ * Worker thread
+ *
+ * Takes task handles off the job queue and runs each task's
+ * coroutine until it halts or suspends itself.  Once the pool
+ * is stopping only tasks which have started are run.
+ *-------------------------------------------------------------*/
+static void *
+TskWorker (void *arg)
+{
+    TskWorker_t *   wp = (TskWorker_t *) arg;
+    TskCoro_t *     co;
+    TskStats_t *    st;
+    int             slots = RunIni.maxTasks + 1;
+    int             hTsk;
+    int             i;
+    long long       cpu;
+
+    TskNice();
+
+    pthread_mutex_lock( &TskLock );
+    for ( ;; )
+    {
+        /* find the next task to run, the head unless stopping */
+        for ( i = 0; i < JobCount; ++i )
+        {
+            hTsk = JobQueue[(JobHead + i) % slots];
+            if ( ! PoolStopping || TskList[hTsk].state == TSK_READY )
+                break;
+        }
+        if ( i == JobCount )
+        {
+            if ( PoolStopping )
+                break;
+            pthread_cond_wait( &TskQueued, &TskLock );
+            continue;
+        }
+
+        /* take it off the queue */
+        if ( i == 0 )
+        {
+            JobHead = (JobHead + 1) % slots;
+            --JobCount;
+        }
+        else
+            TskUnqueue( JobQueue, JobHead, &JobCount, hTsk );
+
+        /* a new task gets a coroutine */
+        if ( (co = TskGetHandle( hTsk )) == NULL )
+        {
+            if ( ( co = (TskCoro_t *) calloc( 1, sizeof( TskCoro_t ) )) == NULL ||
+                 ( co->stack = (char *) malloc( CoroStack )) == NULL )
+            {
+                free( co );
+                co = NULL;
+            }
+            else
+            {
+                getcontext( &co->ctx );
+                co->ctx.uc_stack.ss_sp = co->stack;
+                co->ctx.uc_stack.ss_size = CoroStack;
+                co->ctx.uc_link = NULL;
+                co->hTsk = hTsk;
+                makecontext( &co->ctx, (void (*)(void)) TskEntry, 1, hTsk );
+                TskSetHandle( hTsk, co );
+            }
+        }
+
+        if ( co != NULL )
+        {
+            st = &TskPtrTo( hTsk )->stats;
+            if ( st->start == 0 )
+                st->start = TskMicros( CLOCK_MONOTONIC );
+            TskSetState( hTsk, TSK_RUNNING );
+            wp->hTsk = hTsk;
+            co->wp = wp;
+            co->suspend = 0;
+            pthread_mutex_unlock( &TskLock );
+
+            /* run it until it halts or suspends */
+            cpu = TskMicros( CLOCK_THREAD_CPUTIME_ID );
+            pthread_setspecific( CoroKey, co );
+            swapcontext( &wp->sched, &co->ctx );
+            pthread_setspecific( CoroKey, NULL );
+            cpu = TskMicros( CLOCK_THREAD_CPUTIME_ID ) - cpu;
+
+            pthread_mutex_lock( &TskLock );
+            wp->hTsk = 0;
+            st->cpu += cpu;
+            st->wall = TskMicros( CLOCK_MONOTONIC ) - st->start;
+
+            /* suspended; ready again at the back of the queue, or blocked */
+            if ( ! co->done )
+            {
+                if ( co->suspend == TSK_BLOCKED && ! co->wake )
+                {
+                    TskSetState( hTsk, TSK_BLOCKED );
+                    co->blocked = TskMicros( CLOCK_MONOTONIC );
+                }
+                else
+                {
+                    if ( co->suspend == TSK_BLOCKED )
+                        co->wake = FALSE;   /* resumed before it blocked */
+                    TskQueue( hTsk );
+                }
+                continue;
+            }
+
+            TskSetRetval( hTsk, co->ret );
+            TskSetYields( hTsk, co->stats.yields );
+            st->statements = co->stats.statements;
+            st->data = co->stats.data;
+            st->stack = co->stats.stack;
+            st->heap = co->stats.heap;
+            st->files = co->stats.files;
+            free( co->stack );
+            free( co );
+        }
+        else
+        {
+            TskSetRetval( hTsk, ENOMEM );
+            TskOutSkip( (int) TskPtrTo( hTsk )->stats.run );
+        }
+
+        if ( ! GlobalReturnValue )      /* don't overwrite existing error */
+            GlobalReturnValue = TskGetRetval( hTsk );
+        TskSetHandle( hTsk, NULL );
+        TskSetState( hTsk, TSK_HALTED );    /* now we're halted */
+        TskStatsPut( hTsk, "halt" );
+
+        /* tell the supervisor */
+        DoneQueue[(DoneHead + DoneCount) % slots] = hTsk;
+        ++DoneCount;
+        --TskActive;
+        pthread_cond_signal( &TskDone );
+    }
+    pthread_mutex_unlock( &TskLock );
+
+    return NULL;
+} /* TskWorker */
+
+
+/*
+ * Task coroutine
+ *
+ * Runs the task's command line, then returns to the worker
+ * which is running it at the time
+ *----------------------------------------------------------*/
+static void
+TskEntry (int hTsk)
+{
+    TskCoro_t *     co = TskGetHandle( hTsk );
+    FILE *          out = TskOutOpen( (int) TskPtrTo( hTsk )->stats.run );
+
+    /* the command line doesn't change while we're running */
+    co->ret = VclPtRun( TskGetCmd( hTsk ), NULL, out, NULL, &co->stats );
+    if ( out != NULL )
+        fclose( out );                  /* the rest of its output */
+    co->done = TRUE;
+    setcontext( &co->wp->sched );
+} /* TskEntry */
+
+
+/*
+ * Suspend the calling task
+ *
+ * state is TSK_READY or TSK_BLOCKED.  Switches back to the worker,
+ * which queues or parks the task.  Returns when it is resumed,
+ * possibly on another worker.
+ *------------------------------------------------------------------*/
+static void
+TskSuspend (int state)
+{
+    TskCoro_t *     co = (TskCoro_t *) pthread_getspecific( CoroKey );
+
+    co->suspend = state;
+    swapcontext( &co->ctx, &co->wp->sched );
+} /* TskSuspend */
+
+
+/*
+ * Queue a task to be resumed
+ *
+ * Called with TskLock held.
+ *----------------------------*/
+static void
+TskQueue (int hTsk)
+{
+    TskSetState( hTsk, TSK_READY );
+    JobQueue[(JobHead + JobCount) % (RunIni.maxTasks + 1)] = hTsk;
+    ++JobCount;
+    pthread_cond_signal( &TskQueued );
+} /* TskQueue */
+
+
+/*
+ * Set the calling worker's priority
+ *
+ * RT-Kernel priorities are higher-is-more-important, relative to
+ * the main task.  Map the difference onto the thread's nice value.
+ * Raising priority needs privileges; a failure is not an error.
+ *------------------------------------------------------------------*/
+static void
+TskNice (void)
+{
+#ifdef __linux__
+    int         nice;
+
+    nice = (int) RunIni.mainPriority - (int) RunIni.priority;
+    if ( nice < -20 )
+        nice = -20;
+    else if ( nice > 19 )
+        nice = 19;
+    if ( nice )
+        setpriority( PRIO_PROCESS, (id_t) syscall( SYS_gettid ), nice );
+#endif
+} /* TskNice */
+
+
+/*
+ *  Allocate a task handle
+ *
+ *  Called with TskLock held.
+ *-------------------------*/
+int
+TskAlloc (void)
+{
+    int         hTsk;
+
+    /* find first available task management slot */
+    for ( hTsk = 1; hTskValid( hTsk ); ++hTsk )
+    {
+        if ( TskList[hTsk].state == TSK_FREE )
+        {
+            TskSetState( hTsk, TSK_WAITING );
+            break;
+        }
+    }
+
+    if ( ! hTskValid( hTsk ) )
+    {
+        errno = EAGAIN;                 /* resource not available */
+        hTsk = 0;                       /* no slot available, fail */
+    }
+
+    return hTsk;
+} /* TskAlloc */
+
+
+/*
+ * Execute a task
+ *
+ * The task handle int is 1-based; a 0 handle is invalid.  The task
+ * waits in the job queue, in state TSK_WAITING, until a worker is
+ * free to run it.
+ *--------------------------------------------------------------------*/
+int
+TskExec (char *commandLine)
+{
+    int             hTsk;               /* handle to task, 1-based, 0 invalid */
+    char *          cmd;
+
+    if ( (cmd = strdup( commandLine )) == NULL )
+    {
+        errno = ENOMEM;
+        return 0;
+    }
+
+    pthread_mutex_lock( &TskLock );
+
+    /* allocate a task handle */
+    hTsk = TskAlloc();                  /* sets state to TSK_WAITING */
+    if ( ! hTskValid( hTsk ) )
+    {
+        pthread_mutex_unlock( &TskLock );
+        free( cmd );
+        return 0;
+    }
+
+    /* setup this task's command line */
+    TskSetCmd( hTsk, cmd );
+    TskSetRetval( hTsk, 0 );
+    TskSetBox( hTsk, NULL );
+    TskSetHandle( hTsk, NULL );
+
+    ++TskCount;                         /* inc task-run count metrix */
+    ++TskActive;
+    memset( &TskPtrTo( hTsk )->stats, 0, sizeof( TskStats_t ) );
+    TskPtrTo( hTsk )->stats.run = TskCount;    /* its output's turn, see TskOutOpen() */
+
+    /* queue it for the workers */
+    JobQueue[(JobHead + JobCount) % (RunIni.maxTasks + 1)] = hTsk;
+    ++JobCount;
+    pthread_cond_signal( &TskQueued );
+
+    pthread_mutex_unlock( &TskLock );
+
+    return TRUE;
+} /* TskExec */
+
+
+/*
+ *  Get a task's state
+ *---------------------*/
+int
+TskGetState (int hTsk)
+{
+    int         state = TSK_UNKNOWN;
+
+    if ( hTskValid( hTsk ) )
+    {
+        pthread_mutex_lock( &TskLock );
+        state = TskList[hTsk].state;
+        pthread_mutex_unlock( &TskLock );
+    }
+    return state;
+} /* TskGetState */
+
+
+/*
+ * Kill a task
+ *
+ * Frees a halted task, or a task still waiting in the job queue.
+ * A task which has started cannot be killed.
+ *----------------------------------------------------------------*/
+int
+TskKill (int hTsk)
+{
+    if ( ! hTskValid( hTsk ) )
+        return TRUE;
+
+    pthread_mutex_lock( &TskLock );
+
+    if ( TskList[hTsk].state == TSK_RUNNING ||
+         TskList[hTsk].state == TSK_READY || TskList[hTsk].state == TSK_BLOCKED )
+    {
+        pthread_mutex_unlock( &TskLock );
+        errno = EBUSY;
+        return FALSE;
+    }
+
+    /* take a waiting task out of the job queue */
+    if ( TskList[hTsk].state == TSK_WAITING )
+    {
+        if ( TskUnqueue( JobQueue, JobHead, &JobCount, hTsk ) )
+        {
+            --TskActive;
+            pthread_cond_signal( &TskDone );
+            TskOutSkip( (int) TskPtrTo( hTsk )->stats.run );
+        }
+    }
+    /* or a halted task, not yet reaped, out of the completion queue */
+    else if ( TskList[hTsk].state == TSK_HALTED )
+        TskUnqueue( DoneQueue, DoneHead, &DoneCount, hTsk );
+
+    /* free any attached command line */
+    if ( TskGetCmd( hTsk ) )
+        free( TskGetCmd( hTsk ) );
+    TskSetCmd( hTsk, NULL );
+    TskSetHandle( hTsk, NULL );
+    TskSetBox( hTsk, NULL );
+
+    /* reset task return value */
+    TskSetRetval( hTsk, 0 );
+
+    /* now the slot is free for reuse */
+    TskSetState( hTsk, TSK_FREE );
+
+    pthread_mutex_unlock( &TskLock );
+
+    return TRUE;
+} /* TskKill */
+
+
+/*
+ *  Kill all tasks
+ *------------------*/
+int
+TskKillAll (void)
+{
+    int         hTsk;
+
+    for ( hTsk = 1; hTskValid( hTsk); ++hTsk )
+    {
+        if ( TskGetState( hTsk ) != TSK_FREE )
+        {
+            if ( ! TskKill( hTsk ) )
+                return FALSE;
+        }
+    }
+    return TRUE;
+} /* TskKillAll */
+
+
+/*
+ * Wait for a task to complete
+ *
+ * Sleeps until a worker halts a task, then returns its handle.  The
+ * task is left TSK_HALTED for the caller to inspect and TskKill().
+ * Returns 0 when no task is queued or running, or the pool stops.
+ *------------------------------------------------------------------*/
+int
+TskWait (void)
+{
+    int         hTsk = 0;
+
+    pthread_mutex_lock( &TskLock );
+
+    while ( DoneCount == 0 && TskActive > 0 && ! PoolStopping )
+        pthread_cond_wait( &TskDone, &TskLock );
+
+    if ( DoneCount > 0 )
+    {
+        hTsk = DoneQueue[DoneHead];
+        DoneHead = (DoneHead + 1) % (RunIni.maxTasks + 1);
+        --DoneCount;
+    }
+
+    pthread_mutex_unlock( &TskLock );
+
+    return hTsk;
+} /* TskWait */
+
+
+/*
+ * Remove a task handle from a ring
+ *
+ * Called with TskLock held.  Returns TRUE if it was found.
+ *----------------------------------------------------------*/
+static int
+TskUnqueue (int *ring, int head, int *count, int hTsk)
+{
+    int         slots = RunIni.maxTasks + 1;
+    int         i;
+    int         n;
+
+    for ( i = 0, n = 0; i < *count; ++i )
+    {
+        int     h = ring[(head + i) % slots];
+
+        if ( h != hTsk )
+            ring[(head + n++) % slots] = h;
+    }
+    i = (n != *count);
+    *count = n;
+
+    return i;
+} /* TskUnqueue */
+
+
+/*
+ *  Yield a task's execution
+ *---------------------------*/
+void
+TskYield (void)
+{
+    usleep( RunIni.yield * 1000 );
+} /* TskYield */
+
+
+/*
+ * Budget used up, let the other tasks run
+ *
+ * The VCL yield hook of the pool's tasks.  Outside a task it
+ * gives up the processor instead.
+ *------------------------------------------------------------*/
+void
+TskSwitch (void *arg)
+{
+    arg = arg;                          /* avoid 'not used' compiler warning */
+
+    if ( pthread_getspecific( CoroKey ) != NULL )
+        TskSuspend( TSK_READY );
+    else
+        sched_yield();
+} /* TskSwitch */
+
+
+/*
+ * Block the calling task until TskResume()
+ *
+ * For a task waiting on something other than the processor, so the
+ * worker can run other tasks meanwhile.  Returns FALSE, at once, if
+ * the caller is not a task of the pool.
+ *-------------------------------------------------------------------*/
+int
+TskBlock (void)
+{
+    if ( pthread_getspecific( CoroKey ) == NULL )
+        return FALSE;
+    TskSuspend( TSK_BLOCKED );
+    return TRUE;
+} /* TskBlock */
+
+
+/*
+ * Get the calling task's handle
+ *
+ * Returns 0 if the caller is not a task of the pool
+ *---------------------------------------------------*/
+int
+TskSelf (void)
+{
+    TskCoro_t *     co = (TskCoro_t *) pthread_getspecific( CoroKey );
+
+    return co ? co->hTsk : 0;
+} /* TskSelf */
+
+
+/*
+ * Resume a task blocked in TskBlock()
+ *
+ * May be called from any thread, also before the task has
+ * blocked; its next TskBlock() then returns at once.
+ *----------------------------------------------------------*/
+int
+TskResume (int hTsk)
+{
+    int         ok = FALSE;
+
+    if ( ! hTskValid( hTsk ) )
+        return FALSE;
+
+    pthread_mutex_lock( &TskLock );
+    if ( TskList[hTsk].state == TSK_BLOCKED )
+    {
+        TskPtrTo( hTsk )->stats.blocked +=
+            TskMicros( CLOCK_MONOTONIC ) - TskGetHandle( hTsk )->blocked;
+        TskQueue( hTsk );
+        ok = TRUE;
+    }
+    else if ( ( TskList[hTsk].state == TSK_RUNNING ||
+                TskList[hTsk].state == TSK_READY ) && TskGetHandle( hTsk ) )
+    {
+        TskGetHandle( hTsk )->wake = TRUE;
+        ok = TRUE;
+    }
+    pthread_mutex_unlock( &TskLock );
+
+    return ok;
+} /* TskResume */
+
+
+/*
+ * Get the number of times a task used up its budget
+ *
+ * Counted while it ran, see RunIni.budget; 0 for a task
+ * which has not yet halted.
+ *--------------------------------------------------------*/
+ulong
+TskYields (int hTsk)
+{
+    ulong       yields = 0;
+
+    if ( hTskValid( hTsk ) )
+    {
+        pthread_mutex_lock( &TskLock );
+        yields = TskGetYields( hTsk );
+        pthread_mutex_unlock( &TskLock );
+    }
+    return yields;
+} /* TskYields */
+
+
+/*
+ * Get what a task has cost so far
+ *
+ * Fills st, see TskStats_t; the times of a task under way are up to
+ * now, or its last switch for the processor time.  The counts of its
+ * interpreter are 0 until it halts.  Returns FALSE for a free slot.
+ *--------------------------------------------------------------------*/
+int
+TskStats (int hTsk, TskStats_t *st)
+{
+    int         ok = FALSE;
+
+    if ( hTskValid( hTsk ) )
+    {
+        pthread_mutex_lock( &TskLock );
+        if ( TskList[hTsk].state != TSK_FREE )
+        {
+            TskStatsNow( hTsk, st );
+            ok = TRUE;
+        }
+        pthread_mutex_unlock( &TskLock );
+    }
+    return ok;
+} /* TskStats */
+
+
+#ifdef __linux__
+/*
+ * Wait for a descriptor to be ready, or for a time
+ *
+ * The VCL I/O wait hook, see vclIoWait().  events is VCL_IOREAD
+ * and/or VCL_IOWRITE, fd -1 waits for the time only and msecs -1
+ * waits without a limit.  Inside a task the task is blocked and
+ * the I/O loop resumes it; anywhere else the thread waits in poll().
+ *
+ * Returns 1 if fd is ready, 0 if the time is up, -1 on error
+ *--------------------------------------------------------------------*/
+int
+TskIoWait (void *arg, int fd, int events, long msecs)
+{
+    TskIoWait_t *       w;
+    struct epoll_event  ev;
+    struct pollfd       pfd;
+    int                 hTsk = TskSelf();
+    int                 waiting;
+    int                 err = 0;
+
+    arg = arg;                          /* avoid 'not used' compiler warning */
+
+    if ( hTsk == 0 || IoWaits == NULL )
+    {
+        pfd.fd = fd;
+        pfd.events = ( ( events & VCL_IOREAD ) ? POLLIN : 0 ) |
+                     ( ( events & VCL_IOWRITE ) ? POLLOUT : 0 );
+        pfd.revents = 0;
+        return poll( &pfd, fd >= 0 ? 1 : 0, msecs < 0 ? -1 : (int) msecs );
+    }
+
+    w = &IoWaits[hTsk];
+    pthread_mutex_lock( &IoLock );
+    ++w->seq;
+    w->fd = -1;
+    w->dup = FALSE;
+    w->due = ( msecs >= 0 ) ? TskNow() + msecs : -1;
+    w->timedout = FALSE;
+    w->armed = TRUE;
+    pthread_mutex_unlock( &IoLock );
+
+    if ( fd >= 0 )
+    {
+        ev.events = ( ( events & VCL_IOREAD ) ? EPOLLIN : 0 ) |
+                    ( ( events & VCL_IOWRITE ) ? EPOLLOUT : 0 ) | EPOLLONESHOT;
+        ev.data.u64 = ( (unsigned long long) w->seq << 32 ) | (unsigned) hTsk;
+        w->fd = fd;
+        if ( epoll_ctl( IoEpoll, EPOLL_CTL_ADD, fd, &ev ) != 0 )
+        {
+            err = errno;
+            w->fd = -1;
+            if ( err == EEXIST && ( w->fd = dup( fd )) >= 0 )
+            {
+                w->dup = TRUE;          /* another task waits for fd */
+                if ( epoll_ctl( IoEpoll, EPOLL_CTL_ADD, w->fd, &ev ) != 0 )
+                {
+                    err = errno;
+                    close( w->fd );
+                    w->fd = -1;
+                }
+            }
+        }
+        if ( w->fd < 0 )
+        {
+            pthread_mutex_lock( &IoLock );
+            w->armed = FALSE;
+            pthread_mutex_unlock( &IoLock );
+            if ( err == EPERM )
+                return 1;               /* a regular file, always ready */
+            errno = err;
+            return -1;
+        }
+    }
+    if ( w->due >= 0 )
+        eventfd_write( IoWake, 1 );     /* the loop takes the new time limit */
+
+    /* suspend until the loop has disarmed the wait */
+    do
+    {
+        TskBlock();
+        pthread_mutex_lock( &IoLock );
+        waiting = w->armed;
+        pthread_mutex_unlock( &IoLock );
+    } while ( waiting );
+
+    if ( w->fd >= 0 )
+    {
+        epoll_ctl( IoEpoll, EPOLL_CTL_DEL, w->fd, NULL );
+        if ( w->dup )
+            close( w->fd );
+    }
+    return w->timedout ? 0 : 1;
+} /* TskIoWait */
+
+
+/*
+ * Start the I/O loop
+ *--------------------*/
+static int
+TskIoStart (void)
+{
+    struct epoll_event  ev;
+
+    if ( ( IoWaits = (TskIoWait_t *) calloc( RunIni.maxTasks + 1,
+                                             sizeof( TskIoWait_t ) )) == NULL )
+    {
+        errno = ENOMEM;
+        return FALSE;
+    }
+    if ( ( IoEpoll = epoll_create1( EPOLL_CLOEXEC )) < 0 ||
+         ( IoWake = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC )) < 0 )
+        return FALSE;
+
+    ev.events = EPOLLIN;
+    ev.data.u64 = 0;                    /* task handles are never 0 */
+    if ( epoll_ctl( IoEpoll, EPOLL_CTL_ADD, IoWake, &ev ) != 0 )
+        return FALSE;
+
+    IoStopping = FALSE;
+    if ( (errno = pthread_create( &IoThread, NULL, TskIoLoop, NULL )) != 0 )
+        return FALSE;
+
+    VclPtIoWait = TskIoWait;            /* stdio & sleeps suspend the task */
+    return TRUE;
+} /* TskIoStart */
+
+
+/*
+ * Stop the I/O loop
+ *
+ * Tasks still waiting stay blocked
+ *----------------------------------*/
+static void
+TskIoStop (void)
+{
+    VclPtIoWait = NULL;
+    if ( IoWaits == NULL )
+        return;
+
+    pthread_mutex_lock( &IoLock );
+    IoStopping = TRUE;
+    pthread_mutex_unlock( &IoLock );
+    eventfd_write( IoWake, 1 );
+    pthread_join( IoThread, NULL );
+
+    close( IoWake );
+    close( IoEpoll );
+    free( IoWaits );
+    IoWake = -1;
+    IoEpoll = -1;
+    IoWaits = NULL;
+} /* TskIoStop */
+
+
+/*
+ * I/O loop thread
+ *
+ * Waits on epoll for the descriptors of all waiting tasks, with
+ * the nearest time limit as its timeout, and resumes each task
+ * whose descriptor is ready or whose time is up.
+ *----------------------------------------------------------------*/
+static void *
+TskIoLoop (void *arg)
+{
+    struct epoll_event  evs[IOEVENTS];
+    TskIoWait_t *       w;
+    eventfd_t           count;
+    long long           now;
+    int                 timeout;
+    int                 hTsk;
+    int                 n;
+    int                 i;
+
+    arg = arg;                          /* avoid 'not used' compiler warning */
+
+    for ( ;; )
+    {
+        /* resume the tasks whose time is up, find the next time limit */
+        pthread_mutex_lock( &IoLock );
+        if ( IoStopping )
+        {
+            pthread_mutex_unlock( &IoLock );
+            break;
+        }
+        now = TskNow();
+        timeout = -1;
+        for ( hTsk = 1; hTsk <= RunIni.maxTasks; ++hTsk )
+        {
+            w = &IoWaits[hTsk];
+            if ( ! w->armed || w->due < 0 )
+                continue;
+            if ( w->due <= now )
+            {
+                w->armed = FALSE;
+                w->timedout = TRUE;
+                TskResume( hTsk );
+            }
+            else if ( timeout < 0 || w->due - now < timeout )
+                timeout = (int) ( w->due - now );
+        }
+        pthread_mutex_unlock( &IoLock );
+
+        if ( ( n = epoll_wait( IoEpoll, evs, IOEVENTS, timeout )) < 0 )
+            continue;                   /* EINTR */
+
+        /* resume the tasks whose descriptors are ready */
+        pthread_mutex_lock( &IoLock );
+        for ( i = 0; i < n; ++i )
+        {
+            if ( evs[i].data.u64 == 0 )
+            {
+                eventfd_read( IoWake, &count );
+                continue;
+            }
+            hTsk = (int) ( evs[i].data.u64 & 0xFFFFFFFFU );
+            w = &IoWaits[hTsk];
+            if ( w->armed && w->seq == (unsigned) ( evs[i].data.u64 >> 32 ) )
+            {
+                w->armed = FALSE;
+                TskResume( hTsk );
+            }
+        }
+        pthread_mutex_unlock( &IoLock );
+    }
+    return NULL;
+} /* TskIoLoop */
+
+
+/*
+ * Milliseconds of the monotonic clock
+ *-------------------------------------*/
+static long long
+TskNow (void)
+{
+    struct timespec     ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (long long) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+} /* TskNow */
+#endif
+
+
+/*
+ * Open the task metrics dump
+ *
+ * Appends to RunIni.statsFile, if set, and starts the periodic dump
+ * if RunIni.statsEvery is set too
+ *-------------------------------------------------------------------*/
+static int
+TskStatsStart (void)
+{
+    if ( RunIni.statsFile == NULL || *RunIni.statsFile == '\0' )
+        return TRUE;
+    if ( ( StatsFp = fopen( RunIni.statsFile, "a" )) == NULL )
+        return FALSE;
+
+    if ( RunIni.statsEvery > 0 )
+    {
+        if ( (errno = pthread_create( &StatsThread, NULL, TskStatsLoop, NULL )) != 0 )
+            return FALSE;
+        StatsLooping = TRUE;
+    }
+    return TRUE;
+} /* TskStatsStart */
+
+
+/*
+ * Close the task metrics dump
+ *
+ * After the workers have stopped; a last line for each task which
+ * has not halted, i.e. one left blocked
+ *-----------------------------------------------------------------*/
+static void
+TskStatsStop (void)
+{
+    int         hTsk;
+
+    if ( StatsFp == NULL )
+        return;
+
+    pthread_mutex_lock( &TskLock );
+    StatsStopping = TRUE;
+    pthread_cond_signal( &StatsWake );
+    pthread_mutex_unlock( &TskLock );
+    if ( StatsLooping )
+        pthread_join( StatsThread, NULL );
+    StatsLooping = FALSE;
+
+    pthread_mutex_lock( &TskLock );
+    for ( hTsk = 1; hTskValid( hTsk ); ++hTsk )
+        if ( TskRunning( hTsk ) )
+            TskStatsPut( hTsk, "stop" );
+    fclose( StatsFp );
+    StatsFp = NULL;
+    StatsStopping = FALSE;
+    pthread_mutex_unlock( &TskLock );
+} /* TskStatsStop */
+
+
+/*
+ * Periodic dump
+ *
+ * Every RunIni.statsEvery seconds a line for each task which has
+ * started and not yet halted
+ *----------------------------------------------------------------*/
+static void *
+TskStatsLoop (void *arg)
+{
+    struct timespec     due;
+    int                 hTsk;
+
+    arg = arg;                          /* avoid 'not used' compiler warning */
+
+    pthread_mutex_lock( &TskLock );
+    clock_gettime( CLOCK_REALTIME, &due );
+    while ( ! StatsStopping )
+    {
+        due.tv_sec += RunIni.statsEvery;
+        while ( ! StatsStopping &&
+                pthread_cond_timedwait( &StatsWake, &TskLock, &due ) != ETIMEDOUT )
+            ;
+        if ( StatsStopping )
+            break;
+
+        for ( hTsk = 1; hTskValid( hTsk ); ++hTsk )
+            if ( TskRunning( hTsk ) && TskPtrTo( hTsk )->stats.start != 0 )
+                TskStatsPut( hTsk, "run" );
+        fflush( StatsFp );
+    }
+    pthread_mutex_unlock( &TskLock );
+
+    return NULL;
+} /* TskStatsLoop */
+
+
+/*
+ * Get a task's metrics up to now, with TskLock held
+ *---------------------------------------------------*/
+static void
+TskStatsNow (int hTsk, TskStats_t *st)
+{
+    long long   now = TskMicros( CLOCK_MONOTONIC );
+
+    *st = TskPtrTo( hTsk )->stats;
+    if ( TskList[hTsk].state == TSK_HALTED || st->start == 0 )
+        return;
+
+    st->wall = now - st->start;
+    if ( TskList[hTsk].state == TSK_BLOCKED && TskGetHandle( hTsk ) )
+        st->blocked += now - TskGetHandle( hTsk )->blocked;
+} /* TskStatsNow */
+
+
+/*
+ * Write a task's line of the dump, with TskLock held
+ *
+ * event is "halt", "run" or "stop"; the interpreter's counts
+ * and the return value are only in the "halt" line
+ *------------------------------------------------------------*/
+static void
+TskStatsPut (int hTsk, const char *event)
+{
+    TskStats_t      st;
+    struct timespec ts;
+    int             state = TskList[hTsk].state;
+
+    if ( StatsFp == NULL )
+        return;
+    if ( state < TSK_FREE || state > TSK_UNKNOWN )
+        state = TSK_UNKNOWN;
+
+    TskStatsNow( hTsk, &st );
+    clock_gettime( CLOCK_REALTIME, &ts );
+
+    fprintf( StatsFp, "{\"event\":\"%s\",\"time\":%ld.%03ld,\"task\":%d,\"run\":%lu,"
+                      "\"state\":\"%s\",\"cmd\":",
+             event, (long) ts.tv_sec, (long) ( ts.tv_nsec / 1000000 ), hTsk,
+             st.run, StateNames[state] );
+    TskStatsStr( TskGetCmd( hTsk ) );
+    fprintf( StatsFp, ",\"wall_us\":%lld,\"cpu_us\":%lld,\"blocked_us\":%lld",
+             st.wall, st.cpu, st.blocked );
+    if ( state == TSK_HALTED )
+        fprintf( StatsFp, ",\"ret\":%d,\"yields\":%lu,\"statements\":%lu,"
+                          "\"data\":%ld,\"stack\":%ld,\"heap\":%ld,\"files\":%d",
+                 TskGetRetval( hTsk ), TskGetYields( hTsk ), st.statements,
+                 st.data, st.stack, st.heap, st.files );
+    fputs( "}\n", StatsFp );
+} /* TskStatsPut */
+
+
+/*
+ * Write a JSON string to the dump
+ *---------------------------------*/
+static void
+TskStatsStr (const char *s)
+{
+    putc( '"', StatsFp );
+    for ( ; s != NULL && *s; ++s )
+    {
+        if ( *s == '"' || *s == '\\' )
+            fprintf( StatsFp, "\\%c", *s );
+        else if ( (unsigned char) *s < ' ' )
+            fprintf( StatsFp, "\\u%04x", (unsigned char) *s );
+        else
+            putc( *s, StatsFp );
+    }
+    putc( '"', StatsFp );
+} /* TskStatsStr */
+
+
+/*
+ * Microseconds of a clock
+ *-------------------------*/
+static long long
+TskMicros (clockid_t clock)
+{
+    struct timespec     ts;
+
+    clock_gettime( clock, &ts );
+    return (long long) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+} /* TskMicros */
@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*pubMain*********************************************************************
+ NAME
+    vci-mapb.c - VAST Command Language parallel_map() benchmark main program
+
+ SYNOPSIS
+    vci-mapb [-n count] [-w work] [-r runs] [options] program[.VCC]
+
+ DESCRIPTION
+    Reports the speedup of parallel_map() on this host.  The program,
+    mapb.vcc or one with the same functions, is compiled and prepared
+    once with the spawn pool of vclspawn.cpp (see vclmapb.cpp).  Its
+    setup() makes count elements, then the plain loop of its serial()
+    and the parallel_map() of its parallel() are each timed runs times.
+    The fastest run of each and the speedup are printed:
+
+        100000 elements, work 20, fastest of 5 runs
+        serial     nnnnnn.nnn ms
+        parallel   nnnnnn.nnn ms on n processors
+        speedup        nnn.nn
+
+    The results of the two are then compared by the program's check().
+
+ OPTIONS
+    -n count            elements, default 100000
+    -w work             cost of an element, the sqrt() calls of
+                        mapb.vcc, default 20
+    -r runs             runs of each, default 5
+
+    Other options are the runtime options of vclRuntime().
+
+ ENVIRONMENT SYMBOLS
+
+ RETURN VALUE
+    0, or the error code, or 1 if the results differ.
+
+ FILES
+    mapb.vcc
+
+ SEE ALSO
+    vclmapb.cpp, vclspawn.cpp
+
+ NOTES
+    The pool has a thread for each processor online.  A smaller work
+    shows the cost of a call, which bounds the speedup of a cheap
+    function.
+
+ EXAMPLES
+    vci-mapb -q mapb.vcc
+    vci-mapb -n 1000000 -w 5 -q mapb.vcc
+
+ BUGS
+
+*********************************************************************pubMain*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <scdef.h>
+
+#include "tskmgmt.h"
+
+/* definitions */
+#define MAPBSTACK           262144      /* pool thread stack size */
+
+/* runtime .INI file parameters, the pool's stack only */
+RunIni_t        RunIni;
+
+/* prototypes */
+int             VclMapBench (int, char **, int, int, int);  /* in vclmapb.cpp */
+
+
+/*
+ * main entry point
+ *------------------*/
+int
+main (int argc, char **argv)
+{
+    int         count = 100000;
+    int         work = 20;
+    int         runs = 5;
+
+    /* host options, ahead of the runtime options */
+    while ( argc > 2 && argv[1][0] == '-' &&
+            ( argv[1][1] == 'n' || argv[1][1] == 'w' || argv[1][1] == 'r' ) &&
+            argv[1][2] == '\0' )
+    {
+        if ( argv[1][1] == 'n' )
+            count = atoi( argv[2] );
+        else if ( argv[1][1] == 'w' )
+            work = atoi( argv[2] );
+        else
+            runs = atoi( argv[2] );
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+    if ( count < 1 || work < 0 || runs < 1 )
+    {
+        fprintf( stderr, "usage: %s [-n count] [-w work] [-r runs] program\n", argv[0] );
+        return 1;
+    }
+
+    memset( &RunIni, 0, sizeof( RunIni ) );
+    RunIni.stack = MAPBSTACK;
+
+    return VclMapBench( argc, argv, count, work, runs );
+} /* main */
@@ -0,0 +1,520 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*pubMain*********************************************************************
+ NAME
+    vci-pipe.c - VAST Command Language in-process pipeline main program
+
+ SYNOPSIS
+    vci-pipe "command line" "command line" ...
+
+ DESCRIPTION
+    Runs VCL programs as the stages of a pipeline in one process, like
+    a shell pipeline of vci commands, each command line given as one
+    argument, as a vci-pt.ini Load entry.  The first stage reads the
+    process's stdin, the last writes its stdout, and the stdout of each
+    other stage is the stdin of the next.  All stages write the
+    process's stderr.
+
+    Each stage runs on a thread of its own, with the C++ encapsulated
+    VCL engine (see vclptin.cpp).  Between two stages is a ring buffer
+    in memory, read and written through stdio streams of its own, so
+    puts(), printf(), gets(), fgets() and the other stdio functions of
+    the programs pass data between the stages without a system call or
+    a process switch.  A stage waits only when the ring it reads is
+    empty, or the ring it writes is full.
+
+    A stage's stdout is closed when it returns, so the next stage sees
+    end of file.  If a stage returns before reading all its input, the
+    stage writing to it gets an error from its writes, as with EPIPE.
+
+    When the pipeline is done the throughput of each stage is reported
+    on stderr: its running time, the bytes and lines it wrote to the
+    next stage and the rate, and the times it waited on a full ring and
+    the next stage waited on an empty one.
+
+ OPTIONS
+
+ ENVIRONMENT SYMBOLS
+
+ RETURN VALUE
+    The return value of the last stage, or the error code if the
+    pipeline could not be started.
+
+ FILES
+    vci-pipe.ini
+
+    [Main]
+    Ring=65536                  bytes of a ring between two stages
+    Report=1                    report the stages' throughput, 0 not
+
+    [Task]
+    Stack=262144                stage thread stack size
+    Budget=0                    loop iterations & calls between yields,
+                                0 for none
+
+ SEE ALSO
+    vci-srv.c, vclptin.cpp
+
+ NOTES
+    A byte is copied into the ring by the writing stage's stdio and out
+    of it by the reading stage's; there is no other copy.
+
+ EXAMPLES
+    vci-pipe "grep.vcc ERROR" "count.vcc" < access.log
+
+ BUGS
+
+*********************************************************************pubMain*/
+
+#define _GNU_SOURCE                     /* fopencookie() */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <pthread.h>
+
+#include <scdef.h>
+#include <sclib.h>
+#include <inifile.h>
+
+#include "tskmgmt.h"
+
+/* definitions */
+#define INIFILE             "vci-pipe.ini"
+#define PROGNAME            "VCI-PIPE"
+#define MINSTACK            65536       /* smallest thread stack */
+#define MINRING             4096        /* smallest ring */
+
+/* a ring buffer between two stages */
+typedef struct RING
+{
+    pthread_mutex_t lock;
+    pthread_cond_t  more;               /* data written, or writer closed */
+    pthread_cond_t  room;               /* data read, or reader closed */
+    char *          buf;
+    size_t          size;
+    size_t          head;               /* bytes read, ever */
+    size_t          tail;               /* bytes written, ever */
+    int             wclosed;            /* writing stage returned */
+    int             rclosed;            /* reading stage returned */
+    ulong           lines;              /* '\n' written */
+    ulong           fullwaits;          /* writer waited for room */
+    ulong           emptywaits;         /* reader waited for data */
+} Ring_t;
+
+/* a stage of the pipeline */
+typedef struct STAGE
+{
+    char *          cmd;                /* command line */
+    FILE *          in;                 /* stdin, NULL for the process's */
+    FILE *          out;                /* stdout, NULL for the process's */
+    Ring_t *        ring;               /* ring to the next stage, or NULL */
+    pthread_t       thread;
+    double          secs;               /* running time */
+    int             ret;                /* return value */
+} Stage_t;
+
+/* runtime .INI file parameters */
+RunIni_t        RunIni;
+
+/* globals */
+char *          arg0;
+size_t          RingSize;
+int             Report;
+
+/* externals */
+struct _vclstats;                       /* VCLSTATS, see vcl.h */
+int             VclPtRun (char *, FILE *, FILE *, FILE *, struct _vclstats *);    /* in vclptin.cpp */
+void            VclPtFlush (void);      /* in vclptin.cpp */
+
+/* prototypes */
+int             runtimeINI (void);
+void *          StageRun (void *);
+Ring_t *        RingOpen (FILE **, FILE **);
+void            RingFree (Ring_t *);
+ssize_t         RingRead (void *, char *, size_t);
+ssize_t         RingWrite (void *, const char *, size_t);
+int             RingCloseR (void *);
+int             RingCloseW (void *);
+double          Now (void);
+
+static cookie_io_functions_t RingReader = { RingRead, NULL, NULL, RingCloseR };
+static cookie_io_functions_t RingWriter = { NULL, RingWrite, NULL, RingCloseW };
+
+
+/*
+ * main entry point
+ *------------------*/
+int
+main (int argc, char **argv)
+{
+    Stage_t *       stages;
+    pthread_attr_t  attr;
+    size_t          stack;
+    int             n = argc - 1;
+    int             ret = 0;
+    int             i;
+
+    arg0 = argv[0];                     /* global for first argument */
+
+    if ( n < 1 )
+    {
+        fprintf( stderr, "usage: %s \"command line\" ...\n", arg0 );
+        return EINVAL;
+    }
+    runtimeINI();
+
+    if ( ( stages = (Stage_t *) calloc( n, sizeof( Stage_t ) )) == NULL )
+        return ENOMEM;
+
+    /*
+     * the stages & the rings between them
+     */
+    for ( i = 0; i < n; ++i )
+    {
+        stages[i].cmd = argv[i + 1];
+        if ( i < n - 1 &&
+             ( stages[i].ring = RingOpen( &stages[i].out, &stages[i + 1].in )) == NULL )
+        {
+            perror( PROGNAME );
+            ret = errno;
+            n = i + 1;                  /* free what was opened */
+            break;
+        }
+    }
+
+    /*
+     * run them, each on its thread
+     */
+    if ( ret == 0 )
+    {
+        /* the interpreter recurses on the C stack, don't go below a minimum */
+        stack = RunIni.stack;
+        if ( stack < MINSTACK )
+            stack = MINSTACK;
+        if ( stack < PTHREAD_STACK_MIN )
+            stack = PTHREAD_STACK_MIN;
+
+        pthread_attr_init( &attr );
+        pthread_attr_setstacksize( &attr, stack );
+        for ( i = 0; i < n; ++i )
+        {
+            if ( (errno = pthread_create( &stages[i].thread, &attr, StageRun,
+                                          &stages[i] )) != 0 )
+            {
+                /* the stages started see end of file or a write error */
+                perror( PROGNAME );
+                ret = errno;
+                stages[i].thread = 0;
+                if ( stages[i].in )
+                    fclose( stages[i].in );
+                if ( stages[i].out )
+                    fclose( stages[i].out );
+            }
+        }
+        pthread_attr_destroy( &attr );
+
+        for ( i = 0; i < n; ++i )
+        {
+            if ( stages[i].thread )
+                pthread_join( stages[i].thread, NULL );
+        }
+        if ( ret == 0 )
+            ret = stages[n - 1].ret;
+    }
+    else
+    {
+        for ( i = 0; i < n; ++i )
+        {
+            if ( stages[i].in )
+                fclose( stages[i].in );
+            if ( stages[i].out )
+                fclose( stages[i].out );
+        }
+    }
+
+    /*
+     * the stages' throughput
+     */
+    if ( Report )
+    {
+        fprintf( stderr, "%s: stage  ret     secs        bytes      lines     MB/s"
+                         "  full-waits empty-waits  command\n", PROGNAME );
+        for ( i = 0; i < n; ++i )
+        {
+            Ring_t *    r = stages[i].ring;
+
+            if ( r != NULL )
+                fprintf( stderr, "%s: %5d %4d %8.3f %12lu %10lu %8.1f %11lu %11lu  %s\n",
+                         PROGNAME, i, stages[i].ret, stages[i].secs,
+                         (ulong) r->tail, r->lines,
+                         stages[i].secs > 0 ? r->tail / stages[i].secs / 1e6 : 0.0,
+                         r->fullwaits, r->emptywaits, stages[i].cmd );
+            else
+                fprintf( stderr, "%s: %5d %4d %8.3f %12s %10s %8s %11s %11s  %s\n",
+                         PROGNAME, i, stages[i].ret, stages[i].secs,
+                         "-", "-", "-", "-", "-", stages[i].cmd );
+        }
+    }
+
+    for ( i = 0; i < n; ++i )
+        RingFree( stages[i].ring );
+    free( stages );
+
+    VclPtFlush();                       /* free the compiled programs */
+
+    return ret;
+} /* main */
+
+
+/*
+ * Stage thread
+ *
+ * Runs the stage's command line, then closes its
+ * ends of the rings for the stages either side
+ *------------------------------------------------*/
+void *
+StageRun (void *arg)
+{
+    Stage_t *   st = (Stage_t *) arg;
+    double      start = Now();
+
+    st->ret = VclPtRun( st->cmd, st->in, st->out, NULL, NULL );
+    st->secs = Now() - start;
+
+    if ( st->out )
+        fclose( st->out );
+    if ( st->in )
+        fclose( st->in );
+    return NULL;
+} /* StageRun */
+
+
+/*
+ * Open a ring, with a stream writing it & one reading it
+ *
+ * Returns the ring, or NULL with errno set
+ *--------------------------------------------------------*/
+Ring_t *
+RingOpen (FILE **wfp, FILE **rfp)
+{
+    Ring_t *    r;
+
+    if ( ( r = (Ring_t *) calloc( 1, sizeof( Ring_t ) )) == NULL ||
+         ( r->buf = (char *) malloc( RingSize )) == NULL )
+    {
+        free( r );
+        errno = ENOMEM;
+        return NULL;
+    }
+    r->size = RingSize;
+    pthread_mutex_init( &r->lock, NULL );
+    pthread_cond_init( &r->more, NULL );
+    pthread_cond_init( &r->room, NULL );
+
+    if ( ( *wfp = fopencookie( r, "w", RingWriter )) == NULL )
+    {
+        RingFree( r );
+        return NULL;
+    }
+    if ( ( *rfp = fopencookie( r, "r", RingReader )) == NULL )
+    {
+        fclose( *wfp );
+        *wfp = NULL;
+        RingFree( r );
+        return NULL;
+    }
+    return r;
+} /* RingOpen */
+
+
+/*
+ * Free a ring, once both its streams are closed
+ *-----------------------------------------------*/
+void
+RingFree (Ring_t *r)
+{
+    if ( r == NULL )
+        return;
+    pthread_cond_destroy( &r->room );
+    pthread_cond_destroy( &r->more );
+    pthread_mutex_destroy( &r->lock );
+    free( r->buf );
+    free( r );
+} /* RingFree */
+
+
+/*
+ * Read a ring, the reading stream's read function
+ *
+ * Waits for data.  Returns the bytes read, 0 at end of file
+ *-----------------------------------------------------------*/
+ssize_t
+RingRead (void *cookie, char *buf, size_t size)
+{
+    Ring_t *    r = (Ring_t *) cookie;
+    size_t      n;
+    size_t      at;
+
+    pthread_mutex_lock( &r->lock );
+    while ( r->tail == r->head && ! r->wclosed )
+    {
+        ++r->emptywaits;
+        pthread_cond_wait( &r->more, &r->lock );
+    }
+
+    /* up to the end of the buffer, the rest next time */
+    at = r->head % r->size;
+    n = r->tail - r->head;
+    if ( n > r->size - at )
+        n = r->size - at;
+    if ( n > size )
+        n = size;
+    memcpy( buf, r->buf + at, n );
+    r->head += n;
+
+    pthread_cond_signal( &r->room );
+    pthread_mutex_unlock( &r->lock );
+    return n;
+} /* RingRead */
+
+
+/*
+ * Write a ring, the writing stream's write function
+ *
+ * Waits for room.  Returns the bytes written, or 0 with errno EPIPE
+ * if the reading stage has returned; fopencookie() takes a negative
+ * return for a count
+ *--------------------------------------------------------------------*/
+ssize_t
+RingWrite (void *cookie, const char *buf, size_t size)
+{
+    Ring_t *    r = (Ring_t *) cookie;
+    size_t      done = 0;
+    size_t      n;
+    size_t      at;
+    const char * p;
+
+    pthread_mutex_lock( &r->lock );
+    while ( done < size )
+    {
+        while ( r->tail - r->head == r->size && ! r->rclosed )
+        {
+            ++r->fullwaits;
+            pthread_cond_wait( &r->room, &r->lock );
+        }
+        if ( r->rclosed )
+            break;
+
+        at = r->tail % r->size;
+        n = r->size - ( r->tail - r->head );
+        if ( n > r->size - at )
+            n = r->size - at;
+        if ( n > size - done )
+            n = size - done;
+        memcpy( r->buf + at, buf + done, n );
+        for ( p = buf + done; ( p = (const char *) memchr( p, '\n',
+                                    buf + done + n - p )) != NULL; ++p )
+            ++r->lines;
+        r->tail += n;
+        done += n;
+
+        pthread_cond_signal( &r->more );
+    }
+    pthread_mutex_unlock( &r->lock );
+
+    if ( done == 0 && size > 0 )
+    {
+        errno = EPIPE;
+        return 0;
+    }
+    return done;
+} /* RingWrite */
+
+
+/*
+ * Close the reading stream, the writer's writes then fail
+ *---------------------------------------------------------*/
+int
+RingCloseR (void *cookie)
+{
+    Ring_t *    r = (Ring_t *) cookie;
+
+    pthread_mutex_lock( &r->lock );
+    r->rclosed = TRUE;
+    pthread_cond_broadcast( &r->room );
+    pthread_mutex_unlock( &r->lock );
+    return 0;
+} /* RingCloseR */
+
+
+/*
+ * Close the writing stream, the reader then sees end of file
+ *------------------------------------------------------------*/
+int
+RingCloseW (void *cookie)
+{
+    Ring_t *    r = (Ring_t *) cookie;
+
+    pthread_mutex_lock( &r->lock );
+    r->wclosed = TRUE;
+    pthread_cond_broadcast( &r->more );
+    pthread_mutex_unlock( &r->lock );
+    return 0;
+} /* RingCloseW */
+
+
+/* monotonic seconds */
+double
+Now (void)
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+} /* Now */
+
+
+/*
+ * Read the .INI for runtime parameters
+ *--------------------------------------*/
+int
+runtimeINI (void)
+{
+    char *      sec;
+    int         n;
+
+    /* [Main] section */
+    sec = "Main";
+    n = iniReadInt( INIFILE, NULL, sec, NULL, "Ring", 65536 );
+    RingSize = n < MINRING ? MINRING : n;
+    Report = iniReadInt( INIFILE, NULL, sec, NULL, "Report", 1 );
+
+    /* [Task] section */
+    sec = "Task";
+    RunIni.stack = iniReadInt( INIFILE, NULL, sec, NULL, "Stack", 262144 );
+    RunIni.budget = iniReadInt( INIFILE, NULL, sec, NULL, "Budget", 0 );
+    RunIni.warm = 0;
+    RunIni.reload = 0;
+
+    return TRUE;
+} /* runtimeINI */
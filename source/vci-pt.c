@@ -0,0 +1,275 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*pubMain*********************************************************************
+ NAME
+    vci-pt.c - VAST Command Language Compiler and Interpreter main program
+
+ SYNOPSIS
+    vci-pt
+
+ DESCRIPTION
+    This is the main program for a POSIX threads, multi-threaded VCL
+    implementation using the C++ encapsulated VCL engine.  It is the
+    counterpart of the RT-Kernel vci-mt; the "Load" entries of the [Boot]
+    section of vci-pt.ini are run on a fixed pool of worker threads.
+    Each task is a coroutine, so there may be many more tasks than
+    workers; a task gives up its worker whenever its budget is used up.
+
+ OPTIONS
+
+ ENVIRONMENT SYMBOLS
+
+ RETURN VALUE
+
+ FILES
+    vci-pt.ini
+
+    [Main]
+    Priority=32         priority of the main task
+    MaxTasks=16         number of task slots, i.e. coroutines
+    Yield=10            milliseconds slept by TskYield()
+    Workers=0           worker threads, 0 for one per processor
+    Output=0            tasks' stdout: 0 shared, 1 a buffer per task,
+                        2 also in task order, 3 lines tagged with the
+                        task, see tskout.c
+    Stats=              file task metrics are appended to, as JSON
+                        lines, see tskpool.c; none if not set
+    StatsEvery=10       seconds between lines for the tasks under way,
+                        0 for a line only as each task halts
+
+    [Task]
+    Priority=32         task priority, relative to [Main] Priority
+    Stack=262144        task coroutine stack size
+    Warm=2              prepared instances kept for each program
+    Budget=100000       loop iterations & calls between yields, 0 for none
+    BoxSlots=2          slots of a channel opened with 0 slots
+    OutBuf=65536        task stdout written out in chunks of this size
+
+    [Boot]
+    Load=prog.vcc args  one entry for each task to run
+
+ SEE ALSO
+    vci-mt.c, tskpool.c, tskchan.c, tskout.c, vclptin.cpp
+
+ NOTES
+    The BoxSize key of [Task] is read for compatibility with vci-mt.ini.
+    Tasks exchange messages over named channels, see tskchan.c, instead
+    of per-task mailboxes.
+
+ EXAMPLES
+
+ BUGS
+
+*********************************************************************pubMain*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <scdef.h>
+#include <sclib.h>
+#include <inifile.h>
+
+#include "tskmgmt.h"
+
+/* definitions */
+#define BOOT                "Boot"
+#define INIFILE             "vci-pt.ini"
+#define PROGNAME            "VCI-PT"
+
+/* task management globals */
+TskMgmt_t *     TskList;                /* allocated array of structures */
+ulong           TskCount = 0L;          /* perpetual task-run count metrix */
+
+/* runtime .INI file parameters */
+RunIni_t        RunIni;
+
+/* globals */
+char *          arg0;
+int             GlobalReturnValue = 0;
+
+/* prototypes */
+void            terminate (int);        /* terminate execution of program */
+int             launch (char *);
+int             runtimeINI (void);
+
+
+/*
+ * main entry point
+ *------------------*/
+int
+main (int argc, char **argv)
+{
+
+    argc = argc;                        /* avoid 'not used' compiler warning */
+    arg0 = argv[0];                     /* global for first argument */
+
+    /*
+     * read the .INI for runtime parameters
+     */
+    if ( ! runtimeINI() )
+        terminate( errno );
+
+    /* allocate runtime task management array */
+    TskList = (TskMgmt_t *) calloc( 1, (RunIni.maxTasks + 1) * sizeof(TskMgmt_t) );
+    if ( TskList == NULL )
+        terminate( ENOMEM );
+
+    /*
+     * start the worker threads
+     */
+    if ( ! TskPoolStart() )
+        terminate( errno );
+
+    /*
+     * launch the [Boot] section, "Load" keywords of .INI file
+     */
+    if ( launch( NULL ) )
+    {
+        int     hTsk;
+        int     state;
+
+        /*-####
+         #
+         # Main Task loop
+         #
+         # Sleep until a task halts, reap it; done when none are left
+         #
+         #-####*/
+
+        while ( (hTsk = TskWait()) != 0 )
+        {
+            state = TskGetState( hTsk );
+
+            /* check exception states */
+            if ( state == TSK_DEADLOCKED || state == TSK_UNKNOWN )
+            {
+                fprintf( stderr,
+                    "\n*** *** *** ***\n%s TASK STATE !\n*** *** *** ***\n",
+                    (state == TSK_DEADLOCKED) ? "DEADLOCKED" : "UNKNOWN" );
+                break;
+            }
+
+            TskKill( hTsk );            /* free the halted task's slot */
+        }
+    }
+    else
+        fprintf( stderr, "\n*** *** *** ***\nLAUNCH FAILED !\n*** *** *** ***\n" );
+
+    terminate( ( GlobalReturnValue ) ? GlobalReturnValue : errno );
+
+    return 0;
+} /* main */
+
+
+/*
+ * Terminate program
+ *
+ * Perform orderly shutdown & exit with code
+ *-------------------------------------------*/
+void
+terminate (int errcode)
+{
+    /*
+     * Other shut-down code goes here
+     */
+
+    if ( TskList != NULL )              /* not before it is allocated */
+    {
+        TskPoolStop();                  /* wait for running tasks */
+        TskKillAll();                   /* kill/free all tasks */
+    }
+
+    if ( errcode )
+        fprintf( stderr, "%s: Error code %d\n", PROGNAME, errcode );
+    if ( errno )
+        perror( PROGNAME );
+
+    exit( errcode );
+} /* terminate */
+
+
+/*
+ * Launch the [Boot] via the worker pool
+ *
+ * Loads all tasks specified in the
+ * [Boot] section with "Load" keyword
+ *------------------------------------*/
+int
+launch (char *sub)
+{
+    char *      cmd;
+    int         i = 1;                  /* entry number is 1-based */
+    char        key[KEYSZ + 1];
+
+    while ( (cmd = iniReadAll( INIFILE, NULL, BOOT, sub, &i, key )) != NULL )
+    {
+        if ( ! stricmp( key, "Load" ) )
+        {
+            if ( ! TskExec( cmd ))
+            {
+                free( cmd );
+                return FALSE;
+            }
+        }
+        free( cmd );
+    }
+    return TRUE;
+} /* launch */
+
+
+/*
+ * Read the .INI for runtime parameters
+ *--------------------------------------*/
+int
+runtimeINI (void)
+{
+    char *      sec;
+    char *      val;
+    int         i = 1;                  /* entry number is 1-based */
+    char        key[KEYSZ + 1];
+
+    /* [Main] section */
+    sec = "Main";
+    while ( (val = iniReadAll( INIFILE, NULL, sec, NULL, &i, key )) != NULL )
+    {
+        if ( ! stricmp( key, "Stats" ) && RunIni.statsFile == NULL )
+            RunIni.statsFile = val;     /* kept for the run */
+        else
+            free( val );
+    }
+    RunIni.mainPriority = iniReadInt( INIFILE, NULL, sec, NULL, "Priority", 32 );
+    RunIni.maxTasks = iniReadInt( INIFILE, NULL, sec, NULL, "MaxTasks", 16 );
+    RunIni.yield = iniReadInt( INIFILE, NULL, sec, NULL, "Yield", 10 );
+    RunIni.workers = iniReadInt( INIFILE, NULL, sec, NULL, "Workers", 0 );
+    RunIni.output = iniReadInt( INIFILE, NULL, sec, NULL, "Output", TSKOUT_DIRECT );
+    RunIni.statsEvery = iniReadInt( INIFILE, NULL, sec, NULL, "StatsEvery", 10 );
+
+    /* [Task] section */
+    sec = "Task";
+    RunIni.boxSize = iniReadInt( INIFILE, NULL, sec, NULL, "BoxSize", 1024 );
+    RunIni.boxSlots = iniReadInt( INIFILE, NULL, sec, NULL, "BoxSlots", 2 );
+    RunIni.priority = iniReadInt( INIFILE, NULL, sec, NULL, "Priority", 32 );
+    RunIni.stack = iniReadInt( INIFILE, NULL, sec, NULL, "Stack", 262144 );
+    RunIni.warm = iniReadInt( INIFILE, NULL, sec, NULL, "Warm", 2 );
+    RunIni.budget = iniReadInt( INIFILE, NULL, sec, NULL, "Budget", 100000 );
+    RunIni.outBuf = iniReadInt( INIFILE, NULL, sec, NULL, "OutBuf", 65536 );
+    return TRUE;
+} /* runtimeINI */
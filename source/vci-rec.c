@@ -0,0 +1,274 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*pubMain*********************************************************************
+ NAME
+    vci-rec.c - VAST Command Language record streaming main program
+
+ SYNOPSIS
+    vci-rec [-e entry] [-f finish] [options] program[.VCC] [file ...]
+
+ DESCRIPTION
+    Runs a VCL program once per input record, awk style.  The program is
+    compiled and prepared once; then, for each line of the files named
+    after the program, or of stdin if there are none, its entry function
+    is called:
+
+        int process (char *rec, int len);
+
+    rec points into the read buffer, with the newline replaced by a
+    '\0', and len is the length of the record without it.  The program's
+    globals keep their values from record to record.  At end of input its
+    finish function, if it has one, is called:
+
+        int finish (void);
+
+    main() is not called.
+
+ OPTIONS
+    -e entry            name of the entry function, default process
+    -f finish           name of the finish function, default finish
+
+    Other options are the runtime options of vclRuntime().
+
+ ENVIRONMENT SYMBOLS
+
+ RETURN VALUE
+    The return value of finish(), 0 if there is none, or the error code.
+
+ FILES
+    vcl.h
+
+ SEE ALSO
+    vci.c
+
+ NOTES
+    An entry function returning a negative value ends the input.
+
+    A record longer than the read buffer grows the buffer.
+
+ EXAMPLES
+    vci-rec -q count.vcc access.log
+
+ BUGS
+
+*********************************************************************pubMain*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <scdef.h>
+
+#include "vcl.h"                        /* interface header for VCL */
+
+/* definitions */
+#define RECHOST             "VCI-REC"
+#define RECBUFSZ            65536       /* initial read buffer size */
+
+/* globals */
+VCLFUNC         Entry;                  /* per record function */
+char *          EntryName = "process";  /* its name */
+char *          RecBuf = NULL;          /* read buffer */
+int             RecBufSz = 0;           /* read buffer size */
+
+/* prototypes */
+int             ReadRecords (FILE *);
+int             CallError (char *);
+
+
+/*
+ * main entry point
+ *------------------*/
+int
+main (int argc, char **argv)
+{
+    char *      finish = "finish";
+    char **     svArgv;
+    int         cArgc;
+    int         nargs;
+    int         ret = 0;
+    int         i;
+    VCLPROG *   prog;
+    VCLFUNC     fin;
+    VCLVALUE    rv;
+
+    /* host options, ahead of the runtime options */
+    while ( argc > 2 && argv[1][0] == '-' &&
+            ( argv[1][1] == 'e' || argv[1][1] == 'f' ) && argv[1][2] == '\0' )
+    {
+        if ( argv[1][1] == 'e' )
+            EntryName = argv[2];
+        else
+            finish = argv[2];
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
+    /* compile from a copy of argv, the compiler shuffles it */
+    if ( ( svArgv = (char **) malloc( ( argc + 1 ) * sizeof( char * ) )) == NULL )
+        return 1;
+    memcpy( svArgv, argv, ( argc + 1 ) * sizeof( char * ) );
+
+    cArgc = argc;
+    prog = vclCompile( &cArgc, svArgv );
+    free( svArgv );
+    if ( prog == NULL )
+        return 1;
+    nargs = argc - cArgc;               /* runtime options & source */
+
+    vclPrepare( prog );
+
+    if ( ( Entry = vclFindFunction( EntryName )) == NULL )
+    {
+        fprintf( stderr, "%s: no function %s()\n", RECHOST, EntryName );
+        ret = 1;
+    }
+    else if ( ( RecBuf = (char *) malloc( RECBUFSZ )) == NULL )
+        ret = 1;
+    else
+    {
+        RecBufSz = RECBUFSZ;
+
+        /* the files after the program, or stdin */
+        if ( nargs + 1 >= argc )
+            ret = ReadRecords( stdin );
+        for ( i = nargs + 1; i < argc && ret == 0; i++ )
+        {
+            FILE *      fp;
+
+            if ( ( fp = fopen( argv[i], "r" )) == NULL )
+            {
+                perror( argv[i] );
+                ret = 1;
+                break;
+            }
+            ret = ReadRecords( fp );
+            fclose( fp );
+        }
+
+        /* end of input */
+        if ( ret <= 0 && ( fin = vclFindFunction( finish )) != NULL )
+        {
+            if ( vclCall( fin, 0, NULL, &rv ) != 0 )
+                ret = CallError( finish );
+            else
+                ret = ( rv.type == VCL_INT ) ? rv.v.i : 0;
+        }
+        else if ( ret < 0 )
+            ret = 0;                    /* input ended by the program */
+
+        free( RecBuf );
+    }
+
+    vclShutdown();
+    vclRelease( prog );
+
+    return ret;
+} /* main */
+
+
+/*
+ * Call the entry function for each record of a file
+ *
+ * Returns 0 at end of file, -1 if the entry function ended
+ * the input, or the error code
+ *-----------------------------------------------------------*/
+int
+ReadRecords (FILE *fp)
+{
+    VCLVALUE    args[2];
+    VCLVALUE    rv;
+    char *      rec;
+    char *      nl;
+    int         used = 0;               /* bytes in buffer */
+    int         n;
+    int         eof = FALSE;
+
+    args[0].type = VCL_PTR;
+    args[1].type = VCL_INT;
+
+    while ( ! eof || used )
+    {
+        /* fill the buffer, growing it for a long record */
+        if ( ! eof )
+        {
+            if ( used == RecBufSz - 1 )
+            {
+                char *  p = (char *) realloc( RecBuf, RecBufSz * 2 );
+
+                if ( p == NULL )
+                    return 1;
+                RecBuf = p;
+                RecBufSz *= 2;
+            }
+            n = fread( RecBuf + used, 1, RecBufSz - 1 - used, fp );
+            if ( n <= 0 )
+                eof = TRUE;
+            used += n > 0 ? n : 0;
+        }
+        RecBuf[used] = '\0';
+
+        /* pass each complete record, and the last one at EOF */
+        for ( rec = RecBuf; rec < RecBuf + used; rec = nl + 1 )
+        {
+            if ( ( nl = (char *) memchr( rec, '\n', RecBuf + used - rec )) == NULL )
+            {
+                if ( ! eof )
+                    break;
+                nl = RecBuf + used;
+            }
+            *nl = '\0';
+            n = (int) ( nl - rec );
+            if ( n && rec[n - 1] == '\r' )
+                rec[--n] = '\0';
+
+            args[0].v.p = rec;
+            args[1].v.i = n;
+            if ( vclCall( Entry, 2, args, &rv ) != 0 )
+                return CallError( EntryName );
+            if ( rv.type == VCL_INT && rv.v.i < 0 )
+                return -1;
+        }
+
+        /* keep the partial record */
+        used -= (int) ( rec - RecBuf );
+        if ( used > 0 )
+            memmove( RecBuf, rec, used );
+        else
+            used = 0;
+    }
+    return 0;
+} /* ReadRecords */
+
+
+/*
+ * Report a failed call
+ *
+ * Returns the error code
+ *------------------------*/
+int
+CallError (char *fname)
+{
+    VCLERROR *  e = vclLastError();
+
+    fprintf( stderr, "%s: %s() failed: %s %d: %s\n",
+             RECHOST, fname, e->file, e->line, e->message );
+    return e->code ? e->code : 1;
+} /* CallError */
@@ -0,0 +1,727 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*pubMain*********************************************************************
+ NAME
+    vci-shard.c - VAST Command Language sharded batch main program
+
+ SYNOPSIS
+    vci-shard [-n workers] [-r records] command line
+
+ DESCRIPTION
+    Runs one VCL command line over a large input by splitting the input
+    into shards and running the program once per shard, on a number of
+    worker processes at once.
+
+    The input is the lines of stdin; a shard is the next records lines
+    of it.  For a batch of files, give the file names one per line and
+    let the program open them.  Each shard is the stdin of one run of
+    the command line, given as a vci-pt.ini Load entry.
+
+    The workers are vci-srv servers (see vci-srv.c), started by
+    vci-shard, each on a socket of its own, or already running ones
+    named by Connect entries.  vci-shard has a thread for each, which
+    reads the next shard from stdin, sends it to its server as a request
+    and takes the reply, and repeats until the input ends.  The servers
+    keep the program compiled, so a shard costs a connection and not a
+    process start.  Shards are handed out as workers become free, so a
+    worker whose shards run fast takes more of them, and none waits on
+    a slow one while input is left.
+
+    The output of each run is written to stdout and stderr in the order
+    of the shards, as soon as the shards before it are done, so the
+    output is the same whatever the number of workers.
+
+    A worker which fails, or whose server goes away, gives its shard
+    back to the others and stops.  A shard given back [Task] Tries times
+    is not run again: it is reported as failed, with no output.
+
+ OPTIONS
+    -n workers          servers to start, default [Main] Workers
+    -r records          lines of a shard, default [Main] Records
+
+ ENVIRONMENT SYMBOLS
+
+ RETURN VALUE
+    0, the first non-zero exit code of a shard in input order, or the
+    error code if a shard could not be run (EIO for one which failed
+    Tries times).
+
+ FILES
+    vci-shard.ini
+
+    [Main]
+    Workers=4                   servers to start
+    Records=1000                lines of a shard
+    Server=vci-srv              server program to start
+    Socket=/tmp/vci-shard       prefix of the started servers' sockets
+    Connect=/tmp/vci-srv.sock   a running server to use instead, one
+                                entry for each
+
+    [Task]
+    Retry=50                    times 100ms to wait for a started server
+    Tries=3                     workers a shard may fail before it is
+                                reported as failed
+
+ SEE ALSO
+    vci-srv.c, vci-rec.c
+
+ NOTES
+    The started servers run in the current directory and read its
+    vci-srv.ini, apart from the socket.  They are stopped with SIGTERM
+    when the input is done.
+
+    A record is a line; lines are not split between shards.
+
+ EXAMPLES
+    Counting the words of a log a thousand lines a run, on 8 servers:
+
+        vci-shard -n 8 -r 1000 wc.vcc < access.log
+
+    Running a script once for each file:
+
+        find data -name '*.csv' | vci-shard -r 1 load.vcc
+
+ BUGS
+
+*********************************************************************pubMain*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include <scdef.h>
+#include <sclib.h>
+#include <inifile.h>
+
+/* definitions */
+#define INIFILE             "vci-shard.ini"
+#define PROGNAME            "VCI-SHARD"
+#define CMDSZ               4096        /* longest command line */
+#define MAXWORKERS          256
+
+/* a shard of the input */
+typedef struct SHARD
+{
+    int             seq;                /* shard number, from 0 */
+    int             tries;              /* workers which failed on it */
+    char *          buf;                /* its records */
+    size_t          len;
+    struct SHARD *  next;               /* next to retry */
+} Shard_t;
+
+/* a run's reply */
+typedef struct RESULT
+{
+    int             code;               /* exit code */
+    char *          out;                /* stdout bytes */
+    size_t          outlen;
+    char *          err;                /* stderr bytes */
+    size_t          errlen;
+} Result_t;
+
+/* a worker, a server & the thread feeding it */
+typedef struct WORKER
+{
+    char            sock[sizeof( ((struct sockaddr_un *) 0)->sun_path )];
+    pid_t           pid;                /* started server, 0 if connected */
+    pthread_t       thread;
+} Worker_t;
+
+/* globals */
+char *          arg0;
+char            Cmd[CMDSZ + 1];         /* command line of each run */
+char            Server[CMDSZ + 1];      /* server program */
+char            SockPrefix[80];         /* started servers' sockets */
+int             Records;                /* lines of a shard */
+int             Retry;                  /* 100ms waits for a server */
+int             Tries;                  /* failures before a shard fails */
+Worker_t        Workers[MAXWORKERS];
+int             NWorkers = 0;
+pthread_mutex_t ShardLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t  ShardDone = PTHREAD_COND_INITIALIZER;
+int             InputDone = FALSE;      /* stdin at EOF */
+pthread_mutex_t InputLock = PTHREAD_MUTEX_INITIALIZER;
+int             NextSeq = 0;            /* next shard read from stdin */
+int             InputEof = FALSE;       /* InputDone, for the reader */
+int             Running = 0;            /* shards taken & not done */
+Shard_t *       Retries = NULL;         /* shards given back by a worker */
+pthread_mutex_t OutLock = PTHREAD_MUTEX_INITIALIZER;
+Result_t **     Results = NULL;         /* replies not written yet */
+int             MaxResults = 0;
+int             NextOut = 0;            /* next shard to write */
+int             ExitCode = 0;
+
+/* prototypes */
+int             runtimeINI (void);
+int             StartServer (Worker_t *, int);
+void *          ShardWorker (void *);
+Shard_t *       NextShard (void);
+Shard_t *       ReadShard (void);
+void            EndShard (Shard_t *);
+int             RunShard (Worker_t *, Shard_t *, Result_t *);
+void            PutResult (int, Result_t *);
+int             Connect (Worker_t *);
+int             ReadLine (int, char *, int);
+int             ReadAll (int, char *, size_t);
+int             WriteAll (int, char *, size_t);
+
+
+/*
+ * main entry point
+ *------------------*/
+int
+main (int argc, char **argv)
+{
+    int         started;
+    int         i;
+
+    arg0 = argv[0];                     /* global for first argument */
+
+    if ( ! runtimeINI() )
+        return errno;
+
+    /* host options, ahead of the command line */
+    started = NWorkers ? 0 : iniReadInt( INIFILE, NULL, "Main", NULL, "Workers", 4 );
+    while ( argc > 2 && argv[1][0] == '-' &&
+            ( argv[1][1] == 'n' || argv[1][1] == 'r' ) && argv[1][2] == '\0' )
+    {
+        if ( argv[1][1] == 'n' )
+            started = atoi( argv[2] );
+        else
+            Records = atoi( argv[2] );
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+    if ( argc < 2 )
+    {
+        fprintf( stderr, "usage: %s [-n workers] [-r records] command line\n", arg0 );
+        return EINVAL;
+    }
+    if ( Records < 1 )
+        Records = 1;
+
+    /* the command line of each run */
+    for ( i = 1; i < argc; ++i )
+    {
+        if ( strlen( Cmd ) + strlen( argv[i] ) + 2 > sizeof( Cmd ) )
+        {
+            fprintf( stderr, "%s: command line too long\n", PROGNAME );
+            return E2BIG;
+        }
+        if ( i > 1 )
+            strcat( Cmd, " " );
+        strcat( Cmd, argv[i] );
+    }
+
+    /* a server going away must not kill the coordinator */
+    signal( SIGPIPE, SIG_IGN );
+
+    /*
+     * start the servers, and a thread for each server
+     */
+    for ( i = 0; i < started && NWorkers < MAXWORKERS; ++i )
+    {
+        if ( ! StartServer( &Workers[NWorkers], i ) )
+        {
+            perror( Server );
+            break;
+        }
+        ++NWorkers;
+    }
+
+    for ( i = 0; i < NWorkers; ++i )
+    {
+        if ( (errno = pthread_create( &Workers[i].thread, NULL, ShardWorker,
+                                      &Workers[i] )) != 0 )
+        {
+            perror( PROGNAME );
+            Workers[i].thread = 0;
+        }
+    }
+
+    for ( i = 0; i < NWorkers; ++i )
+    {
+        if ( Workers[i].thread )
+            pthread_join( Workers[i].thread, NULL );
+    }
+
+    /* stop the servers started */
+    for ( i = 0; i < NWorkers; ++i )
+    {
+        if ( Workers[i].pid > 0 )
+        {
+            kill( Workers[i].pid, SIGTERM );
+            waitpid( Workers[i].pid, NULL, 0 );
+            unlink( Workers[i].sock );  /* if it died without */
+        }
+    }
+
+    /* shards left when every worker had failed */
+    if ( Retries != NULL || ! InputDone )
+    {
+        fprintf( stderr, "%s: no worker left to run shard %d\n", PROGNAME,
+                 Retries ? Retries->seq : NextSeq );
+        if ( ExitCode == 0 )
+            ExitCode = EIO;
+    }
+
+    return ExitCode;
+} /* main */
+
+
+/*
+ * Start a server on a socket of its own
+ *
+ * Returns FALSE if it could not be started
+ *---------------------------------------*/
+int
+StartServer (Worker_t *w, int n)
+{
+    snprintf( w->sock, sizeof( w->sock ), "%s.%d.%d", SockPrefix, (int) getpid(), n );
+    unlink( w->sock );
+
+    if ( ( w->pid = fork()) < 0 )
+        return FALSE;
+    if ( w->pid == 0 )
+    {
+        execlp( Server, Server, w->sock, (char *) NULL );
+        perror( Server );
+        _exit( 127 );
+    }
+    return TRUE;
+} /* StartServer */
+
+
+/*
+ * Worker thread
+ *
+ * Runs shards on its server until the input is done, or
+ * gives its shard back and stops if the server fails
+ *-------------------------------------------------------*/
+void *
+ShardWorker (void *arg)
+{
+    Worker_t *  w = (Worker_t *) arg;
+    Shard_t *   shard;
+    Result_t *  res;
+
+    while ( ( shard = NextShard()) != NULL )
+    {
+        if ( ( res = (Result_t *) calloc( 1, sizeof( Result_t ) )) == NULL ||
+             ! RunShard( w, shard, res ) )
+        {
+            free( res );
+            fprintf( stderr, "%s: worker %s failed, shard %d given back\n",
+                     PROGNAME, w->sock, shard->seq );
+            EndShard( shard );
+            return NULL;
+        }
+        PutResult( shard->seq, res );
+        free( shard->buf );
+        free( shard );
+        EndShard( NULL );
+    }
+    return NULL;
+} /* ShardWorker */
+
+
+/*
+ * Take the next shard, one given back or the next lines of stdin
+ *
+ * Waits while the input is done but shards are still running, one
+ * may be given back.  Returns NULL when all are done
+ *----------------------------------------------------------------*/
+Shard_t *
+NextShard (void)
+{
+    Shard_t *   shard;
+    int         done;
+
+    for ( ;; )
+    {
+        pthread_mutex_lock( &ShardLock );
+        while ( Retries == NULL && InputDone && Running > 0 )
+            pthread_cond_wait( &ShardDone, &ShardLock );
+
+        if ( ( shard = Retries ) != NULL )
+            Retries = shard->next;
+        done = InputDone;
+        if ( shard != NULL || ! done )
+            ++Running;                  /* a shard given back or read */
+        pthread_mutex_unlock( &ShardLock );
+
+        if ( shard != NULL )
+            return shard;
+        if ( done )
+            return NULL;
+
+        /* read without ShardLock, the others may give shards back */
+        if ( ( shard = ReadShard()) != NULL )
+            return shard;
+        EndShard( NULL );               /* nothing read, wait for the rest */
+    }
+} /* NextShard */
+
+
+/*
+ * Read the next shard of stdin, one reader at a time
+ *
+ * Sets InputDone at the end of the input.  Returns NULL if it
+ * has no records
+ *-------------------------------------------------------------*/
+Shard_t *
+ReadShard (void)
+{
+    Shard_t *   shard = NULL;
+    char *      line = NULL;
+    size_t      linesz = 0;
+    size_t      max = 0;
+    ssize_t     n;
+    int         i;
+
+    pthread_mutex_lock( &InputLock );
+    if ( ! InputEof && ( shard = (Shard_t *) calloc( 1, sizeof( Shard_t ) )) != NULL )
+    {
+        for ( i = 0; i < Records && ( n = getline( &line, &linesz, stdin )) > 0; ++i )
+        {
+            if ( shard->len + n > max )
+            {
+                char *  buf;
+
+                max = ( shard->len + n ) * 2;
+                if ( ( buf = (char *) realloc( shard->buf, max )) == NULL )
+                    break;
+                shard->buf = buf;
+            }
+            memcpy( shard->buf + shard->len, line, n );
+            shard->len += n;
+        }
+        free( line );
+
+        if ( i < Records )
+            InputEof = TRUE;
+        if ( shard->len == 0 )
+        {
+            free( shard->buf );
+            free( shard );
+            shard = NULL;
+        }
+        else
+            shard->seq = NextSeq++;     /* in input order */
+    }
+    if ( InputEof )
+    {
+        pthread_mutex_lock( &ShardLock );
+        InputDone = TRUE;
+        pthread_mutex_unlock( &ShardLock );
+    }
+    pthread_mutex_unlock( &InputLock );
+
+    return shard;
+} /* ReadShard */
+
+
+/*
+ * End a shard taken by NextShard(), giving it back if not NULL
+ *
+ * A shard given back Tries times fails, with an empty result.
+ *--------------------------------------------------------------*/
+void
+EndShard (Shard_t *shard)
+{
+    Result_t *  res;
+
+    if ( shard != NULL && ++shard->tries >= Tries )
+    {
+        fprintf( stderr, "%s: shard %d failed on %d workers\n", PROGNAME,
+                 shard->seq, shard->tries );
+        if ( ( res = (Result_t *) calloc( 1, sizeof( Result_t ) )) != NULL )
+        {
+            res->code = EIO;
+            PutResult( shard->seq, res );
+        }
+        free( shard->buf );
+        free( shard );
+        shard = NULL;
+    }
+
+    pthread_mutex_lock( &ShardLock );
+    if ( shard != NULL )
+    {
+        shard->next = Retries;
+        Retries = shard;
+    }
+    --Running;
+    pthread_cond_broadcast( &ShardDone );
+    pthread_mutex_unlock( &ShardLock );
+} /* EndShard */
+
+
+/*
+ * Run a shard on a worker's server
+ *
+ * Sends the command line & the shard as stdin, and reads the
+ * exit code & output.  Returns FALSE if the server failed
+ *------------------------------------------------------------*/
+int
+RunShard (Worker_t *w, Shard_t *shard, Result_t *res)
+{
+    char        hdr[64];
+    ulong       outlen;
+    ulong       errlen;
+    int         fd;
+    int         ok = FALSE;
+
+    if ( ( fd = Connect( w )) < 0 )
+        return FALSE;
+
+    sprintf( hdr, "%lu\n", (ulong) shard->len );
+    if ( WriteAll( fd, Cmd, strlen( Cmd ) ) && WriteAll( fd, "\n", 1 ) &&
+         WriteAll( fd, hdr, strlen( hdr ) ) && WriteAll( fd, shard->buf, shard->len ) &&
+         ReadLine( fd, hdr, sizeof( hdr ) ) &&
+         sscanf( hdr, "%d %lu %lu", &res->code, &outlen, &errlen ) == 3 &&
+         ( res->out = (char *) malloc( outlen + 1 )) != NULL &&
+         ( res->err = (char *) malloc( errlen + 1 )) != NULL &&
+         ReadAll( fd, res->out, outlen ) && ReadAll( fd, res->err, errlen ) )
+    {
+        res->outlen = outlen;
+        res->errlen = errlen;
+        ok = TRUE;
+    }
+    close( fd );
+
+    if ( ! ok )
+    {
+        free( res->out );
+        free( res->err );
+        res->out = res->err = NULL;
+    }
+    return ok;
+} /* RunShard */
+
+
+/*
+ * Keep a shard's reply, and write those now in order
+ *----------------------------------------------------*/
+void
+PutResult (int seq, Result_t *res)
+{
+    pthread_mutex_lock( &OutLock );
+    if ( seq >= MaxResults )
+    {
+        Result_t ** r;
+        int         max = ( seq + 1 ) * 2;
+
+        if ( ( r = (Result_t **) realloc( Results, max * sizeof( Result_t * ) )) == NULL )
+        {
+            pthread_mutex_unlock( &OutLock );
+            fprintf( stderr, "%s: no memory for the output of shard %d\n", PROGNAME, seq );
+            free( res->out );
+            free( res->err );
+            free( res );
+            return;
+        }
+        memset( r + MaxResults, 0, ( max - MaxResults ) * sizeof( Result_t * ) );
+        Results = r;
+        MaxResults = max;
+    }
+    Results[seq] = res;
+
+    while ( NextOut < MaxResults && ( res = Results[NextOut] ) != NULL )
+    {
+        fwrite( res->out, 1, res->outlen, stdout );
+        fwrite( res->err, 1, res->errlen, stderr );
+        if ( res->code != 0 && ExitCode == 0 )
+        {
+            fprintf( stderr, "%s: shard %d exited %d\n", PROGNAME, NextOut, res->code );
+            ExitCode = res->code;
+        }
+        free( res->out );
+        free( res->err );
+        free( res );
+        Results[NextOut++] = NULL;
+    }
+    fflush( stdout );
+    fflush( stderr );
+    pthread_mutex_unlock( &OutLock );
+} /* PutResult */
+
+
+/*
+ * Connect to a worker's server
+ *
+ * Waits for a started server to listen.  Returns the socket, or -1
+ *------------------------------------------------------------------*/
+int
+Connect (Worker_t *w)
+{
+    struct sockaddr_un  addr;
+    int         fd;
+    int         i;
+
+    memset( &addr, 0, sizeof( addr ) );
+    addr.sun_family = AF_UNIX;
+    strcpy( addr.sun_path, w->sock );
+
+    for ( i = 0; ; ++i )
+    {
+        if ( ( fd = socket( AF_UNIX, SOCK_STREAM, 0 )) < 0 )
+            return -1;
+        if ( connect( fd, (struct sockaddr *) &addr, sizeof( addr ) ) == 0 )
+            return fd;
+        close( fd );
+
+        /* a started server may not be listening yet */
+        if ( w->pid == 0 || i >= Retry || waitpid( w->pid, NULL, WNOHANG ) != 0 )
+            return -1;
+        usleep( 100000 );
+    }
+} /* Connect */
+
+
+/*
+ * Read a '\n' terminated line, without the '\n'
+ *
+ * Returns FALSE at EOF, on error or if the line is too long
+ *-----------------------------------------------------------*/
+int
+ReadLine (int fd, char *buf, int size)
+{
+    int         i;
+
+    for ( i = 0; i < size - 1; ++i )
+    {
+        if ( read( fd, buf + i, 1 ) != 1 )
+            return FALSE;
+        if ( buf[i] == '\n' )
+        {
+            buf[i] = '\0';
+            return TRUE;
+        }
+    }
+    return FALSE;
+} /* ReadLine */
+
+
+/*
+ * Read len bytes
+ *----------------*/
+int
+ReadAll (int fd, char *buf, size_t len)
+{
+    ssize_t     n;
+
+    while ( len )
+    {
+        if ( ( n = read( fd, buf, len )) <= 0 )
+        {
+            if ( n < 0 && errno == EINTR )
+                continue;
+            return FALSE;
+        }
+        buf += n;
+        len -= n;
+    }
+    return TRUE;
+} /* ReadAll */
+
+
+/*
+ * Write len bytes
+ *-----------------*/
+int
+WriteAll (int fd, char *buf, size_t len)
+{
+    ssize_t     n;
+
+    while ( len )
+    {
+        if ( ( n = write( fd, buf, len )) < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+            return FALSE;
+        }
+        buf += n;
+        len -= n;
+    }
+    return TRUE;
+} /* WriteAll */
+
+
+/*
+ * Read the .INI for runtime parameters
+ *
+ * Connect entries make the workers, the servers are then not started
+ *--------------------------------------------------------------------*/
+int
+runtimeINI (void)
+{
+    char *      sec;
+    char *      val;
+    int         i = 1;                  /* entry number is 1-based */
+    char        key[KEYSZ + 1];
+
+    /* [Main] section */
+    sec = "Main";
+    strcpy( Server, "vci-srv" );
+    strcpy( SockPrefix, "/tmp/vci-shard" );
+    while ( (val = iniReadAll( INIFILE, NULL, sec, NULL, &i, key )) != NULL )
+    {
+        if ( ! stricmp( key, "Server" ) )
+        {
+            strncpy( Server, val, sizeof( Server ) - 1 );
+            Server[sizeof( Server ) - 1] = '\0';
+        }
+        else if ( ! stricmp( key, "Socket" ) )
+        {
+            strncpy( SockPrefix, val, sizeof( SockPrefix ) - 1 );
+            SockPrefix[sizeof( SockPrefix ) - 1] = '\0';
+        }
+        else if ( ! stricmp( key, "Connect" ) && NWorkers < MAXWORKERS )
+        {
+            if ( strlen( val ) >= sizeof( Workers[0].sock ) )
+            {
+                free( val );
+                errno = ENAMETOOLONG;
+                return FALSE;
+            }
+            strcpy( Workers[NWorkers++].sock, val );
+        }
+        free( val );
+    }
+    Records = iniReadInt( INIFILE, NULL, sec, NULL, "Records", 1000 );
+
+    /* [Task] section */
+    sec = "Task";
+    Retry = iniReadInt( INIFILE, NULL, sec, NULL, "Retry", 50 );
+    if ( ( Tries = iniReadInt( INIFILE, NULL, sec, NULL, "Tries", 3 )) < 1 )
+        Tries = 1;
+
+    return TRUE;
+} /* runtimeINI */
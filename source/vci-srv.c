@@ -0,0 +1,433 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*pubMain*********************************************************************
+ NAME
+    vci-srv.c - VAST Command Language script server main program
+
+ SYNOPSIS
+    vci-srv [socket]
+
+ DESCRIPTION
+    This is the main program for a long-running VCL server using the
+    C++ encapsulated VCL engine.  It listens on a Unix domain socket and
+    runs one VCL command line for each connection.  Programs are compiled
+    by the first request to run them and kept, with warm instances, for
+    the life of the server (see vclptin.cpp), so a request costs neither
+    a process start nor a compile and link.  A program whose source is
+    edited is compiled again and swapped in without a restart.
+
+    A request is:
+
+        command line '\n'               as a vci-pt.ini Load entry
+        stdin length '\n'               decimal
+        stdin bytes
+
+    and the reply:
+
+        exit-code stdout-length stderr-length '\n'
+        stdout bytes
+        stderr bytes
+
+    after which the server closes the connection.  The program's stdin,
+    stdout and stderr are the request's bytes and the captured output.
+
+    The server runs until SIGINT or SIGTERM.
+
+ OPTIONS
+    socket              socket path, default [Main] Socket
+
+ ENVIRONMENT SYMBOLS
+
+ RETURN VALUE
+    0, or the error code if the server could not be started.
+
+ FILES
+    vci-srv.ini
+
+    [Main]
+    Socket=/tmp/vci-srv.sock    socket path
+    Workers=4                   requests run at once
+    Backlog=64                  connections waiting to be served
+
+    [Task]
+    Stack=262144                connection thread stack size
+    Warm=2                      prepared instances kept for each program
+    Reload=2                    seconds between checks for changed
+                                source, 0 for none
+    Budget=100000               loop iterations & calls between yields,
+                                0 for none
+
+ SEE ALSO
+    vci-pt.c, vclptin.cpp
+
+ NOTES
+    Messages of the compiler and interpreter, such as compile errors, go
+    to the server's stdout, not to the request's.
+
+ EXAMPLES
+
+ BUGS
+
+*********************************************************************pubMain*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <scdef.h>
+#include <sclib.h>
+#include <inifile.h>
+
+#include "tskmgmt.h"
+
+/* definitions */
+#define INIFILE             "vci-srv.ini"
+#define PROGNAME            "VCI-SRV"
+#define CMDSZ               4096        /* longest command line */
+#define MINSTACK            65536       /* smallest thread stack */
+
+/* runtime .INI file parameters */
+RunIni_t        RunIni;
+
+/* globals */
+char *          arg0;
+char            SockPath[sizeof( ((struct sockaddr_un *) 0)->sun_path )];
+int             Backlog;
+int             ListenFd = -1;
+
+/* externals */
+struct _vclstats;                       /* VCLSTATS, see vcl.h */
+int             VclPtRun (char *, FILE *, FILE *, FILE *, struct _vclstats *);    /* in vclptin.cpp */
+void            VclPtFlush (void);      /* in vclptin.cpp */
+
+/* prototypes */
+int             runtimeINI (char *);
+void *          SrvWorker (void *);
+void            SrvRequest (int);
+int             ReadLine (int, char *, int);
+int             ReadAll (int, char *, size_t);
+int             WriteAll (int, char *, size_t);
+
+
+/*
+ * main entry point
+ *------------------*/
+int
+main (int argc, char **argv)
+{
+    struct sockaddr_un  addr;
+    pthread_t *     workers;
+    pthread_attr_t  attr;
+    sigset_t        sigs;
+    size_t          stack;
+    int             sig;
+    int             n;
+    int             i;
+
+    arg0 = argv[0];                     /* global for first argument */
+
+    if ( ! runtimeINI( argc > 1 ? argv[1] : NULL ) )
+        return errno;
+
+    /* a client going away must not kill the server */
+    signal( SIGPIPE, SIG_IGN );
+
+    /* SIGINT & SIGTERM are taken by sigwait() below, block them everywhere */
+    sigemptyset( &sigs );
+    sigaddset( &sigs, SIGINT );
+    sigaddset( &sigs, SIGTERM );
+    pthread_sigmask( SIG_BLOCK, &sigs, NULL );
+
+    /*
+     * listen on the socket
+     */
+    memset( &addr, 0, sizeof( addr ) );
+    addr.sun_family = AF_UNIX;
+    strcpy( addr.sun_path, SockPath );
+    unlink( SockPath );
+    if ( ( ListenFd = socket( AF_UNIX, SOCK_STREAM, 0 )) < 0 ||
+         bind( ListenFd, (struct sockaddr *) &addr, sizeof( addr ) ) < 0 ||
+         listen( ListenFd, Backlog ) < 0 )
+    {
+        perror( SockPath );
+        return errno;
+    }
+
+    /*
+     * start the connection threads, each serves one request at a time
+     */
+    n = RunIni.workers > 0 ? RunIni.workers : 1;
+    if ( ( workers = (pthread_t *) calloc( n, sizeof( pthread_t ) )) == NULL )
+        return ENOMEM;
+
+    /* the interpreter recurses on the C stack, don't go below a minimum */
+    stack = RunIni.stack;
+    if ( stack < MINSTACK )
+        stack = MINSTACK;
+    if ( stack < PTHREAD_STACK_MIN )
+        stack = PTHREAD_STACK_MIN;
+
+    pthread_attr_init( &attr );
+    pthread_attr_setstacksize( &attr, stack );
+    for ( i = 0; i < n; ++i )
+    {
+        if ( (errno = pthread_create( &workers[i], &attr, SrvWorker, NULL )) != 0 )
+        {
+            perror( PROGNAME );
+            n = i;
+            break;
+        }
+    }
+    pthread_attr_destroy( &attr );
+
+    /*
+     * run until told to stop
+     */
+    if ( n > 0 )
+        sigwait( &sigs, &sig );
+
+    /* wake the threads out of accept() & let the requests finish */
+    shutdown( ListenFd, SHUT_RDWR );
+    for ( i = 0; i < n; ++i )
+        pthread_join( workers[i], NULL );
+
+    close( ListenFd );
+    unlink( SockPath );
+    free( workers );
+
+    VclPtFlush();                       /* free the compiled programs */
+
+    return 0;
+} /* main */
+
+
+/*
+ * Connection thread
+ *
+ * Accepts connections and serves their requests until
+ * the listening socket is shut down
+ *------------------------------------------------------*/
+void *
+SrvWorker (void *arg)
+{
+    int         fd;
+
+    arg = arg;                          /* avoid 'not used' compiler warning */
+
+    for ( ;; )
+    {
+        if ( ( fd = accept( ListenFd, NULL, NULL )) < 0 )
+        {
+            if ( errno == EINTR || errno == ECONNABORTED )
+                continue;
+            break;                      /* shut down */
+        }
+        SrvRequest( fd );
+        close( fd );
+    }
+    return NULL;
+} /* SrvWorker */
+
+
+/*
+ * Serve one request
+ *
+ * Reads the command line & stdin, runs the program with its
+ * output captured and writes the reply
+ *-----------------------------------------------------------*/
+void
+SrvRequest (int fd)
+{
+    char        cmd[CMDSZ + 1];
+    char        hdr[64];
+    char *      inbuf = NULL;
+    char *      outbuf = NULL;
+    char *      errbuf = NULL;
+    size_t      outlen = 0;
+    size_t      errlen = 0;
+    long        inlen;
+    FILE *      in;
+    FILE *      out;
+    FILE *      err;
+    int         ret;
+
+    /* the request */
+    if ( ! ReadLine( fd, cmd, sizeof( cmd ) ) || ! ReadLine( fd, hdr, sizeof( hdr ) ) )
+        return;
+    if ( ( inlen = strtol( hdr, NULL, 10 )) < 0 ||
+         ( inbuf = (char *) malloc( inlen + 1 )) == NULL )
+        return;
+    if ( ! ReadAll( fd, inbuf, inlen ) )
+    {
+        free( inbuf );
+        return;
+    }
+
+    /* the program's stdin, stdout & stderr */
+    in = inlen ? fmemopen( inbuf, inlen, "r" ) : fopen( "/dev/null", "r" );
+    out = open_memstream( &outbuf, &outlen );
+    err = open_memstream( &errbuf, &errlen );
+
+    if ( in && out && err )
+        ret = VclPtRun( cmd, in, out, err, NULL );
+    else
+        ret = ENOMEM;
+
+    if ( in )
+        fclose( in );
+    if ( out )
+        fclose( out );
+    if ( err )
+        fclose( err );
+
+    /* the reply */
+    sprintf( hdr, "%d %lu %lu\n", ret, (ulong) outlen, (ulong) errlen );
+    if ( WriteAll( fd, hdr, strlen( hdr ) ) && WriteAll( fd, outbuf, outlen ) )
+        WriteAll( fd, errbuf, errlen );
+
+    free( inbuf );
+    free( outbuf );
+    free( errbuf );
+} /* SrvRequest */
+
+
+/*
+ * Read a '\n' terminated line, without the '\n'
+ *
+ * Returns FALSE at EOF, on error or if the line is too long
+ *-----------------------------------------------------------*/
+int
+ReadLine (int fd, char *buf, int size)
+{
+    int         i;
+
+    for ( i = 0; i < size - 1; ++i )
+    {
+        if ( read( fd, buf + i, 1 ) != 1 )
+            return FALSE;
+        if ( buf[i] == '\n' )
+        {
+            buf[i] = '\0';
+            return TRUE;
+        }
+    }
+    return FALSE;
+} /* ReadLine */
+
+
+/*
+ * Read len bytes
+ *----------------*/
+int
+ReadAll (int fd, char *buf, size_t len)
+{
+    ssize_t     n;
+
+    while ( len )
+    {
+        if ( ( n = read( fd, buf, len )) <= 0 )
+        {
+            if ( n < 0 && errno == EINTR )
+                continue;
+            return FALSE;
+        }
+        buf += n;
+        len -= n;
+    }
+    return TRUE;
+} /* ReadAll */
+
+
+/*
+ * Write len bytes
+ *-----------------*/
+int
+WriteAll (int fd, char *buf, size_t len)
+{
+    ssize_t     n;
+
+    while ( len )
+    {
+        if ( ( n = write( fd, buf, len )) < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+            return FALSE;
+        }
+        buf += n;
+        len -= n;
+    }
+    return TRUE;
+} /* WriteAll */
+
+
+/*
+ * Read the .INI for runtime parameters
+ *
+ * sock, if not NULL, overrides [Main] Socket
+ *--------------------------------------------*/
+int
+runtimeINI (char *sock)
+{
+    char *      sec;
+    char *      val;
+    int         i = 1;                  /* entry number is 1-based */
+    char        key[KEYSZ + 1];
+    char        path[sizeof( SockPath )];
+
+    /* [Main] section */
+    sec = "Main";
+    strcpy( path, "/tmp/vci-srv.sock" );
+    while ( (val = iniReadAll( INIFILE, NULL, sec, NULL, &i, key )) != NULL )
+    {
+        if ( ! stricmp( key, "Socket" ) )
+        {
+            strncpy( path, val, sizeof( path ) - 1 );
+            path[sizeof( path ) - 1] = '\0';
+        }
+        free( val );
+    }
+    RunIni.workers = iniReadInt( INIFILE, NULL, sec, NULL, "Workers", 4 );
+    Backlog = iniReadInt( INIFILE, NULL, sec, NULL, "Backlog", 64 );
+
+    /* [Task] section */
+    sec = "Task";
+    RunIni.stack = iniReadInt( INIFILE, NULL, sec, NULL, "Stack", 262144 );
+    RunIni.warm = iniReadInt( INIFILE, NULL, sec, NULL, "Warm", 2 );
+    RunIni.reload = iniReadInt( INIFILE, NULL, sec, NULL, "Reload", 2 );
+    RunIni.budget = iniReadInt( INIFILE, NULL, sec, NULL, "Budget", 100000 );
+
+    if ( sock == NULL )
+        sock = path;
+    if ( strlen( sock ) >= sizeof( SockPath ) )
+    {
+        errno = ENAMETOOLONG;
+        return FALSE;
+    }
+    strcpy( SockPath, sock );
+    return TRUE;
+} /* runtimeINI */
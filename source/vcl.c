@@ -1,899 +1,2076 @@
-/*
- * Licensed to the Apache Software Foundation (ASF) under one
- * or more contributor license agreements.  See the NOTICE file
- * distributed with this work for additional information
- * regarding copyright ownership.  The ASF licenses this file
- * to you under the Apache License, Version 2.0 (the
- * "License"); you may not use this file except in compliance
- * with the License.  You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-/*
-    Copyright (c) 1989-1993
-    by Todd R. Hill
-    All Rights Reserved
-
-*/
-
-/*unpubModule*****************************************************************
- NAME
-    vcl.c - VAST Command Language Compiler/Interpreter
-
- DESCRIPTION
-    This module contains the main entry point for executing VCL, vclRuntime().
-    Also contains the external shutdown routine vclShutdown().
-
-    Contains routines for executing a VCL program from source code,
-    memory allocation and error handling.
-
- FUNCTIONS
-    vclRuntime()
-    vclShutdown()
-    error()
-    warning()
-    getmem()
-    AssertFail()
-
-    InitVcl()
-    CompileVcl()
-    ExecuteVcl()
-    DumpStats()
-    LoadSource()
-    SetConfig()
-    PrintPreprocess()
-    ClearMemory()
-
- ENVIRONMENT SYMBOLS
-    none as yet
-
- FILES
-    vcldef.h
-    vcl.h
-    sclib.h
-
- SEE ALSO
-
- NOTES
-    Function SetConfig() sets various runtime memory allocation sizes.
-    !?! Some of these should come from a .INI file.  There may be others
-    such as MAXALLOCS in sys.c that may be moved to a .INI file.
-
- BUGS
-
-*****************************************************************unpubModule*/
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-#include <stdlib.h>
-#include <string.h>
-#include <dir.h>
-#include <dos.h>
-#include <mem.h>
-#include <setjmp.h>
-#include <time.h>
-#include <sys\stat.h>
-#include <alloc.h>
-#include <errno.h>
-
-#include <sclib.h>
-#ifdef __cplusplus
-}
-#endif
-
-#ifdef WRAPVCL
-#include "vcl.hpp"
-#else
-#include "vcl.h"
-#include "vcldef.h"
-#endif
-
-//#include "dflat.h"
-//#include "debugger.h"
-
-
-/*pubMan**********************************************************************
- NAME
-    vclRuntime - VAST Command Language Compiler/Interpreter entry point
-
- SYNOPSIS
-    int vclRuntime (int argc, char **argv)
-
- DESCRIPTION
-    This is the main entry point for executing VCL.  Arguments argc and
-    argv similar to those passed to a C program's main() function.  Argv[0]
-    must contain the full path to the underlying binary program for the
-    preprocessor default include file path to work correctly.  The order
-    of the options is:
-
-        exePath(0) [runtimeOptions] programSourceFilename [programOptions]
-
-    Runtime options are specified before the VCL source filename.  The first
-    non-option argument is taken as the source filename.  Any options
-    following the source filename are passed on to that program.  The
-    following runtime options are supported:
-
-    Compiler options:
-        -c              Compile only, default compile and execute.
-
-        -l              No line numbers in pcode, default line numbers
-                        are embedded in the pcode.
-
-        -Dmac[=val]     Define mac, optionally equal value.  No
-                        spaces.  Non-numeric values must be enclosed
-                        in double quotes (e.g. -DFPATH="F:\\DATA").
-                        Whitespace within quotes is preserved.
-                        Note: The compiler handles command-line
-                        defined strings the same as source code
-                        #defined strings, as string constants.  Any
-                        backslash character sequences are converted,
-                        e.g. \t = tab, \a = bell.  If backslashes
-                        are not to be expanded use 2 in a row as in
-                        the example above.
-
-        -P              Print the preprocessed code to sourcename.PRE.
-                        Note: This file is overwritten without warning.
-
-        -q              Quiet mode, print only errors and warnings.
-
-        -V              Print version information
-
-    Interpreter options:
-        none as yet
-
-    Predefine symbols provided by the preprocessor:
-        CDECL           TRUE, calling convention is c
-        VCL             hex constant MMmm, MMajor and mminor VCL version
-        __DATE__        string constant date, format "Mmm dd yyyy"
-        __FILE__        string constant current file short name
-        __LINE__        unsigned constant, current file line
-        __MSDOS__       TRUE if operating system is MSDOS
-        __TIME__        string constant time, format "hh:mm:ss"
-
- ENVIRONMENT SYMBOLS
-    none as yet
-
- FILES
-    vcl.h
-
- SEE ALSO
-
- NOTES
-
- BUGS
-
-**********************************************************************pubMan*/
-
-int
-VCLCLASS vclRuntime (int argc, char **argv)
-{
-    uchar *         buff = NULL;        /* source code buffer */
-    int             ret = 0;            /* return value */
-    char *          srcFilename;        /* source filename from command line */
-
-    /* allocate internal message buffer */
-    ErrorMsg = (char *) getmem( MAXERRMSG );
-    *ErrorMsg = '\0';
-
-    VclGlobalInit();
-
-    /*-
-     * Process the command line arguments starting with 1 (not 0).
-     *
-     * Synopsis: [runtimeOptions] programSourceFilename [programOptions]
-     *
-     * Options begin with '-' (or '/' in DOS).  Processes only the leading
-     * runtimeOptions and programSourceFilename.  As runtimeOptions are
-     * processed all remaining argv[] pointers are shuffled down in the
-     * argv array.  The first non-option argument is taken as the source
-     * code filename.  All programOptions are past on to the VCL program
-     * to be executed.
-     */
-
-    for ( srcFilename = NULL; srcFilename == NULL && argc > 1 ; )
-    {
-        int         argstaken;
-        char *      cp;
-        int         i;
-
-        cp = argv[1];
-        argstaken = 1;
-
-        /* process leading runtime options */
-        if ( *cp == '-'
-#if DOS                                     /* allow a slash in DOS */
-             || *cp == '/'
-#endif
-           )
-        {
-            ++cp;                           /* incr past option character */
-
-            switch ( *cp )                  /* case-sensitive comparison */
-            {
-                case 'c' :                  /* compile only */
-                    rtopt.CompileOnly = TRUE;
-                    break;
-                case 'l' :                  /* line numbers */
-                    rtopt.NoLineNumbers = TRUE;
-                    break;
-                case 'D' :                  /* define a symbol */
-                    {
-                        ++cp;               /* incr past D */
-                        if ( *cp )
-                        {
-                            char *      eqp;
-                            char *      mp;
-                            char        gotMem = FALSE;
-
-                            mp = cp;
-
-                            /* replace any equal sign with a space */
-                            if (( eqp = strchr( cp, '=' )) != NULL )
-                                *eqp = ' ';
-
-                            /* if there was an '=' */
-                            if ( eqp )
-                            {
-                                /* if there was nothing after the '=' .. */
-                                /* and there are more arguments */
-                                if ( ! *(eqp + 1) && argc > 2 )
-                                {
-                                    char        c;
-
-                                    /* if the next arg is not an option */
-                                    c = *argv[2];
-                                    if ( c != '-'
-#if DOS
-                                         && c != '/'
-#endif
-                                       )
-                                    {
-                                        /* build 'mac "value"' string */
-                                        mp = (char *) getmem( strlen( cp ) +
-                                                     strlen( argv[2] ) + 3 );
-                                        gotMem = TRUE;
-                                        strcpy( mp, cp );
-                                        strcat( mp, "\"" );
-                                        strcat( mp, argv[2] );
-                                        strcat( mp, "\"" );
-                                        ++argstaken;       
-                                    }
-                                }
-                            }
-                            DefineMacro( (uchar *) mp );
-                            if ( gotMem )
-                                free( mp );
-                        }
-                    }
-                    break;
-                case 'H' :              /* print usage */
-                    Usage();
-                    exit( 1 );
-                    break;
-                case 'P' :              /* print preprocessed code */
-                    rtopt.PrintPreprocess = TRUE;
-                    break;
-                case 'q' :              /* quiet mode */
-                    rtopt.QuietMode = TRUE;
-                    break;
-                case 'V' :              /* print version information */
-                    PrintVersion();
-                    exit( 1 );
-                    break;
-                default :
-                    sprintf( ErrorMsg, "'%c' ignored", *cp );
-                    warning( BADVCLOPT );
-                    break;
-            }
-        }
-        else
-        {
-            /* otherwise, take the first non-option arg as source filename */
-            srcFilename = argv[1];
-        }
-
-        /* shuffle remaining pointers (if any) down in argv array */
-        for ( ; argstaken; --argstaken, --argc )
-        {
-            for ( i = 1; ( i + 1 ) < argc; ++i )
-            {
-                argv[i] = argv[i + 1];
-            }
-        }    
-    }
-
-    if ( ! rtopt.QuietMode )
-        PrintBanner();
-
-    /* set configuration parameters */
-    SetConfig();
-
-    /* load the source code */
-    if ((buff = LoadSource( srcFilename )) == NULL )
-    {
-        if ( srcFilename && *srcFilename )
-            printf( "Cannot find file %s(.VCC)\n", srcFilename );
-        else
-            printf( "No source file(s) specified\nUse -H for help\n" );
-
-        if ( FirstFile )
-            DeleteFileList( FirstFile );
-        ret = 1;
-    }
-    else
-    {
-        /* allocate VCL runtime memory */
-        InitVcl();
-
-        /* preprocess & tokenize the source code */
-        CompileVcl( buff );
-
-        /* link & execute the pseudocode */
-        ret = ExecuteVcl( &buff, argc, argv );
-
-        if ( rtopt.CompileOnly && ret == 0 )
-            printf( "compile successful\n" );
-
-        /* dump verbose runtime statistics */
-        if ( ! rtopt.QuietMode )
-            DumpStats();
-        
-        /* cleanup runtime environment */
-        vclShutdown();
-    }
-
-    free( ErrorMsg );
-
-    return ret;
-} /* vclRuntime */
-
-
-/*
- * Initialize the VCL Runtime
- */
-int
-VCLCLASS InitVcl (void)
-{
-    /* pcode area, reallocated to precise size after tokenization */
-    Progstart = (uchar *) getmem( vclCfg.MaxProgram );
-
-    /* allocate memory for runtime stack */
-    Stackbtm = (ITEM *) getmem( ( vclCfg.MaxStack + 1 ) * sizeof( struct item ) );
-    Ctx.Stackptr = Stackbtm;
-    Stacktop = Stackbtm + vclCfg.MaxStack;
-
-    /* allocate memory for VARIABLE structures */
-    VariableMemory = (VARIABLE *) getmem( vclCfg.MaxVariables * sizeof( VARIABLE ) );
-    Ctx.NextVar = VariableMemory;
-
-    /* allocate memory for user variable data space */
-    if ( ( DataSpace = (char *) malloc( vclCfg.MaxDataSpace ) ) == NULL )
-        error( OMERR );
-    Ctx.NextData = DataSpace;
-
-    /* allocate memory for FUNCTION structures */
-    FunctionMemory = (FUNCTION *) getmem( vclCfg.MaxFunctions * sizeof( FUNCTION ) );
-    NextFunction = FunctionMemory;
-
-    /* allocate memory for SYMBOLTABLE structures */
-    SymbolTable = (SYMBOLTABLE *) getmem( vclCfg.MaxSymbolTable * sizeof( SYMBOLTABLE ) );
-
-    /* allocate memory for function prototype characters */
-    NextProto = (uchar *) PrototypeMemory = (uchar *) getmem( vclCfg.MaxPrototype );
-
-    return TRUE;
-} /* InitVcl */
-
-
-/*
- * Compile VCL program(s)
- *
- * Preprocesses and tokenizes the source code
- */
-int
-VCLCLASS CompileVcl (uchar *src)
-{
-#ifdef DEBUGGER
-    wwnd = WatchIcon();
-#endif
-
-    if ( setjmp( Shelljmp ) == 0 )
-    {
-        unsigned char * pSrc;
-
-        fflush( stdin );
-        fflush( stdout );
-
-        /* get a buffer & preprocess source code */
-        pSrc = (uchar *) getmem( vclCfg.MaxProgram );
-        PreProcessor( pSrc, src );
-
-        if ( rtopt.PrintPreprocess )
-            PrintPreprocess( pSrc );
-
-        /* tokenize preprocessed code */
-        Progused = tokenize( (char *) Progstart, (char *) pSrc );
-
-        fflush( stdin );
-        fflush( stdout );
-
-        /* free the preprocessor buffer */
-        free( pSrc );
-
-        /* reallocate the pcode buffer */
-        Progstart = (uchar *) realloc( Progstart, Progused + 1 );
-    }
-    return TRUE;
-} /* CompileVcl */
-
-
-/*
- * Execute a VCL program
- *
- * Links and executes the pseudocode
- */
-int
-VCLCLASS ExecuteVcl (uchar **srcp, int argc, char *argv[])
-{
-    int     i;
-    char    startupVcl[] =              /* decl array for ln[ sizeof()...] */
-            "return main(%d,(char**)%luUL);";
-    uchar   ln[ sizeof( startupVcl )+ 6 + 32 + 1 ];  /* argc=6, big argv=32 */
-    uchar   Tknbuf[128];                /* just a good size buffer */
-
-    if ( setjmp( Shelljmp ) == 0 )
-    {
-        char *  sargv0;                 /* save argv[0] pointer */
-
-        ErrorCode = 0;
-
-        /* link global symbols */
-        if ( ! rtopt.QuietMode )
-            printf( "Linking   %s:\n", ThisFile->fname );
-        link( &Globals );
-
-        if ( rtopt.CompileOnly )        /* return if compile only */
-            return ErrorCode;
-
-        /*
-         * Release the source code memory.  Done here in case of errors
-         * during link phase and the IDE needs to position to source.
-         */
-        if ( ! KEEPSOURCE && FirstFile && FirstFile->IncludeIp )
-        {
-            free( FirstFile->IncludeIp );
-            FirstFile->IncludeIp = NULL;
-            *srcp = NULL;
-        }
-
-        /* reallocate the variable space */
-        VariableMemory = (VARIABLE *) realloc( VariableMemory, (VariablesUsed + 1) * sizeof( VARIABLE ) );
-
-        /* reallocate the function space */
-        FunctionMemory = (FUNCTION *) realloc( FunctionMemory, (FunctionsCount + 1) * sizeof( FUNCTION ) );
-
-        /* reallocate the symbol table */
-        SymbolTable = (SYMBOLTABLE *) realloc( SymbolTable, (SymbolCount + 1) * sizeof( SYMBOLTABLE ) );
-
-        /* reallocate the prototype buffer */
-        i = (int) (NextProto - (uchar *) PrototypeMemory) + 1;
-        PrototypeMemory = (char *) realloc( PrototypeMemory, i );
-        NextProto = (uchar *) PrototypeMemory + i - 1;
-
-        /*
-         * Setup argv[0] to the fully qualified VCL program path.  Set here
-         * so the original executable's path can be used during compilation
-         * as an alternate path to the "system" include files.
-         */
-        sargv0 = argv[0];
-        argv[0] = qualify_path( NULL, (char *) FirstFile->fullname );
-
-        /* tokenize the startupVcl code */
-        sprintf( (char *) ln, startupVcl, argc, argv );
-        tokenize( (char *) Tknbuf, (char *) ln );
-        Ctx.Progptr = Tknbuf;
-
-        /* get the first token of startupVcl */
-        getoken();
-
-#ifdef DEBUGGER
-        SendMessage( wwnd, CLOSE_WINDOW, 0, 0 );
-        wwnd = NULL;
-        if ( ! Stepping )
-            HideIDE();
-#endif
-
-        /*
-         * execute the psuedo-code
-         */
-        if ( ! rtopt.QuietMode )
-            printf( "Executing %s:\n", ThisFile->fname );
-
-        fflush( stdin );
-        fflush( stdout );
-
-        statement();
-
-        fflush( stdin );
-        fflush( stdout );
-
-        /* restore original argv[0] */
-        free( argv[0] );
-        argv[0] = sargv0;
-    }
-
-#ifdef DEBUGGER
-    if ( wwnd != NULL )
-        SendMessage( wwnd, CLOSE_WINDOW, 0, 0 );
-#endif
-
-    return ErrorCode ? ErrorCode : popint();
-
-} /* ExecuteVcl */
-
-
-/*
- * Shutdown a VCL program
- *
- * Releases -all- allocated memory
- */
-void
-VCLCLASS vclShutdown (void)
-{
-    CloseAllOpenFiles();                /* close any remaining open files */
-    ClearHeap();                        /* free all runtime allocations */
-    DeleteSymbols();                    /* free symbol values */
-    CleanUpPreProcessor();              /* free all macros & file list */
-    if ( FirstFile )                    /* free main program file */
-        DeleteFileList( FirstFile );
-
-    ClearMemory( &(void *) PrototypeMemory, &(void *) NextProto, NULL );
-    ClearMemory( &(void *) SymbolTable, NULL, &SymbolCount );
-    ClearMemory( &(void *) FunctionMemory, &(void *) NextFunction, NULL );
-    ClearMemory( &(void *) DataSpace, &(void *) Ctx.NextData, NULL );
-    ClearMemory( &(void *) VariableMemory, &(void *) Ctx.NextVar, NULL );
-    ClearMemory( &(void *) Stackbtm, &(void *) Ctx.Stackptr, NULL );
-    ClearMemory( &(void *) Progstart, NULL, &(int) Progused );
-    errno = 0;
-} /* vclShutDown */
-
-
-/*
- * Dump runtime statistics
- */
-void
-VCLCLASS DumpStats (void)
-{
-    long        l;
-
-#ifndef DEBUGGER
-    printf( "\n" );
-    printf( "Program... %6ld of %6ld bytes, %6.02lf%%*\n",
-            (long) Progused,
-            (long) vclCfg.MaxProgram,
-            (((double)((double)Progused /
-              (double)vclCfg.MaxProgram)) * 100.0) );
-    printf( "Symbol.... %6ld of %6ld bytes, %6.02lf%%*\n",
-            (long) SymbolCount * sizeof (SYMBOLTABLE),
-            (long) vclCfg.MaxSymbolTable * sizeof (SYMBOLTABLE),
-            (((double)((double)(SymbolCount * sizeof (SYMBOLTABLE)) /
-              ((double)(vclCfg.MaxSymbolTable * sizeof (SYMBOLTABLE))))) * 100.0) );
-    printf( "Prototype. %6ld of %6ld bytes, %6.02lf%%*\n",
-            (long) ( (char *) NextProto - (char *) PrototypeMemory ),
-            (long) vclCfg.MaxPrototype,
-            (((double)((double)((char *) NextProto - (char *) PrototypeMemory)) /
-              (double)vclCfg.MaxPrototype) * 100.0) );
-    printf( "Function.. %6ld of %6ld bytes, %6.02lf%%*\n",
-            (long) ( (char *) NextFunction - (char *) FunctionMemory ),
-            (long) vclCfg.MaxFunctions * sizeof (FUNCTION),
-            (((double)((double)((char *) NextFunction - (char *) FunctionMemory)) /
-              ((double)(vclCfg.MaxFunctions * sizeof (FUNCTION)))) * 100.0) );
-    printf( "Variable.. %6ld of %6ld bytes, %6.02lf%%*\n",
-            (long) ( (char *) Ctx.NextVar - (char *) VariableMemory ),
-            (long) vclCfg.MaxVariables * sizeof (VARIABLE),
-            (((double)((double)((char *) Ctx.NextVar - (char *) VariableMemory)) /
-              ((double)(vclCfg.MaxVariables * sizeof (VARIABLE)))) * 100.0) );
-    l = (long) ( (char *) MaxDataSpace - (char *) DataSpace );
-    printf( "Data...... %6ld of %6ld bytes, %6.02lf%%\n",
-            ( l > 0L ) ? l : 0L,
-            (long) vclCfg.MaxDataSpace,
-            ( l > 0L ) ? (((double)((double)((char *) MaxDataSpace - (char *) DataSpace )) /
-              (double)vclCfg.MaxDataSpace) * 100.0) : 0.00 );
-    l = (long) ( (char *) Stackmax - (char *) Ctx.Stackptr );
-    printf( "Stack..... %6ld of %6ld bytes, %6.02lf%%\n",
-            ( l > 0L ) ? l : 0L,
-            (long) vclCfg.MaxStack * sizeof (struct item),
-            ( l > 0L ) ? (((double)((double)((char *) Stackmax - (char *) Ctx.Stackptr)) /
-              ((double)(vclCfg.MaxStack * sizeof (struct item)))) * 100.0) : 0.00 );
-    printf( "* = reallocated prior to runtime\n" );
-#endif
-} /* DumpStats */
-
-
-/*
- * Load the source code into memory
- *
- * The fullname of the source file is not expanded to
- * a fully qualified pathname, i.e. the fullname is
- * kept the way it was specified.  This way, a developer
- * can use relative pathnames by choice, and we don't
- * change them.
- *
- * Returns NULL on error
- */
-unsigned char *
-VCLCLASS LoadSource (char *name)
-{
-    unsigned char * buff;
-    FILE *          fp;
-    char            dir[MAXDIR];
-    char            drive[MAXDRIVE];
-    char            filename[MAXFILE];
-    char            ext[MAXEXT];
-    struct stat     sb;
-    char            fullpath[MAXPATH];
-    char            shortpath[MAXFILE+MAXEXT];
-
-    /* don't bother if source path not specified */
-    if ( ! strlen( name ) )
-        return NULL;
-
-    /* split the source path into it's components */
-    fnsplit( name, drive, dir, filename, ext );
-
-    /* add a default file extension if not specified */
-    if ( *ext == 0 )
-        strcpy( ext, ".VCC" );
-
-    /* merge the components back together */
-    fnmerge( fullpath, drive, dir, filename, ext );
-    fnmerge( shortpath, "", "", filename, ext );
-
-    /* add to list of source files */
-    ThisFile = (SRCFILE *) getmem( sizeof( SRCFILE ) );
-    ThisFile->fullname = (uchar *) getmem( strlen( fullpath ) + 1 );
-    ThisFile->fname = (uchar *) getmem( strlen( shortpath ) + 1 );
-    ThisFile->isSource = TRUE;
-    if ( LastFile != NULL )
-        LastFile->NextFile = ThisFile;
-    ThisFile->NextFile = NULL;
-    LastFile = ThisFile;
-    if ( FirstFile == NULL )
-        FirstFile = ThisFile;
-    BaseFile = ThisFile;
-
-    /* file/line numbers for source file */
-    Ctx.CurrFileno = ++FileCount;
-    Ctx.CurrLineno = 0;
-
-    /* setup the source path */
-    strupr( fullpath );
-    strupr( shortpath );
-    if ( ! rtopt.QuietMode )
-        printf( "Compiling %s:\n", shortpath );
-    strcpy( (char *) ThisFile->fullname, fullpath );
-    strcpy( (char *) ThisFile->fname, shortpath );
-
-    /* get file size */
-    if ( stat( fullpath, &sb ) )
-        return NULL;
-    if ( (sb.st_size + 3) > 65534L )
-    {
-        printf( "Error %s 0: Internal error, source file > 64K bytes (999)\n",
-                shortpath );
-        return NULL;
-    }
-
-    /* allocate the buffer */
-    /* !?! 64K file size + predefined limit */
-    buff = (uchar *) getmem( (unsigned int) ( sb.st_size + 3 ) );
-    ThisFile->IncludeIp = buff;
-
-    /* open, read and close the source file */
-    /* !?! 64K file read limit */
-    if ( ( fp = fopen( fullpath, "r" ) ) == NULL )
-        return NULL;
-    fread( buff, (unsigned int) ( sb.st_size ), 1, fp );
-    fclose( fp );
-
-    /* make sure there's a newline at the end */
-    if ( buff[(int) (sb.st_size - 1)] != '\n' )
-        strcat( (char *) buff, "\n" );
-
-    return buff;
-} /* LoadSource */
-
-
-/*
- * Set configuration parameters
- *
- * !?! (Some of) these should be placed in a .INI file
- *
- * Be caution of ripple effects if any of these values exceed 64K.
- * Other variables may require wider data types (e.g. Progused relative
- * to vclCfg.MaxProgram).
- */
-void
-VCLCLASS SetConfig (void)
-{
-    vclCfg.MaxProgram     = 60 * 1024;  /* pseudocode space, bytes */
-    vclCfg.MaxStack       = 256;        /* number of stack items */
-    vclCfg.MaxVariables   = 512;        /* number of variables */
-    vclCfg.MaxFunctions   = 256;        /* number of functions */
-    vclCfg.MaxDataSpace   = 16 * 1024;  /* data space, bytes */
-    vclCfg.MaxSymbolTable = 1024;       /* number of symbol table entries */
-    vclCfg.MaxPrototype   = 2048;       /* prototype table space, bytes */
-} /* SetConfig */
-
-
-/*
- * Print preprocessed source code
- */
-void
-VCLCLASS PrintPreprocess (uchar *pSrc)
-{
-    char *      cp;
-    FILE *      fp;
-    char        pn[MAXPATH];
-
-    /* build the sourcename.pre path */
-    strcpy( pn, (char *) ThisFile->fullname );
-    for ( cp = &pn[ strlen( pn ) - 1 ]; cp > pn; --cp )
-    {
-        if ( *cp == '.' )
-        {
-            *cp = NB;
-            break;
-        }
-        else if ( *cp == '\\' || *cp == '/' || *cp == ':' )
-            break;
-    }
-    strcat( pn, ".pre" );
-
-    if ( (fp = fopen( pn, "w" )) == NULL )
-    {
-        sprintf( ErrorMsg, "cannot open '%s' for writing", pn );
-        warning( FILERR );
-        return;
-    }    
-
-    cp = (char *) pSrc;
-    while ( *cp )
-        fprintf( fp, "%c", *cp++ );
-
-    fclose( fp );
-} /* PrintPreprocess */
-
-
-/*
- * Release an allocated block and it's pointer and item count
- */
-void
-VCLCLASS ClearMemory (void **bufp, void **endp, int *countp)
-{
-    if ( *bufp )
-    {
-        free( *bufp );
-        *bufp = NULL;
-    }
-    if ( endp )
-        *endp = NULL;
-    if ( countp )
-        *countp = 0;
-} /* ClearMemory */
-
-
-void
-VCLCLASS error (int errnum)
-{
-    ErrorCode = errnum;
-
-    if ( Ctx.CurrFileno == 0 )
-        printf( "Line number information not available\n" );
-    printf( "Error %s %d: %s (id:%d)",
-            SrcFileName( Ctx.CurrFileno ),
-            Ctx.CurrLineno, errs[errnum - 1], errnum );
-    if ( ErrorMsg && *ErrorMsg )
-    {
-        printf( ": %s", ErrorMsg );
-        *ErrorMsg = '\0';
-    }
-    printf( "\n" );
-#if DEBUGGER
-    if ( Watching )
-        longjmp( Watchjmp, 1 );
-    else if ( Running )
-        longjmp( Shelljmp, 1 );
-#endif
-    exit( 1 );
-} /* error */
-
-
-void
-VCLCLASS warning (int errnum)
-{
-    ErrorCode = errnum;
-
-    if ( Ctx.CurrFileno == 0 )
-        printf( "Line number information not available\n" );
-    printf( "Warning %s %d: %s (id:%d)",
-            strupr( SrcFileName( Ctx.CurrFileno ) ),
-            Ctx.CurrLineno, errs[errnum - 1], errnum );
-    if ( ErrorMsg && *ErrorMsg )
-    {
-        printf( ": %s", ErrorMsg );
-        *ErrorMsg = '\0';
-    }
-    printf( "\n" );
-} /* warning */
-
-
-void *
-VCLCLASS getmem (unsigned size)
-{
-    void *          ptr;
-
-    if ( ( ptr = calloc( 1, size ) ) == NULL )
-        error( OMERR );
-    return ptr;
-} /* getmem */
-
-
-#ifndef NDEBUG
-void
-VCLCLASS AssertFail (char *cond, char *file, int lno)
-{
-    sprintf( errs[ASSERTERR - 1], "Internal assertion failed: %s, file %s, line %d",
-             cond, file, lno );
-    error( ASSERTERR );
-} /* AssertFail */
-#endif
-
-
-/*
- * Print usage information
- *
- * !?! This routine should be moved to the underlying executable.
- */
-void
-VCLCLASS Usage (void)
-{
-    PrintBanner();
-
-    printf( "usage:\n" );
-    printf( "    %s [options] programName programOptions\n\n", PROGNAME );
-    
-    printf( "options:\n" );
-    printf( "    -c              Compile only\n" );
-    printf( "    -l              No line numbers in pcode\n" );
-    printf( "    -Dmac[=num]     Define mac, optionally equal numeric value\n" );
-    printf( "    -Dmac[=\"str\"]   Define mac, optionally equal string\n" );
-    printf( "    -H              Print this help\n" );
-    printf( "    -P              Print the preprocessed code to programName.PRE\n" );
-    printf( "    -q              Quiet mode, print errors & warnings only\n" );
-    printf( "    -V              Print version information\n" );
-} /* Usage */
-
-
-void
-VCLCLASS PrintVersion (void)
-{
-    PrintBanner();
-    printf( "Version %s, %s\n", PROGVERS, COMPILER_NAME );
-    printf( "Compiled %s at %s\n", __DATE__, __TIME__ );
-} /* PrintVersion */
-
-
-void
-VCLCLASS PrintBanner (void)
-{
-    printf( "\n%s v%s: %s\n\n", PROGNAME, PROGVERS, PROGDESC );
-} /* PrintBanner */
-
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+    Copyright (c) 1989-1993
+    by Todd R. Hill
+    All Rights Reserved
+
+*/
+
+/*unpubModule*****************************************************************
+ NAME
+    vcl.c - VAST Command Language Compiler/Interpreter
+
+ DESCRIPTION
+    This module contains the main entry point for executing VCL, vclRuntime().
+    Also contains the external shutdown routine vclShutdown().
+
+    vclCompile() and vclExecute() split vclRuntime() in two, so that a
+    program compiled once can be executed by many instances.
+
+    Contains routines for executing a VCL program from source code,
+    memory allocation and error handling.
+
+ FUNCTIONS
+    vclRuntime()
+    vclCompile()
+    vclExecute()
+    vclPrepare()
+    vclRun()
+    vclReset()
+    vclLastError()
+    vclFindFunction()
+    vclCall()
+    vclBind()
+    vclStdio()
+    vclBudget()
+    vclYields()
+    vclStats()
+    vclIoWait()
+    vclChannels()
+    vclSpawn()
+    vclLoop()
+    vclProgram()
+    vclGlobals()
+    vclShareGlobals()
+    vclHeap()
+    vclShareHeap()
+    vclShutdown()
+    error()
+    warning()
+    getmem()
+    BudgetYield()
+    AssertFail()
+
+    ParseOptions()
+    InitVcl()
+    InitRun()
+    CompileVcl()
+    ExecuteVcl()
+    LinkVcl()
+    RunVcl()
+    DumpStats()
+    LoadSource()
+    SetConfig()
+    PrintPreprocess()
+    ClearMemory()
+
+ ENVIRONMENT SYMBOLS
+    none as yet
+
+ FILES
+    vcldef.h
+    vcl.h
+    sclib.h
+
+ SEE ALSO
+
+ NOTES
+    Function SetConfig() sets various runtime memory allocation sizes.
+    !?! Some of these should come from a .INI file.  There may be others
+    such as MAXALLOCS in sys.c that may be moved to a .INI file.
+
+ BUGS
+
+*****************************************************************unpubModule*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <dir.h>
+#include <dos.h>
+#include <mem.h>
+#include <setjmp.h>
+#include <time.h>
+#include <sys\stat.h>
+#include <alloc.h>
+#include <errno.h>
+
+#include <sclib.h>
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef WRAPVCL
+#include "vcl.hpp"
+#else
+#include "vcl.h"
+#include "vcldef.h"
+#endif
+
+//#include "dflat.h"
+//#include "debugger.h"
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclRuntime - VAST Command Language Compiler/Interpreter entry point
+
+ SYNOPSIS
+    int vclRuntime (int argc, char **argv)
+
+ DESCRIPTION
+    This is the main entry point for executing VCL.  Arguments argc and
+    argv similar to those passed to a C program's main() function.  Argv[0]
+    must contain the full path to the underlying binary program for the
+    preprocessor default include file path to work correctly.  The order
+    of the options is:
+
+        exePath(0) [runtimeOptions] programSourceFilename [programOptions]
+
+    Runtime options are specified before the VCL source filename.  The first
+    non-option argument is taken as the source filename.  Any options
+    following the source filename are passed on to that program.  The
+    following runtime options are supported:
+
+    Compiler options:
+        -c              Compile only, default compile and execute.
+
+        -l              No line numbers in pcode, default line numbers
+                        are embedded in the pcode.
+
+        -Dmac[=val]     Define mac, optionally equal value.  No
+                        spaces.  Non-numeric values must be enclosed
+                        in double quotes (e.g. -DFPATH="F:\\DATA").
+                        Whitespace within quotes is preserved.
+                        Note: The compiler handles command-line
+                        defined strings the same as source code
+                        #defined strings, as string constants.  Any
+                        backslash character sequences are converted,
+                        e.g. \t = tab, \a = bell.  If backslashes
+                        are not to be expanded use 2 in a row as in
+                        the example above.
+
+        -P              Print the preprocessed code to sourcename.PRE.
+                        Note: This file is overwritten without warning.
+
+        -p              Profile the run.  The call stacks sampled are
+                        written to sourcename.PRF, a collapsed-stack
+                        file for flame graph tools, and the functions
+                        and lines sampled most are reported on stderr.
+                        Note: This file is overwritten without warning.
+
+        -C              Count the statements executed on each line and
+                        the calls of each function, with their time.
+                        The source is written to sourcename.COV with
+                        the count of each line in front, as gcov does.
+                        Note: This file is overwritten without warning.
+
+        -q              Quiet mode, print only errors and warnings.
+
+        -V              Print version information
+
+    Interpreter options:
+        none as yet
+
+    Predefine symbols provided by the preprocessor:
+        CDECL           TRUE, calling convention is c
+        VCL             hex constant MMmm, MMajor and mminor VCL version
+        __DATE__        string constant date, format "Mmm dd yyyy"
+        __FILE__        string constant current file short name
+        __LINE__        unsigned constant, current file line
+        __MSDOS__       TRUE if operating system is MSDOS
+        __TIME__        string constant time, format "hh:mm:ss"
+
+ ENVIRONMENT SYMBOLS
+    none as yet
+
+ FILES
+    vcl.h
+
+ SEE ALSO
+
+ NOTES
+
+ BUGS
+
+**********************************************************************pubMan*/
+
+int
+VCLCLASS vclRuntime (int argc, char **argv)
+{
+    uchar *         buff = NULL;        /* source code buffer */
+    int             ret = 0;            /* return value */
+    char *          srcFilename;        /* source filename from command line */
+
+    /* allocate internal message buffer */
+    ErrorMsg = (char *) getmem( MAXERRMSG );
+    *ErrorMsg = '\0';
+
+    VclGlobalInit();
+
+    srcFilename = ParseOptions( &argc, argv );
+
+    if ( ! rtopt.QuietMode )
+        PrintBanner();
+
+    /* set configuration parameters */
+    SetConfig();
+
+    /* load the source code */
+    if ((buff = LoadSource( srcFilename )) == NULL )
+    {
+        if ( srcFilename && *srcFilename )
+            printf( "Cannot find file %s(.VCC)\n", srcFilename );
+        else
+            printf( "No source file(s) specified\nUse -H for help\n" );
+
+        if ( FirstFile )
+            DeleteFileList( FirstFile );
+        ret = 1;
+    }
+    else
+    {
+        /* allocate VCL runtime memory */
+        InitVcl();
+
+        /* preprocess & tokenize, link & execute the pseudocode */
+        if ( CompileVcl( buff ) )
+            ret = ExecuteVcl( &buff, argc, argv );
+        else
+            ret = ErrorCode;
+
+        if ( rtopt.CompileOnly && ret == 0 )
+            printf( "compile successful\n" );
+
+        /* dump verbose runtime statistics */
+        if ( ! rtopt.QuietMode )
+            DumpStats();
+        
+        /* cleanup runtime environment */
+        vclShutdown();
+    }
+
+    ClearMemory( &(void *) ErrorMsg, NULL, NULL );
+
+    return ret;
+} /* vclRuntime */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclCompile - compile and link a VCL program for sharing
+
+ SYNOPSIS
+    VCLPROG *vclCompile (int *argcp, char **argv)
+
+ DESCRIPTION
+    Preprocesses, tokenizes and links the program named on the command
+    line, and runs its global initializers.  The command line is the same
+    as for vclRuntime().  On return the runtime options and the source
+    filename have been removed from argv and *argcp, leaving argv[0] and
+    the program options.
+
+    The program returned is read-only.  It may be run any number of times,
+    at the same time and from any thread, by vclExecute() on other
+    instances.  The caller owns one reference to it and must give it up
+    with vclRelease().
+
+ RETURN VALUE
+    The compiled program, or NULL if it did not compile.
+
+ SEE ALSO
+    vclExecute(), vclRelease(), vclRuntime()
+
+**********************************************************************pubMan*/
+
+VCLCLASS VCLPROG *
+VCLCLASS vclCompile (int *argcp, char **argv)
+{
+    uchar *         buff = NULL;        /* source code buffer */
+    char *          srcFilename;        /* source filename from command line */
+    VCLPROG *       prog = NULL;        /* the compiled program */
+
+    /* allocate internal message buffer */
+    ErrorMsg = (char *) getmem( MAXERRMSG );
+    *ErrorMsg = '\0';
+
+    VclGlobalInit();
+
+    srcFilename = ParseOptions( argcp, argv );
+
+    if ( ! rtopt.QuietMode )
+        PrintBanner();
+
+    /* set configuration parameters */
+    SetConfig();
+
+    /* load the source code */
+    if ((buff = LoadSource( srcFilename )) == NULL )
+    {
+        if ( srcFilename && *srcFilename )
+            printf( "Cannot find file %s(.VCC)\n", srcFilename );
+        else
+            printf( "No source file(s) specified\nUse -H for help\n" );
+
+        if ( FirstFile )
+            DeleteFileList( FirstFile );
+    }
+    else
+    {
+        /* allocate VCL runtime memory */
+        InitVcl();
+
+        /* preprocess & tokenize, link, then take the program away */
+        if ( CompileVcl( buff ) && LinkVcl( &buff ) == 0 )
+            prog = ProgramSave();
+
+        /* cleanup what is left of this instance */
+        vclShutdown();
+    }
+
+    ClearMemory( &(void *) ErrorMsg, NULL, NULL );
+
+    return prog;
+} /* vclCompile */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclExecute - execute a compiled VCL program
+
+ SYNOPSIS
+    int vclExecute (VCLPROG *prog, int argc, char **argv)
+
+ DESCRIPTION
+    Executes a program from vclCompile() in this instance.  Argc and argv
+    are passed to the program's main(); argv[0] is replaced by the program
+    path as in vclRuntime().
+
+    The instance gets its own stack, data space, heap and open files, and
+    a fresh copy of the program's initialized globals.  The program itself
+    is shared, not copied, and holds a reference to prog until the run is
+    over.
+
+    Same as vclPrepare(), vclRun() and vclShutdown().
+
+ RETURN VALUE
+    The return value of the program's main(), or the error code.
+
+ SEE ALSO
+    vclCompile(), vclRelease()
+
+**********************************************************************pubMan*/
+
+int
+VCLCLASS vclExecute (VCLPROG *prog, int argc, char **argv)
+{
+    int             ret;                /* return value */
+
+    vclPrepare( prog );
+    ret = vclRun( argc, argv );
+    vclShutdown();
+
+    return ret;
+} /* vclExecute */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclPrepare - prepare an instance to run a compiled VCL program
+
+ SYNOPSIS
+    int vclPrepare (VCLPROG *prog)
+
+ DESCRIPTION
+    Attaches prog to this instance and builds the state of a run up to
+    the call of main(): the stack and data space are allocated and the
+    globals are copied from the image vclCompile() took after the global
+    initializers ran.  Nothing is parsed, allocated or initialized at
+    vclRun() time, so a host can keep prepared instances warm and start a
+    request on one immediately.
+
+ RETURN VALUE
+    TRUE
+
+ SEE ALSO
+    vclRun(), vclExecute()
+
+**********************************************************************pubMan*/
+
+int
+VCLCLASS vclPrepare (VCLPROG *prog)
+{
+    /* allocate internal message buffer */
+    ErrorMsg = (char *) getmem( MAXERRMSG );
+    *ErrorMsg = '\0';
+
+    VclGlobalInit();
+
+    /* attach the program & allocate this run's memory */
+    ProgramLoad( prog );
+
+    return TRUE;
+} /* vclPrepare */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclRun - run the program of a prepared instance
+
+ SYNOPSIS
+    int vclRun (int argc, char **argv)
+
+ DESCRIPTION
+    Calls main() of the program attached by vclPrepare(), with argc and
+    argv as for vclExecute().  Afterwards the instance must be reset with
+    vclReset() or shut down with vclShutdown().
+
+ RETURN VALUE
+    The return value of the program's main(), or the error code.
+
+ SEE ALSO
+    vclPrepare(), vclShutdown()
+
+**********************************************************************pubMan*/
+
+int
+VCLCLASS vclRun (int argc, char **argv)
+{
+    int             ret = 0;            /* return value */
+
+    /* a full budget for the run */
+    BudgetLeft = Budget;
+    Yields = 0;
+
+    /* and fresh statistics, see vclStats() */
+    Statements = 0;
+    HeapPeak = Heap->used;
+    FilesOpened = 0;
+    MaxDataSpace = Ctx.NextData;        /* the globals, so far */
+    Stackmax = Ctx.Stackptr;
+
+    if ( ! rtopt.CompileOnly )
+        ret = RunVcl( argc, argv );
+
+    /* dump verbose runtime statistics */
+    if ( ! rtopt.QuietMode )
+        DumpStats();
+
+    return ret;
+} /* vclRun */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclReset - return a prepared instance to its state before vclRun()
+
+ SYNOPSIS
+    int vclReset (void)
+
+ DESCRIPTION
+    Undoes a run of the program attached by vclPrepare() without freeing
+    the instance's memory.  The files the program left open are closed,
+    its heap is released, the stack and data space are rewound and the
+    runtime state is cleared.  Only the globals which differ from their
+    initial values are copied back.  The instance is then ready for
+    another vclRun().
+
+ RETURN VALUE
+    TRUE, or FALSE if the instance was not prepared by vclPrepare().
+
+ SEE ALSO
+    vclPrepare(), vclRun(), vclShutdown()
+
+**********************************************************************pubMan*/
+
+int
+VCLCLASS vclReset (void)
+{
+    VARIABLE *      nextVar = Ctx.NextVar;
+
+    if ( Program == NULL || DataSpace == NULL )
+        return FALSE;
+
+    CloseAllOpenFiles();                /* close any remaining open files */
+    ClearHeap();                        /* free all runtime allocations */
+    vclStdio( NULL, NULL, NULL );       /* back to the process's stdio */
+
+    /* rewind the context & stack */
+    memset( &Ctx, 0, sizeof( Ctx ) );
+    Ctx.NextVar = nextVar;
+    Ctx.Stackptr = Stackbtm;
+
+    /* restore the globals, rewinds the data space */
+    ProgramReset();
+
+    /* runtime globals */
+    Blkvar = NULL;
+    ConstExpression = 0;
+    elementpvar = NULL;
+    GotoOffset = 0;
+    GotoNesting = 0;
+    opAssign = 0;
+    Saw_return = 0;
+    Saw_break = 0;
+    Saw_continue = 0;
+    SkipExpression = 0;
+    inSystem = 0;
+    jmp_val = 0;
+    longjumping = 0;
+    WasConsole = 0;
+    WasFileFunction = 0;
+
+    ErrorCode = 0;
+    *ErrorMsg = '\0';
+    memset( &LastError, 0, sizeof( LastError ) );
+    errno = 0;
+
+    return TRUE;
+} /* vclReset */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclLastError - get the last error of an instance
+
+ SYNOPSIS
+    VCLERROR *vclLastError (void)
+
+ DESCRIPTION
+    Returns the error which ended the last compile or run: the error id,
+    the source file and line, and the message printed for it.  An error
+    while compiling, linking or running does not end the process; the
+    call returns the error id and the instance may be reset with
+    vclReset() or shut down with vclShutdown().
+
+    The error is cleared by vclReset().
+
+ RETURN VALUE
+    A pointer to the instance's error, code 0 if there was none.
+
+ SEE ALSO
+    vclRun(), vclReset()
+
+**********************************************************************pubMan*/
+
+VCLCLASS VCLERROR *
+VCLCLASS vclLastError (void)
+{
+    return &LastError;
+} /* vclLastError */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclFindFunction - find a function of a prepared VCL program
+
+ SYNOPSIS
+    VCLFUNC vclFindFunction (const char *name)
+
+ DESCRIPTION
+    Looks up the function name of the program attached to this instance
+    by vclPrepare(), for vclCall().  The handle may be used for as long
+    as the instance is attached to the program.
+
+ RETURN VALUE
+    The function's handle, or NULL if the program has no function name.
+
+ SEE ALSO
+    vclCall(), vclPrepare()
+
+**********************************************************************pubMan*/
+
+VCLCLASS VCLFUNC
+VCLCLASS vclFindFunction (const char *name)
+{
+    int             id;
+
+    if ( ( id = FindSymbol( (char *) name )) == 0 )   /* only read */
+        return NULL;
+    return FindFunction( id );
+} /* vclFindFunction */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclCall - call a function of a prepared VCL program
+
+ SYNOPSIS
+    int vclCall (VCLFUNC func, int argc, VCLVALUE *argv, VCLVALUE *ret)
+
+ DESCRIPTION
+    Calls func, found by vclFindFunction(), with the argc arguments of
+    argv.  Each argument is a VCLVALUE whose type is one of:
+
+        VCL_CHAR        v.c, a char
+        VCL_INT         v.i, an int
+        VCL_LONG        v.l, a long
+        VCL_DOUBLE      v.d, a double
+        VCL_PTR         v.p, passed as a char pointer
+
+    The arguments are pushed onto the VCL stack and checked against the
+    function's prototype as for a call from VCL; nothing is tokenized.
+    If ret is not NULL the return value is stored in it, typed after the
+    function's return type; a pointer is returned as VCL_PTR.
+
+    The globals keep their values from call to call.  vclCall() may be
+    called any number of times between vclPrepare() and vclReset() or
+    vclShutdown(), but not from within a running VCL program.  After an
+    error or exit() the stack and the data space are as before the
+    call, so the next call starts afresh.
+
+ RETURN VALUE
+    0, or the error code.  See vclLastError().
+
+ SEE ALSO
+    vclFindFunction(), vclPrepare(), vclLastError()
+
+**********************************************************************pubMan*/
+
+int
+VCLCLASS vclCall (VCLFUNC func, int argc, VCLVALUE *argv, VCLVALUE *ret)
+{
+    ITEM * volatile svStackptr = Ctx.Stackptr;
+    char * volatile svNextData = Ctx.NextData;
+    FUNCRUNNING * volatile svCurfunc = Ctx.Curfunc;
+    FUNCTION * volatile svCurfunction = Ctx.Curfunction;
+    uchar * volatile svProgptr = Ctx.Progptr;
+    ITEM *          args;
+    DATUM           d;
+    int             i;
+
+    if ( func == NULL )
+        return NOFUNCERR;
+
+    if ( setjmp( Shelljmp ) == 0 )
+    {
+        ShellArmed = TRUE;
+        ErrorCode = 0;
+
+        /* push the arguments */
+        args = Ctx.Stackptr + 1;
+        for ( i = 0; i < argc; ++i )
+        {
+            switch ( argv[i].type )
+            {
+                case VCL_CHAR:
+                    d.ival = 0;
+                    d.cval = argv[i].v.c;
+                    push( 0, FALSE, 0, 0, sizeof( char ), CHAR, NULL, &d, 0 );
+                    break;
+                case VCL_INT:
+                    pushint( argv[i].v.i, FALSE );
+                    break;
+                case VCL_LONG:
+                    pushlng( argv[i].v.l, FALSE );
+                    break;
+                case VCL_DOUBLE:
+                    pushflt( argv[i].v.d, FALSE );
+                    break;
+                case VCL_PTR:
+                    pushptr( argv[i].v.p, CHAR, FALSE );
+                    break;
+                default:
+                    error( MISMATCHERR );
+            }
+        }
+
+        /* call it & take the return value off the stack */
+        Ctx.Curfunction = func;
+        CallFunction( argc, args );
+
+        if ( ret == NULL )
+            pop();
+        else if ( func->cat )
+        {
+            ret->type = VCL_PTR;
+            ret->v.p = popptr();
+        }
+        else switch ( func->type )
+        {
+            case CHAR:
+                ret->type = VCL_CHAR;
+                ret->v.c = (char) popint();
+                break;
+            case LONG:
+                ret->type = VCL_LONG;
+                ret->v.l = poplng();
+                break;
+            case FLOAT:
+                ret->type = VCL_DOUBLE;
+                ret->v.d = popflt();
+                break;
+            case VOID:
+                ret->type = VCL_VOID;
+                pop();
+                break;
+            default:
+                ret->type = VCL_INT;
+                ret->v.i = popint();
+                break;
+        }
+    }
+    ShellArmed = FALSE;
+
+    /* leave the instance as it was, also after an error or exit() */
+    Ctx.Stackptr = svStackptr;
+    Ctx.NextData = svNextData;
+    Ctx.Curfunc = svCurfunc;
+    Ctx.Curfunction = svCurfunction;
+    Ctx.Progptr = svProgptr;
+    Saw_return = Saw_break = Saw_continue = 0;
+
+    return ErrorCode;
+} /* vclCall */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclBind - use host memory for a VCL global
+
+ SYNOPSIS
+    int vclBind (char *name, void *addr, int size)
+
+ DESCRIPTION
+    Binds the global variable name of the program attached to this
+    instance to size bytes of host memory at addr.  From then on the
+    program reads and writes the global at addr instead of in its data
+    space, so data is shared with the host without being copied.
+
+    The program declares the global with the type of the host data, e.g.
+    "struct rec recs[100];" or "double samples[4096];", and size must be
+    at least the global's width.  The host memory must stay valid while
+    the binding is in place.  addr NULL removes the binding.
+
+    Bindings are kept by vclReset() and dropped by vclShutdown().  They
+    take effect when the global is referenced, so a pointer initialized
+    by a global initializer (e.g. "double *p = samples;") still points
+    into the data space.
+
+ RETURN VALUE
+    TRUE, or FALSE if name is not a global or size is too small.
+
+ SEE ALSO
+    vclPrepare(), vclCall()
+
+**********************************************************************pubMan*/
+
+int
+VCLCLASS vclBind (char *name, void *addr, int size)
+{
+    VARIABLE *      pvar;
+    int             id;
+
+    if ( ( id = FindSymbol( name )) == 0 )
+        return FALSE;
+
+    /* find the global, the latest declaration */
+    for ( pvar = Globals.vlast; pvar != NULL; pvar = pvar->vprev )
+        if ( pvar->vsymbolid == id && ! ( pvar->vkind & ( FUNCT | LABEL | TYPEDEF ) ) )
+            break;
+    if ( pvar == NULL || pvar->islocal ||
+         pvar < VariableMemory || pvar >= VariableMemory + VariablesUsed )
+        return FALSE;
+
+    /* unbind */
+    if ( addr == NULL )
+    {
+        if ( Bindings != NULL )
+            Bindings[pvar - VariableMemory] = NULL;
+        return TRUE;
+    }
+
+    if ( size < pvar->vwidth )
+        return FALSE;
+
+    /* by variable, so DataAddress() looks a global up at once */
+    if ( Bindings == NULL &&
+         ( Bindings = (char **) calloc( VariablesUsed, sizeof( char * ) )) == NULL )
+        return FALSE;
+    Bindings[pvar - VariableMemory] = (char *) addr;
+
+    return TRUE;
+} /* vclBind */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclStdio - set an instance's standard input and output
+
+ SYNOPSIS
+    void vclStdio (FILE *in, FILE *out, FILE *err)
+
+ DESCRIPTION
+    Sets the streams a VCL program's stdin, stdout and stderr refer to,
+    i.e. the streams used by getchar(), gets(), scanf(), putchar(),
+    puts() and printf(), and by the file functions given stdin, stdout
+    or stderr.  A NULL stream is the process's own.  This lets a host
+    running several instances at once give each its own input and
+    capture each one's output.
+
+    The compiler's and interpreter's own messages are not affected.
+    vclReset() sets the process's streams again.
+
+ SEE ALSO
+    vclPrepare(), vclReset()
+
+**********************************************************************pubMan*/
+
+void
+VCLCLASS vclStdio (FILE *in, FILE *out, FILE *err)
+{
+    handles[0] = in ? in : stdin;
+    handles[1] = out ? out : stdout;
+    handles[2] = err ? err : stderr;
+#ifdef stdaux
+    handles[3] = stdaux;
+    handles[4] = stdprn;
+#else
+    handles[3] = handles[2];
+    handles[4] = handles[1];
+#endif
+} /* vclStdio */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclBudget - make a running program yield every so often
+
+ SYNOPSIS
+    void vclBudget (long ticks, VCLYIELD yield, void *arg)
+
+ DESCRIPTION
+    Gives the program of this instance a budget of ticks loop iterations
+    and function calls.  Each time the budget is used up the interpreter
+    calls yield(arg), if yield is not NULL, and starts a new budget.  A
+    host running many programs on few threads uses this to let the
+    others run while one is in a long loop, since a thread running the
+    interpreter cannot otherwise be preempted.  ticks 0 turns it off.
+
+    Call after vclPrepare(); vclReset() keeps the budget.
+
+ SEE ALSO
+    vclYields(), vclPrepare()
+
+**********************************************************************pubMan*/
+
+void
+VCLCLASS vclBudget (long ticks, VCLYIELD yield, void *arg)
+{
+    Budget = BudgetLeft = ( ticks > 0 ) ? ticks : 0;
+    YieldHook = yield;
+    YieldArg = arg;
+} /* vclBudget */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclYields - get the number of times a run used up its budget
+
+ SYNOPSIS
+    unsigned long vclYields (void)
+
+ DESCRIPTION
+    Returns the number of times the program used up the budget set by
+    vclBudget() since vclRun() was called.
+
+ SEE ALSO
+    vclBudget(), vclRun()
+
+**********************************************************************pubMan*/
+
+unsigned long
+VCLCLASS vclYields (void)
+{
+    return Yields;
+} /* vclYields */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclStats - get what the last run cost
+
+ SYNOPSIS
+    void vclStats (VCLSTATS *stats)
+
+ DESCRIPTION
+    Fills stats with the counts of the program's run since vclRun() was
+    called: the statements executed, the times its budget was used up,
+    the files it opened, and the most data space, stack and heap it used
+    at once.  The data space and stack are the numbers DumpStats() shows;
+    the data space includes the program's globals.
+
+    The heap is that of blocks from malloc() which are the program's at
+    the time, see vclChannels().  It is counted in the sizes the C
+    library gives the blocks, and is 0 where it cannot tell them.
+
+    May be called after vclRun(), before the instance is reset.
+
+ SEE ALSO
+    vclRun(), vclYields()
+
+**********************************************************************pubMan*/
+
+void
+VCLCLASS vclStats (VCLSTATS *stats)
+{
+    long        l;
+
+    stats->statements = Statements;
+    stats->yields = Yields;
+    l = (long) ( (char *) MaxDataSpace - (char *) DataSpace );
+    stats->data = ( l > 0L ) ? l : 0L;
+    l = (long) ( (char *) Stackmax - (char *) Stackbtm );
+    stats->stack = ( l > 0L ) ? l : 0L;
+    stats->heap = HeapPeak;
+    stats->files = FilesOpened;
+} /* vclStats */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclIoWait - let a running program wait for I/O without blocking
+
+ SYNOPSIS
+    void vclIoWait (VCLIOWAIT wait, void *arg)
+
+ DESCRIPTION
+    Sets the function the library calls before it would block:
+
+        int wait (void *arg, int fd, int events, long msecs)
+
+    fgetc(), fgets(), fread(), getchar() and gets() call it with
+    VCL_IOREAD when a pipe or socket has no input buffered;
+    fputc(), fputs(), fwrite() and fflush() call it with VCL_IOWRITE
+    when the output has to be written.  sleep() and delay() call it with
+    fd -1 and the time in msecs.  msecs is -1 to wait for fd without a
+    time limit.  The host returns when fd is ready or the time is up,
+    and may run other programs meanwhile.  The call then goes ahead
+    with the blocking library function, which no longer blocks.
+
+    Regular files and streams which are not files are not waited for.
+    wait NULL turns it off.
+
+    Call after vclPrepare(); vclReset() keeps it.
+
+ SEE ALSO
+    vclBudget(), vclStdio()
+
+ NOTES
+    Needs the GNU C library, whose stdio buffers can be inspected.  A
+    write larger than a pipe can take may still block.
+
+**********************************************************************pubMan*/
+
+void
+VCLCLASS vclIoWait (VCLIOWAIT wait, void *arg)
+{
+    IoWaitHook = wait;
+    IoWaitArg = arg;
+} /* vclIoWait */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclChannels - let a running program exchange messages with others
+
+ SYNOPSIS
+    void vclChannels (VCLCHANNELS *chans, void *arg)
+
+ DESCRIPTION
+    Sets the host functions behind the library's message channels:
+
+        int open (void *arg, char *name, int slots)
+        int send (void *arg, int chan, VCLVALUE *msg, int wait)
+        int recv (void *arg, int chan, VCLVALUE *msg, int wait)
+
+    chan_open(name, slots) calls open, which returns a channel number
+    greater than 0 for name, creating the channel with room for slots
+    messages if there is none yet, or -1.  chan_send(chan, msg) calls
+    send and chan_recv(chan) and chan_try_recv(chan, &msg) call recv;
+    these return 1 when the message was sent or received, 0 if wait is
+    FALSE and it could not be at once, or -1 for a bad channel.  With
+    wait TRUE the host returns once the channel has room or a message,
+    and may run other programs meanwhile.
+
+    A message is typed after the value sent: an int, long, double or
+    pointer.  A pointer to a block from the program's malloc() is sent
+    as VCL_BLOCK: the block leaves the sender's heap and joins the
+    receiver's, so large data moves without being copied.  The sender
+    must not use it afterwards.  Other pointers are passed as they are,
+    and mean nothing to a program in another instance.
+
+    chans NULL turns the channels off; chan_open() then returns -1.
+
+    Call after vclPrepare(); vclReset() keeps it.  chans must stay valid
+    while it is set.
+
+ SEE ALSO
+    vclIoWait()
+
+**********************************************************************pubMan*/
+
+void
+VCLCLASS vclChannels (VCLCHANNELS *chans, void *arg)
+{
+    ChanHooks = chans;
+    ChanArg = arg;
+} /* vclChannels */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclSpawn - let a running program run functions in parallel
+
+ SYNOPSIS
+    void vclSpawn (VCLSPAWN *hooks, void *arg)
+
+ DESCRIPTION
+    Sets the host functions behind the library's spawn() and join():
+
+        int spawn (void *arg, VCLFUNC func, VCLVALUE *argv)
+        int join (void *arg, int handle, VCLVALUE *ret)
+        int map (void *arg, VCLFUNC func, char *in, char *out,
+                 int count, int size)
+        int loop (void *arg, VCLLOOP *loop, long count)
+
+    spawn(name, value) looks up the function name and calls spawn, which
+    starts func with the one argument argv, typed as for a message (see
+    vclChannels()), and returns a handle greater than 0, or -1.  The
+    host runs func in another instance prepared from the same program,
+    sharing this instance's globals and heap (see vclShareGlobals()).
+
+    join(handle) calls join, which waits for the function to return and
+    stores its return value in ret.  It returns 0, or -1 for a bad
+    handle, or the error code of the call (see vclCall()).  join() then
+    returns the function's return value, or -1.
+
+    parallel_map(array, count, size, name, out) calls map, which calls
+    func(in + i * size, out + i * size) for each i below count, spread
+    over the host's threads.  It returns 0 when they have all returned,
+    the error code of a call which failed, or -1 if it could not call
+    func at all; parallel_map() then makes the calls itself, as it does
+    when map is NULL.  So map must not return -1 once it has made a
+    call, or those elements are mapped twice.  parallel_map() returns 0,
+    or -1 if name is not a function or a call failed.
+
+    A for loop after "#pragma parallel for" calls loop, which runs
+    iterations 0 through count - 1 of it over the host's threads with
+    vclLoop().  It returns 0 when they have all run, the error code of
+    one which failed, or -1 if it could not run them; the program then
+    runs the loop itself, as it does when loop is NULL.
+
+    hooks NULL turns spawn() off; it then returns -1.
+
+    Call after vclPrepare(); vclReset() keeps it.  hooks must stay valid
+    while it is set.
+
+ SEE ALSO
+    vclShareGlobals(), vclCall()
+
+**********************************************************************pubMan*/
+
+void
+VCLCLASS vclSpawn (VCLSPAWN *hooks, void *arg)
+{
+    SpawnHooks = hooks;
+    SpawnArg = arg;
+} /* vclSpawn */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclLoop - run iterations of a parallel for loop
+
+ SYNOPSIS
+    int vclLoop (VCLLOOP *loop, long from, long to)
+
+ DESCRIPTION
+    Runs iterations from through to - 1 of loop, as passed to the loop
+    hook of vclSpawn(), in this instance, which must be prepared from
+    the same program and share its globals.  The iterations run on a
+    copy of the locals of the function running the loop, taken when the
+    loop started; the loop's reduction variables are merged into the
+    function's when they are done.
+
+    Like vclCall(), vclLoop() may not be called from within a running
+    VCL program.
+
+ RETURN VALUE
+    0, or the error code.  See vclLastError().
+
+ SEE ALSO
+    vclSpawn(), vclCall()
+
+**********************************************************************pubMan*/
+
+int
+VCLCLASS vclLoop (VCLLOOP *loop, long from, long to)
+{
+    ITEM * volatile svStackptr = Ctx.Stackptr;
+    char * volatile svNextData = Ctx.NextData;
+    FUNCRUNNING * volatile svCurfunc = Ctx.Curfunc;
+    FUNCRUNNING     fr;
+    char *          ldata;
+
+    if ( setjmp( Shelljmp ) == 0 )
+    {
+        ShellArmed = TRUE;
+        ErrorCode = 0;
+
+        /* a frame like the function's, holding a copy of its locals */
+        if ( Ctx.NextData + loop->framelen > DataSpace + vclCfg.MaxDataSpace )
+            error( DATASPACERR );
+        ldata = GetDataSpace( loop->framelen, 0 );
+        memcpy( ldata, loop->image, loop->framelen );
+        fr.fvar = loop->fvar;
+        fr.ldata = ldata;
+        fr.arglength = loop->arglength;
+        fr.fprev = NULL;
+        fr.BlkNesting = loop->BlkNesting;
+        fr.enter = fr.child = 0.0;
+        Ctx.Curfunc = &fr;
+        Ctx.Curfunction = loop->fvar;
+
+        ReduceInit( loop, ldata );
+        LoopBody( loop, from, to, ldata );
+        ReduceMerge( loop, ldata );
+    }
+    ShellArmed = FALSE;
+
+    /* leave the instance as it was, also after an error */
+    Ctx.Stackptr = svStackptr;
+    Ctx.NextData = svNextData;
+    Ctx.Curfunc = svCurfunc;
+    Saw_return = Saw_break = Saw_continue = 0;
+
+    return ErrorCode;
+} /* vclLoop */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclProgram - get the program attached to an instance
+
+ SYNOPSIS
+    VCLPROG * vclProgram (void)
+
+ DESCRIPTION
+    Returns the program attached by vclPrepare(), e.g. to prepare
+    further instances of it.  The caller does not get a reference; see
+    vclRetain().
+
+ RETURN VALUE
+    The program, or NULL if the instance was not prepared.
+
+ SEE ALSO
+    vclPrepare(), vclRetain()
+
+**********************************************************************pubMan*/
+
+VCLCLASS VCLPROG *
+VCLCLASS vclProgram (void)
+{
+    return Program;
+} /* vclProgram */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclGlobals, vclShareGlobals, vclHeap, vclShareHeap - share globals
+    between instances
+
+ SYNOPSIS
+    void * vclGlobals (void)
+    void vclShareGlobals (void *globals)
+    void * vclHeap (void)
+    void vclShareHeap (void *heap)
+
+ DESCRIPTION
+    vclGlobals() returns the address of the global data of the program
+    attached to this instance by vclPrepare().
+
+    vclShareGlobals() makes the program of this instance read and write
+    its globals, and static locals, at globals instead of in its own data
+    space.  globals must be what vclGlobals() returned for another
+    instance of the same program, so the instances see the same globals;
+    the instance's locals and stack stay its own.  The instances may run
+    at once on different threads, and the program must synchronize its
+    use of the globals itself.  globals NULL goes back to the instance's
+    own globals.
+
+    vclHeap() returns the list of the blocks the program of this instance
+    allocated with malloc(), and marks it shared, so that it is locked
+    from then on; call it before another instance uses the list.
+    vclShareHeap() puts the blocks this instance allocates on heap, what
+    vclHeap() returned for another instance, so either may free them.
+    They outlive this instance and are freed when that one is reset.
+    heap NULL goes back to the instance's own list.  Instances sharing
+    globals should share the heap too, as the program may keep its
+    blocks in globals.  The program's free() of a block which is not on
+    the list is ignored.
+
+    Call after vclPrepare(); vclReset() keeps it.  Bindings (see
+    vclBind()) are not shared.
+
+ SEE ALSO
+    vclSpawn(), vclPrepare()
+
+**********************************************************************pubMan*/
+
+void *
+VCLCLASS vclGlobals (void)
+{
+    return GlobalData ? GlobalData : DataSpace;
+} /* vclGlobals */
+
+
+void
+VCLCLASS vclShareGlobals (void *globals)
+{
+    GlobalData = (char *) globals;
+} /* vclShareGlobals */
+
+
+void *
+VCLCLASS vclHeap (void)
+{
+    OwnHeap.shared = TRUE;
+    return &OwnHeap;
+} /* vclHeap */
+
+
+void
+VCLCLASS vclShareHeap (void *heap)
+{
+    Heap = heap ? (VCLHEAP *) heap : &OwnHeap;
+} /* vclShareHeap */
+
+
+/*
+ * Process the command line arguments starting with 1 (not 0).
+ *
+ * Returns the source filename, NULL if none
+ */
+char *
+VCLCLASS ParseOptions (int *argcp, char **argv)
+{
+    char *          srcFilename;        /* source filename from command line */
+
+    /*-
+     * Synopsis: [runtimeOptions] programSourceFilename [programOptions]
+     *
+     * Options begin with '-' (or '/' in DOS).  Processes only the leading
+     * runtimeOptions and programSourceFilename.  As runtimeOptions are
+     * processed all remaining argv[] pointers are shuffled down in the
+     * argv array.  The first non-option argument is taken as the source
+     * code filename.  All programOptions are past on to the VCL program
+     * to be executed.
+     */
+
+    for ( srcFilename = NULL; srcFilename == NULL && *argcp > 1 ; )
+    {
+        int         argstaken;
+        char *      cp;
+        int         i;
+
+        cp = argv[1];
+        argstaken = 1;
+
+        /* process leading runtime options */
+        if ( *cp == '-'
+#if DOS                                     /* allow a slash in DOS */
+             || *cp == '/'
+#endif
+           )
+        {
+            ++cp;                           /* incr past option character */
+
+            switch ( *cp )                  /* case-sensitive comparison */
+            {
+                case 'c' :                  /* compile only */
+                    rtopt.CompileOnly = TRUE;
+                    break;
+                case 'l' :                  /* line numbers */
+                    rtopt.NoLineNumbers = TRUE;
+                    break;
+                case 'D' :                  /* define a symbol */
+                    {
+                        ++cp;               /* incr past D */
+                        if ( *cp )
+                        {
+                            char *      eqp;
+                            char *      mp;
+                            char        gotMem = FALSE;
+
+                            mp = cp;
+
+                            /* replace any equal sign with a space */
+                            if (( eqp = strchr( cp, '=' )) != NULL )
+                                *eqp = ' ';
+
+                            /* if there was an '=' */
+                            if ( eqp )
+                            {
+                                /* if there was nothing after the '=' .. */
+                                /* and there are more arguments */
+                                if ( ! *(eqp + 1) && *argcp > 2 )
+                                {
+                                    char        c;
+
+                                    /* if the next arg is not an option */
+                                    c = *argv[2];
+                                    if ( c != '-'
+#if DOS
+                                         && c != '/'
+#endif
+                                       )
+                                    {
+                                        /* build 'mac "value"' string */
+                                        mp = (char *) getmem( strlen( cp ) +
+                                                     strlen( argv[2] ) + 3 );
+                                        gotMem = TRUE;
+                                        strcpy( mp, cp );
+                                        strcat( mp, "\"" );
+                                        strcat( mp, argv[2] );
+                                        strcat( mp, "\"" );
+                                        ++argstaken;       
+                                    }
+                                }
+                            }
+                            DefineMacro( (uchar *) mp );
+                            if ( gotMem )
+                                free( mp );
+                        }
+                    }
+                    break;
+                case 'H' :              /* print usage */
+                    Usage();
+                    exit( 1 );
+                    break;
+                case 'P' :              /* print preprocessed code */
+                    rtopt.PrintPreprocess = TRUE;
+                    break;
+                case 'p' :              /* profile */
+                    rtopt.Profile = TRUE;
+                    break;
+                case 'C' :              /* execution counts */
+                    rtopt.Counts = TRUE;
+                    break;
+                case 'q' :              /* quiet mode */
+                    rtopt.QuietMode = TRUE;
+                    break;
+                case 'V' :              /* print version information */
+                    PrintVersion();
+                    exit( 1 );
+                    break;
+                default :
+                    sprintf( ErrorMsg, "'%c' ignored", *cp );
+                    warning( BADVCLOPT );
+                    break;
+            }
+        }
+        else
+        {
+            /* otherwise, take the first non-option arg as source filename */
+            srcFilename = argv[1];
+        }
+
+        /* shuffle remaining pointers (if any) down in argv array */
+        for ( ; argstaken; --argstaken, --*argcp )
+        {
+            for ( i = 1; ( i + 1 ) < *argcp; ++i )
+            {
+                argv[i] = argv[i + 1];
+            }
+        }    
+    }
+
+    return srcFilename;
+} /* ParseOptions */
+
+
+/*
+ * Initialize the VCL Runtime
+ */
+int
+VCLCLASS InitVcl (void)
+{
+    /* pcode area, reallocated to precise size after tokenization */
+    Progstart = (uchar *) getmem( vclCfg.MaxProgram );
+
+    /* allocate memory for runtime stack & data space */
+    InitRun();
+
+    /* allocate memory for VARIABLE structures */
+    VariableMemory = (VARIABLE *) getmem( vclCfg.MaxVariables * sizeof( VARIABLE ) );
+    Ctx.NextVar = VariableMemory;
+
+    /* allocate memory for FUNCTION structures */
+    FunctionMemory = (FUNCTION *) getmem( vclCfg.MaxFunctions * sizeof( FUNCTION ) );
+    NextFunction = FunctionMemory;
+
+    /* allocate memory for SYMBOLTABLE structures */
+    SymbolTable = (SYMBOLTABLE *) getmem( vclCfg.MaxSymbolTable * sizeof( SYMBOLTABLE ) );
+
+    /* allocate memory for function prototype characters */
+    NextProto = (uchar *) PrototypeMemory = (uchar *) getmem( vclCfg.MaxPrototype );
+
+    return TRUE;
+} /* InitVcl */
+
+
+/*
+ * Allocate the memory for one run
+ *
+ * The stack and the user variable data space belong to the
+ * instance, even when the program is shared.
+ */
+int
+VCLCLASS InitRun (void)
+{
+    /* allocate memory for runtime stack */
+    Stackbtm = (ITEM *) getmem( ( vclCfg.MaxStack + 1 ) * sizeof( struct item ) );
+    Ctx.Stackptr = Stackbtm;
+    Stacktop = Stackbtm + vclCfg.MaxStack;
+
+    /* allocate memory for user variable data space */
+    if ( ( DataSpace = (char *) malloc( vclCfg.MaxDataSpace ) ) == NULL )
+        error( OMERR );
+    Ctx.NextData = DataSpace;
+
+    return TRUE;
+} /* InitRun */
+
+
+/*
+ * Compile VCL program(s)
+ *
+ * Preprocesses and tokenizes the source code.  Returns FALSE
+ * after an error.
+ */
+int
+VCLCLASS CompileVcl (uchar *src)
+{
+#ifdef DEBUGGER
+    wwnd = WatchIcon();
+#endif
+
+    uchar * volatile pSrc = NULL;       /* preprocessor buffer */
+    int             ret = TRUE;
+
+    if ( setjmp( Shelljmp ) == 0 )
+    {
+        ShellArmed = TRUE;
+
+        fflush( stdin );
+        fflush( stdout );
+
+        /* get a buffer & preprocess source code */
+        pSrc = (uchar *) getmem( vclCfg.MaxProgram );
+        PreProcessor( pSrc, src );
+
+        if ( rtopt.PrintPreprocess )
+            PrintPreprocess( pSrc );
+
+        /* tokenize preprocessed code */
+        Progused = tokenize( (char *) Progstart, (char *) pSrc );
+
+        fflush( stdin );
+        fflush( stdout );
+
+        /* reallocate the pcode buffer */
+        Progstart = (uchar *) realloc( Progstart, Progused + 1 );
+    }
+    else
+        ret = FALSE;                    /* error() */
+    ShellArmed = FALSE;
+
+    /* free the preprocessor buffer */
+    if ( pSrc )
+        free( pSrc );
+
+    return ret;
+} /* CompileVcl */
+
+
+/*
+ * Execute a VCL program
+ *
+ * Links and executes the pseudocode
+ */
+int
+VCLCLASS ExecuteVcl (uchar **srcp, int argc, char *argv[])
+{
+    if ( LinkVcl( srcp ) || rtopt.CompileOnly )
+        return ErrorCode;               /* return if error or compile only */
+
+    return RunVcl( argc, argv );
+} /* ExecuteVcl */
+
+
+/*
+ * Link a VCL program
+ *
+ * Links the global symbols, running the global initializers, and
+ * shrinks the program's tables to their final size.  Returns the
+ * error code, 0 if linked.
+ */
+int
+VCLCLASS LinkVcl (uchar **srcp)
+{
+    int     i;
+
+    if ( setjmp( Shelljmp ) == 0 )
+    {
+        ShellArmed = TRUE;
+        ErrorCode = 0;
+
+        /* link global symbols */
+        if ( ! rtopt.QuietMode )
+            printf( "Linking   %s:\n", ThisFile->fname );
+        link( &Globals );
+
+        if ( rtopt.CompileOnly )        /* return if compile only */
+        {
+            ShellArmed = FALSE;
+            return ErrorCode;
+        }
+
+        /*
+         * Release the source code memory.  Done here in case of errors
+         * during link phase and the IDE needs to position to source.
+         */
+        if ( ! KEEPSOURCE && FirstFile && FirstFile->IncludeIp )
+        {
+            free( FirstFile->IncludeIp );
+            FirstFile->IncludeIp = NULL;
+            *srcp = NULL;
+        }
+
+        /* reallocate the variable space */
+        VariableMemory = (VARIABLE *) realloc( VariableMemory, (VariablesUsed + 1) * sizeof( VARIABLE ) );
+
+        /* reallocate the function space */
+        FunctionMemory = (FUNCTION *) realloc( FunctionMemory, (FunctionsCount + 1) * sizeof( FUNCTION ) );
+
+        /* reallocate the symbol table */
+        SymbolTable = (SYMBOLTABLE *) realloc( SymbolTable, (SymbolCount + 1) * sizeof( SYMBOLTABLE ) );
+
+        /* reallocate the prototype buffer */
+        i = (int) (NextProto - (uchar *) PrototypeMemory) + 1;
+        PrototypeMemory = (char *) realloc( PrototypeMemory, i );
+        NextProto = (uchar *) PrototypeMemory + i - 1;
+    }
+    ShellArmed = FALSE;
+
+    return ErrorCode;
+} /* LinkVcl */
+
+
+/*
+ * Run a linked VCL program
+ *
+ * Calls main() with argc and argv, pushed directly onto the stack
+ */
+int
+VCLCLASS RunVcl (int argc, char *argv[])
+{
+    char * volatile sargv0 = argv[0];   /* save argv[0] pointer */
+    ITEM *          args;               /* main()'s arguments */
+
+    if ( setjmp( Shelljmp ) == 0 )
+    {
+        ShellArmed = TRUE;
+        ErrorCode = 0;
+
+        /*
+         * Setup argv[0] to the fully qualified VCL program path.  Set here
+         * so the original executable's path can be used during compilation
+         * as an alternate path to the "system" include files.
+         */
+        argv[0] = qualify_path( NULL, (char *) FirstFile->fullname );
+
+        /* find main() */
+        if ( ( Ctx.Curfunction = FindFunction( FindSymbol( "main" ) )) == NULL )
+            error( NOMAINERR );
+
+        /* push argc & (char **) argv */
+        args = Ctx.Stackptr + 1;
+        pushint( argc, FALSE );
+        pushptr( argv, CHAR, FALSE );
+        Ctx.Stackptr->cat = 2;
+
+#ifdef DEBUGGER
+        SendMessage( wwnd, CLOSE_WINDOW, 0, 0 );
+        wwnd = NULL;
+        if ( ! Stepping )
+            HideIDE();
+#endif
+
+        /*
+         * execute the psuedo-code
+         */
+        if ( ! rtopt.QuietMode )
+            fprintf( handles[1], "Executing %s:\n", ThisFile->fname );
+
+        fflush( handles[0] );
+        fflush( handles[1] );
+
+        if ( rtopt.Profile )
+            ProfStart();                /* sample the run, see profile.c */
+        if ( rtopt.Counts )
+            CovStart();                 /* count it, see coverage.c */
+        CallFunction( 2, args );
+
+        fflush( handles[0] );
+        fflush( handles[1] );
+    }
+    ShellArmed = FALSE;
+
+    /* write the profile, also after an error or exit() */
+    if ( Prof != NULL )
+        ProfStop();
+    if ( Cover != NULL )
+        CovStop();
+
+    /* restore original argv[0], also after an error or exit() */
+    if ( argv[0] != sargv0 )
+    {
+        free( argv[0] );
+        argv[0] = sargv0;
+    }
+
+#ifdef DEBUGGER
+    if ( wwnd != NULL )
+        SendMessage( wwnd, CLOSE_WINDOW, 0, 0 );
+#endif
+
+    return ErrorCode ? ErrorCode : popint();
+
+} /* RunVcl */
+
+
+/*
+ * Shutdown a VCL program
+ *
+ * Releases -all- allocated memory.  A shared program is only
+ * detached; it is freed by the last instance to release it.
+ */
+void
+VCLCLASS vclShutdown (void)
+{
+    CloseAllOpenFiles();                /* close any remaining open files */
+    ClearHeap();                        /* free all runtime allocations */
+    FreeBuffers();                      /* free all macros */
+
+    if ( Program != NULL )
+        ProgramRelease();               /* detach the shared program */
+    else
+    {
+        DeleteSymbols();                /* free symbol values */
+        if ( FirstFile )                /* free all files */
+            DeleteFileList( FirstFile );
+
+        ClearMemory( &(void *) PrototypeMemory, &(void *) NextProto, NULL );
+        ClearMemory( &(void *) SymbolTable, NULL, &SymbolCount );
+        ClearMemory( &(void *) FunctionMemory, &(void *) NextFunction, NULL );
+        ClearMemory( &(void *) VariableMemory, &(void *) Ctx.NextVar, NULL );
+        ClearMemory( &(void *) Progstart, NULL, &(int) Progused );
+        ClearMemory( &(void *) Relocs, NULL, &RelocCount );
+    }
+
+    ClearMemory( &(void *) DataSpace, &(void *) Ctx.NextData, NULL );
+    ClearMemory( &(void *) Stackbtm, &(void *) Ctx.Stackptr, NULL );
+    ClearMemory( &(void *) ErrorMsg, NULL, NULL );
+    ClearMemory( &(void *) Bindings, NULL, NULL );
+    errno = 0;
+} /* vclShutDown */
+
+
+/*
+ * Dump runtime statistics
+ */
+void
+VCLCLASS DumpStats (void)
+{
+    long        l;
+
+#ifndef DEBUGGER
+    printf( "\n" );
+    printf( "Program... %6ld of %6ld bytes, %6.02lf%%*\n",
+            (long) Progused,
+            (long) vclCfg.MaxProgram,
+            (((double)((double)Progused /
+              (double)vclCfg.MaxProgram)) * 100.0) );
+    printf( "Symbol.... %6ld of %6ld bytes, %6.02lf%%*\n",
+            (long) SymbolCount * sizeof (SYMBOLTABLE),
+            (long) vclCfg.MaxSymbolTable * sizeof (SYMBOLTABLE),
+            (((double)((double)(SymbolCount * sizeof (SYMBOLTABLE)) /
+              ((double)(vclCfg.MaxSymbolTable * sizeof (SYMBOLTABLE))))) * 100.0) );
+    printf( "Prototype. %6ld of %6ld bytes, %6.02lf%%*\n",
+            (long) ( (char *) NextProto - (char *) PrototypeMemory ),
+            (long) vclCfg.MaxPrototype,
+            (((double)((double)((char *) NextProto - (char *) PrototypeMemory)) /
+              (double)vclCfg.MaxPrototype) * 100.0) );
+    printf( "Function.. %6ld of %6ld bytes, %6.02lf%%*\n",
+            (long) ( (char *) NextFunction - (char *) FunctionMemory ),
+            (long) vclCfg.MaxFunctions * sizeof (FUNCTION),
+            (((double)((double)((char *) NextFunction - (char *) FunctionMemory)) /
+              ((double)(vclCfg.MaxFunctions * sizeof (FUNCTION)))) * 100.0) );
+    printf( "Variable.. %6ld of %6ld bytes, %6.02lf%%*\n",
+            (long) ( (char *) Ctx.NextVar - (char *) VariableMemory ),
+            (long) vclCfg.MaxVariables * sizeof (VARIABLE),
+            (((double)((double)((char *) Ctx.NextVar - (char *) VariableMemory)) /
+              ((double)(vclCfg.MaxVariables * sizeof (VARIABLE)))) * 100.0) );
+    l = (long) ( (char *) MaxDataSpace - (char *) DataSpace );
+    printf( "Data...... %6ld of %6ld bytes, %6.02lf%%\n",
+            ( l > 0L ) ? l : 0L,
+            (long) vclCfg.MaxDataSpace,
+            ( l > 0L ) ? (((double)((double)((char *) MaxDataSpace - (char *) DataSpace )) /
+              (double)vclCfg.MaxDataSpace) * 100.0) : 0.00 );
+    l = (long) ( (char *) Stackmax - (char *) Ctx.Stackptr );
+    printf( "Stack..... %6ld of %6ld bytes, %6.02lf%%\n",
+            ( l > 0L ) ? l : 0L,
+            (long) vclCfg.MaxStack * sizeof (struct item),
+            ( l > 0L ) ? (((double)((double)((char *) Stackmax - (char *) Ctx.Stackptr)) /
+              ((double)(vclCfg.MaxStack * sizeof (struct item)))) * 100.0) : 0.00 );
+    printf( "* = reallocated prior to runtime\n" );
+#endif
+} /* DumpStats */
+
+
+/*
+ * Load the source code into memory
+ *
+ * The fullname of the source file is not expanded to
+ * a fully qualified pathname, i.e. the fullname is
+ * kept the way it was specified.  This way, a developer
+ * can use relative pathnames by choice, and we don't
+ * change them.
+ *
+ * Returns NULL on error
+ */
+unsigned char *
+VCLCLASS LoadSource (char *name)
+{
+    unsigned char * buff;
+    FILE *          fp;
+    char            dir[MAXDIR];
+    char            drive[MAXDRIVE];
+    char            filename[MAXFILE];
+    char            ext[MAXEXT];
+    struct stat     sb;
+    char            fullpath[MAXPATH];
+    char            shortpath[MAXFILE+MAXEXT];
+
+    /* don't bother if source path not specified */
+    if ( ! strlen( name ) )
+        return NULL;
+
+    /* split the source path into it's components */
+    fnsplit( name, drive, dir, filename, ext );
+
+    /* add a default file extension if not specified */
+    if ( *ext == 0 )
+        strcpy( ext, ".VCC" );
+
+    /* merge the components back together */
+    fnmerge( fullpath, drive, dir, filename, ext );
+    fnmerge( shortpath, "", "", filename, ext );
+
+    /* add to list of source files */
+    ThisFile = (SRCFILE *) getmem( sizeof( SRCFILE ) );
+    ThisFile->fullname = (uchar *) getmem( strlen( fullpath ) + 1 );
+    ThisFile->fname = (uchar *) getmem( strlen( shortpath ) + 1 );
+    ThisFile->isSource = TRUE;
+    if ( LastFile != NULL )
+        LastFile->NextFile = ThisFile;
+    ThisFile->NextFile = NULL;
+    LastFile = ThisFile;
+    if ( FirstFile == NULL )
+        FirstFile = ThisFile;
+    BaseFile = ThisFile;
+
+    /* file/line numbers for source file */
+    Ctx.CurrFileno = ++FileCount;
+    Ctx.CurrLineno = 0;
+
+    /* setup the source path */
+    strupr( fullpath );
+    strupr( shortpath );
+    if ( ! rtopt.QuietMode )
+        printf( "Compiling %s:\n", shortpath );
+    strcpy( (char *) ThisFile->fullname, fullpath );
+    strcpy( (char *) ThisFile->fname, shortpath );
+
+    /* get file size */
+    if ( stat( fullpath, &sb ) )
+        return NULL;
+    SourceStamp( ThisFile, fullpath, sb.st_mtime, (long) sb.st_size );
+    if ( (sb.st_size + 3) > 65534L )
+    {
+        printf( "Error %s 0: Internal error, source file > 64K bytes (999)\n",
+                shortpath );
+        return NULL;
+    }
+
+    /* allocate the buffer */
+    /* !?! 64K file size + predefined limit */
+    buff = (uchar *) getmem( (unsigned int) ( sb.st_size + 3 ) );
+    ThisFile->IncludeIp = buff;
+
+    /* open, read and close the source file */
+    /* !?! 64K file read limit */
+    if ( ( fp = fopen( fullpath, "r" ) ) == NULL )
+        return NULL;
+    fread( buff, (unsigned int) ( sb.st_size ), 1, fp );
+    fclose( fp );
+
+    /* make sure there's a newline at the end */
+    if ( buff[(int) (sb.st_size - 1)] != '\n' )
+        strcat( (char *) buff, "\n" );
+
+    return buff;
+} /* LoadSource */
+
+
+/*
+ * Set configuration parameters
+ *
+ * !?! (Some of) these should be placed in a .INI file
+ *
+ * Be caution of ripple effects if any of these values exceed 64K.
+ * Other variables may require wider data types (e.g. Progused relative
+ * to vclCfg.MaxProgram).
+ */
+void
+VCLCLASS SetConfig (void)
+{
+    vclCfg.MaxProgram     = 60 * 1024;  /* pseudocode space, bytes */
+    vclCfg.MaxStack       = 256;        /* number of stack items */
+    vclCfg.MaxVariables   = 512;        /* number of variables */
+    vclCfg.MaxFunctions   = 256;        /* number of functions */
+    vclCfg.MaxDataSpace   = 16 * 1024;  /* data space, bytes */
+    vclCfg.MaxSymbolTable = 1024;       /* number of symbol table entries */
+    vclCfg.MaxPrototype   = 2048;       /* prototype table space, bytes */
+} /* SetConfig */
+
+
+/*
+ * Print preprocessed source code
+ */
+void
+VCLCLASS PrintPreprocess (uchar *pSrc)
+{
+    char *      cp;
+    FILE *      fp;
+    char        pn[MAXPATH];
+
+    /* build the sourcename.pre path */
+    strcpy( pn, (char *) ThisFile->fullname );
+    for ( cp = &pn[ strlen( pn ) - 1 ]; cp > pn; --cp )
+    {
+        if ( *cp == '.' )
+        {
+            *cp = NB;
+            break;
+        }
+        else if ( *cp == '\\' || *cp == '/' || *cp == ':' )
+            break;
+    }
+    strcat( pn, ".pre" );
+
+    if ( (fp = fopen( pn, "w" )) == NULL )
+    {
+        sprintf( ErrorMsg, "cannot open '%s' for writing", pn );
+        warning( FILERR );
+        return;
+    }    
+
+    cp = (char *) pSrc;
+    while ( *cp )
+        fprintf( fp, "%c", *cp++ );
+
+    fclose( fp );
+} /* PrintPreprocess */
+
+
+/*
+ * Release an allocated block and it's pointer and item count
+ */
+void
+VCLCLASS ClearMemory (void **bufp, void **endp, int *countp)
+{
+    if ( *bufp )
+    {
+        free( *bufp );
+        *bufp = NULL;
+    }
+    if ( endp )
+        *endp = NULL;
+    if ( countp )
+        *countp = 0;
+} /* ClearMemory */
+
+
+void
+VCLCLASS error (int errnum)
+{
+    char *          fname = SrcFileName( Ctx.CurrFileno );
+
+    ErrorCode = errnum;
+
+    /* keep the error for vclLastError() */
+    LastError.code = errnum;
+    LastError.line = Ctx.CurrLineno;
+    strncpy( LastError.file, fname ? fname : "", sizeof( LastError.file ) - 1 );
+    LastError.file[sizeof( LastError.file ) - 1] = '\0';
+    if ( ErrorMsg && *ErrorMsg )
+        sprintf( LastError.message, "%.63s: %.255s", errs[errnum - 1], ErrorMsg );
+    else
+        sprintf( LastError.message, "%.63s", errs[errnum - 1] );
+
+    if ( Ctx.CurrFileno == 0 )
+        printf( "Line number information not available\n" );
+    printf( "Error %s %d: %s (id:%d)",
+            fname, Ctx.CurrLineno, errs[errnum - 1], errnum );
+    if ( ErrorMsg && *ErrorMsg )
+    {
+        printf( ": %s", ErrorMsg );
+        *ErrorMsg = '\0';
+    }
+    printf( "\n" );
+#if DEBUGGER
+    if ( Watching )
+        longjmp( Watchjmp, 1 );
+    else if ( Running )
+        longjmp( Shelljmp, 1 );
+#endif
+
+    /* unwind to the compile, link or run in progress */
+    if ( ShellArmed )
+    {
+        ShellArmed = FALSE;
+        longjmp( Shelljmp, 1 );
+    }
+    exit( 1 );
+} /* error */
+
+
+void
+VCLCLASS warning (int errnum)
+{
+    ErrorCode = errnum;
+
+    if ( Ctx.CurrFileno == 0 )
+        printf( "Line number information not available\n" );
+    printf( "Warning %s %d: %s (id:%d)",
+            strupr( SrcFileName( Ctx.CurrFileno ) ),
+            Ctx.CurrLineno, errs[errnum - 1], errnum );
+    if ( ErrorMsg && *ErrorMsg )
+    {
+        printf( ": %s", ErrorMsg );
+        *ErrorMsg = '\0';
+    }
+    printf( "\n" );
+} /* warning */
+
+
+void *
+VCLCLASS getmem (unsigned size)
+{
+    void *          ptr;
+
+    if ( ( ptr = calloc( 1, size ) ) == NULL )
+        error( OMERR );
+    return ptr;
+} /* getmem */
+
+
+/*
+ * The budget set by vclBudget() is used up
+ *
+ * Starts a new budget and calls the host's yield hook.
+ */
+void
+VCLCLASS BudgetYield (void)
+{
+    BudgetLeft = Budget;
+    ++Yields;
+    if ( YieldHook != NULL )
+        (*YieldHook)( YieldArg );
+} /* BudgetYield */
+
+
+#ifndef NDEBUG
+void
+VCLCLASS AssertFail (char *cond, char *file, int lno)
+{
+    sprintf( errs[ASSERTERR - 1], "Internal assertion failed: %s, file %s, line %d",
+             cond, file, lno );
+    error( ASSERTERR );
+} /* AssertFail */
+#endif
+
+
+/*
+ * Print usage information
+ *
+ * !?! This routine should be moved to the underlying executable.
+ */
+void
+VCLCLASS Usage (void)
+{
+    PrintBanner();
+
+    printf( "usage:\n" );
+    printf( "    %s [options] programName programOptions\n\n", PROGNAME );
+    
+    printf( "options:\n" );
+    printf( "    -c              Compile only\n" );
+    printf( "    -l              No line numbers in pcode\n" );
+    printf( "    -Dmac[=num]     Define mac, optionally equal numeric value\n" );
+    printf( "    -Dmac[=\"str\"]   Define mac, optionally equal string\n" );
+    printf( "    -H              Print this help\n" );
+    printf( "    -P              Print the preprocessed code to programName.PRE\n" );
+    printf( "    -p              Profile the run to programName.PRF\n" );
+    printf( "    -C              Count executions of lines & functions to programName.COV\n" );
+    printf( "    -q              Quiet mode, print errors & warnings only\n" );
+    printf( "    -V              Print version information\n" );
+} /* Usage */
+
+
+void
+VCLCLASS PrintVersion (void)
+{
+    PrintBanner();
+    printf( "Version %s, %s\n", PROGVERS, COMPILER_NAME );
+    printf( "Compiled %s at %s\n", __DATE__, __TIME__ );
+} /* PrintVersion */
+
+
+void
+VCLCLASS PrintBanner (void)
+{
+    printf( "\n%s v%s: %s\n\n", PROGNAME, PROGVERS, PROGDESC );
+} /* PrintBanner */
+
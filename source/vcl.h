@@ -1,57 +1,169 @@
-/*
- * Licensed to the Apache Software Foundation (ASF) under one
- * or more contributor license agreements.  See the NOTICE file
- * distributed with this work for additional information
- * regarding copyright ownership.  The ASF licenses this file
- * to you under the Apache License, Version 2.0 (the
- * "License"); you may not use this file except in compliance
- * with the License.  You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-/*
-    Copyright (c) 1989-1993
-    by Todd R. Hill
-    All Rights Reserved
-*/
-
-/*pubMan**********************************************************************
- NAME
-    vcl.h - VAST Command Language header
-
- DESCRIPTION
-    Header used for interfacing to the VAST Command Language (VCL)
-    environment for 'straight' C programs.
-
- FILES
-    vcldef.h                            Internal VCL header
-
- SEE ALSO
-
- NOTES
-
- BUGS
-
-**********************************************************************pubMan*/
-
-#ifndef VCL_H                           /* avoid multiple inclusion */
-#define VCL_H
-
-int         vclRuntime (int, char **);
-void        vclShutdown (void);
-
-#ifndef VCLDEF_H
-#ifndef __cplusplus
-#ifndef WRAPVCL
-#include "vcldef.h"
-#endif
-#endif
-#endif
-
-#endif                                  /* avoid multiple inclusion */
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+    Copyright (c) 1989-1993
+    by Todd R. Hill
+    All Rights Reserved
+*/
+
+/*pubMan**********************************************************************
+ NAME
+    vcl.h - VAST Command Language header
+
+ DESCRIPTION
+    Header used for interfacing to the VAST Command Language (VCL)
+    environment for 'straight' C programs.
+
+ FILES
+    vcldef.h                            Internal VCL header
+
+ SEE ALSO
+
+ NOTES
+
+ BUGS
+
+**********************************************************************pubMan*/
+
+#ifndef VCL_H                           /* avoid multiple inclusion */
+#define VCL_H
+
+#include <stdio.h>                      /* FILE for vclStdio() */
+
+#if defined( WRAPVCL ) && defined( __cplusplus )
+#define VCLSTATIC       static          /* needs no VclClass instance */
+#else
+#define VCLSTATIC
+#endif
+
+#ifndef VCLPROG_T
+#define VCLPROG_T
+typedef struct _vclprog VCLPROG;        /* compiled program, see vcldef.h */
+#endif
+
+#ifndef VCLLOOP_T
+#define VCLLOOP_T
+typedef struct _vclloop VCLLOOP;        /* parallel for, see vcldef.h */
+#endif
+
+typedef struct _vclerror                /* last error, see vclLastError() */
+{
+    int         code;                   /* error id, 0 if none */
+    int         line;                   /* source line, 0 if not known */
+    char        file[80];               /* source file name */
+    char        message[320];           /* error text & detail */
+} VCLERROR;
+
+typedef struct function * VCLFUNC;      /* function handle, see vclCall() */
+
+typedef void (* VCLYIELD) (void *);     /* yield hook, see vclBudget() */
+
+typedef int (* VCLIOWAIT) (void *, int, int, long); /* see vclIoWait() */
+
+enum VclIoEvents                        /* VCLIOWAIT events */
+{
+    VCL_IOREAD = 1,
+    VCL_IOWRITE = 2
+};
+
+enum VclTypes                           /* VCLVALUE types */
+{
+    VCL_VOID,
+    VCL_CHAR,
+    VCL_INT,
+    VCL_LONG,
+    VCL_DOUBLE,
+    VCL_PTR,
+    VCL_BLOCK                           /* malloc()'d block, see vclChannels() */
+};
+
+typedef struct _vclvalue                /* typed argument or return value */
+{
+    int         type;                   /* VCL_INT, etc. */
+    union
+    {
+        char    c;
+        int     i;
+        long    l;
+        double  d;
+        void *  p;
+    } v;
+} VCLVALUE;
+
+typedef struct _vclstats                /* cost of a run, see vclStats() */
+{
+    unsigned long statements;           /* statements executed */
+    unsigned long yields;               /* budgets used up */
+    long        data;                   /* peak data space, bytes */
+    long        stack;                  /* peak stack, bytes */
+    long        heap;                   /* peak malloc() heap, bytes */
+    int         files;                  /* files opened */
+} VCLSTATS;
+
+typedef struct _vclchannels             /* channel hooks, see vclChannels() */
+{
+    int         (* open) (void *, char *, int);
+    int         (* send) (void *, int, VCLVALUE *, int);
+    int         (* recv) (void *, int, VCLVALUE *, int);
+} VCLCHANNELS;
+
+typedef struct _vclspawn                /* spawn hooks, see vclSpawn() */
+{
+    int         (* spawn) (void *, VCLFUNC, VCLVALUE *);
+    int         (* join) (void *, int, VCLVALUE *);
+    int         (* map) (void *, VCLFUNC, char *, char *, int, int);
+    int         (* loop) (void *, VCLLOOP *, long);
+} VCLSPAWN;
+
+int         vclRuntime (int, char **);
+void        vclShutdown (void);
+VCLPROG *   vclCompile (int *, char **);
+int         vclExecute (VCLPROG *, int, char **);
+int         vclPrepare (VCLPROG *);
+int         vclRun (int, char **);
+int         vclReset (void);
+VCLERROR *  vclLastError (void);
+VCLFUNC     vclFindFunction (const char *);
+int         vclBind (char *, void *, int);
+void        vclStdio (FILE *, FILE *, FILE *);
+void        vclBudget (long, VCLYIELD, void *);
+unsigned long vclYields (void);
+void        vclStats (VCLSTATS *);
+void        vclIoWait (VCLIOWAIT, void *);
+void        vclChannels (VCLCHANNELS *, void *);
+void        vclSpawn (VCLSPAWN *, void *);
+VCLPROG *   vclProgram (void);
+void *      vclGlobals (void);
+void        vclShareGlobals (void *);
+void *      vclHeap (void);
+void        vclShareHeap (void *);
+int         vclLoop (VCLLOOP *, long, long);
+int         vclCall (VCLFUNC, int, VCLVALUE *, VCLVALUE *);
+VCLSTATIC void vclRelease (VCLPROG *);
+VCLSTATIC void vclRetain (VCLPROG *);
+int         vclStale (VCLPROG *);
+
+#ifndef VCLDEF_H
+#ifndef __cplusplus
+#ifndef WRAPVCL
+#include "vcldef.h"
+#endif
+#endif
+#endif
+
+#endif                                  /* avoid multiple inclusion */
@@ -1,80 +1,136 @@
-/*
- * Licensed to the Apache Software Foundation (ASF) under one
- * or more contributor license agreements.  See the NOTICE file
- * distributed with this work for additional information
- * regarding copyright ownership.  The ASF licenses this file
- * to you under the Apache License, Version 2.0 (the
- * "License"); you may not use this file except in compliance
- * with the License.  You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-/*
-    Requires "IDE define WRAPVCL=1" or "-DWRAPVCL=1" in makefile
-*/
-
-#ifndef VCL_HPP                         /* avoid multiple inclusion */
-#define VCL_HPP
-
-extern "C" {
-#include <stdio.h>
-#include <ctype.h>
-#include <math.h>
-#include <setjmp.h>
-
-#ifndef SCDEF_H
-#include <scdef.h>
-#endif
-
-int VclInstance (int, char **);         /* instance a VCL runtime object */
-}
-
-#ifndef WRAPVCL
-#define WRAPVCL     1
-#endif
-
-#ifndef SYS_H
-#include "sys.h"                        /* internal system function codes */
-#endif
-
-class VclClass
-{
-
-public:
-
-#include "publics.h"                    /* public data definitions */
-
-    VclClass (void)
-    {
-        /* empty constructor */
-    };
-
-    ~VclClass (void)
-    {
-        /* empty destructor */
-    };
-
-#include "vcl.h"                        /* public function prototypes */
-
-private:
-
-#include "vcldef.h"                     /* private data definitions */
-
-}; /* class Vcl */
-
-/*
- * Include static (non-changing) data defintions.
- *
- * Included here after other definitions and inclusions above.
- */
-#include "statics.h"
-
-#endif                                  /* avoid multiple inclusion */
-
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+    Requires "IDE define WRAPVCL=1" or "-DWRAPVCL=1" in makefile
+*/
+
+#ifndef VCL_HPP                         /* avoid multiple inclusion */
+#define VCL_HPP
+
+extern "C" {
+#include <stdio.h>
+#include <ctype.h>
+#include <math.h>
+#include <setjmp.h>
+#include <time.h>
+#ifdef VCL_PTHREADS
+#include <pthread.h>
+#endif
+
+#ifndef SCDEF_H
+#include <scdef.h>
+#endif
+
+int VclInstance (int, char **);         /* instance a VCL runtime object */
+}
+
+#ifndef WRAPVCL
+#define WRAPVCL     1
+#endif
+
+#ifndef SYS_H
+#include "sys.h"                        /* internal system function codes */
+#endif
+
+class VclClass
+{
+    /* private, defined in vcldef.h, but named by the handles of vcl.h */
+    struct _vclprog;
+    struct _vclloop;
+    struct function;
+
+public:
+
+#include "publics.h"                    /* public data definitions */
+
+    VclClass (void)
+    {
+        /* empty constructor */
+    };
+
+    ~VclClass (void)
+    {
+        /* empty destructor */
+    };
+
+#include "vcl.h"                        /* public function prototypes */
+
+    /* typed arguments for vclCall() */
+    static VCLVALUE vclArg (char c)
+    {
+        VCLVALUE    v;
+
+        v.type = VCL_CHAR;
+        v.v.c = c;
+        return v;
+    };
+    static VCLVALUE vclArg (int i)
+    {
+        VCLVALUE    v;
+
+        v.type = VCL_INT;
+        v.v.i = i;
+        return v;
+    };
+    static VCLVALUE vclArg (long l)
+    {
+        VCLVALUE    v;
+
+        v.type = VCL_LONG;
+        v.v.l = l;
+        return v;
+    };
+    static VCLVALUE vclArg (double d)
+    {
+        VCLVALUE    v;
+
+        v.type = VCL_DOUBLE;
+        v.v.d = d;
+        return v;
+    };
+    static VCLVALUE vclArg (void *p)
+    {
+        VCLVALUE    v;
+
+        v.type = VCL_PTR;
+        v.v.p = p;
+        return v;
+    };
+
+    /* call a function by name, 0 or the error code */
+    int vclCall (const char *name, int argc, VCLVALUE *argv, VCLVALUE *ret)
+    {
+        return vclCall( vclFindFunction( name ), argc, argv, ret );
+    };
+
+private:
+
+#include "vcldef.h"                     /* private data definitions */
+
+}; /* class Vcl */
+
+/*
+ * Include static (non-changing) data defintions.
+ *
+ * Included here after other definitions and inclusions above.
+ */
+#include "statics.h"
+
+#endif                                  /* avoid multiple inclusion */
+
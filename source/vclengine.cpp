@@ -0,0 +1,62 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*unpubModule*****************************************************************
+ NAME
+    vclengine.cpp - VCL engine compiled as C++ for the wrapped hosts
+
+ DESCRIPTION
+    With WRAPVCL the engine sources define the members of class VclClass
+    (see vcl.hpp), which only a C++ compiler accepts, while make compiles
+    a .c file with the C compiler.  The hosts built with WRAPVCL (vci-pt,
+    vci-srv, vci-pipe and vci-mapb) therefore compile the engine through
+    this file, which includes each of its sources.
+
+    globinit.c must come first: it defines VCL_DECL, so the statics.h of
+    its vcl.hpp defines the static data once for the whole engine.
+
+ FILES
+    vcl.hpp, statics.h
+
+ SEE ALSO
+    Makefile.am
+
+*****************************************************************unpubModule*/
+
+#ifndef WRAPVCL
+#define WRAPVCL     1
+#endif
+
+#include "globinit.c"
+#include "expr.c"
+#include "keyword.c"
+#include "preproc.c"
+#include "scanner.c"
+#include "symbol.c"
+#include "vcl.c"
+#include "func.c"
+#include "linker.c"
+#include "primary.c"
+#include "stack.c"
+#include "sys.c"
+#include "preexpr.c"
+#include "promote.c"
+#include "stmt.c"
+#include "vclprog.c"
+#include "profile.c"
+#include "coverage.c"
@@ -1,75 +1,75 @@
-/*
- * Licensed to the Apache Software Foundation (ASF) under one
- * or more contributor license agreements.  See the NOTICE file
- * distributed with this work for additional information
- * regarding copyright ownership.  The ASF licenses this file
- * to you under the Apache License, Version 2.0 (the
- * "License"); you may not use this file except in compliance
- * with the License.  You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-/*pubMan**********************************************************************
- NAME
-
- SYNOPSIS
-
- DESCRIPTION
-
- GLOBAL TYPES & ENUM VARIABLES
-
- ENVIRONMENT SYMBOLS
-
- RETURN VALUE
-
- FILES
-
- SEE ALSO
-
- NOTES
-
- SIDE EFFECTS
-
- BUGS
-
-**********************************************************************pubMan*/
-
-extern "C" {
-
-#include "vcl.hpp"
-
-void
-VclRtkInstance (void)
-{
-    int             i;
-    VclClass *      VclRun;
-    extern int      GlobalReturnValue;
-
-    VclRun = new VclClass;
-
-    /* passing a null source filename is ok, VCL reports the error */
-    {
-        int     argc;
-        char *  argv[3];
-
-        argc = 3;
-        argv[0] = "Vcl/Rtk";
-        argv[1] = "-q";
-        argv[2] = "hello";
-
-        i = VclRun->vclRuntime ( argc, argv );
-    }
-
-    delete VclRun;
-
-    GlobalReturnValue = i;
-} /* VclRtkInstance */
-
-} /* extern "C" */
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*pubMan**********************************************************************
+ NAME
+
+ SYNOPSIS
+
+ DESCRIPTION
+
+ GLOBAL TYPES & ENUM VARIABLES
+
+ ENVIRONMENT SYMBOLS
+
+ RETURN VALUE
+
+ FILES
+
+ SEE ALSO
+
+ NOTES
+
+ SIDE EFFECTS
+
+ BUGS
+
+**********************************************************************pubMan*/
+
+extern "C" {
+
+#include "vcl.hpp"
+
+void
+VclRtkInstance (void)
+{
+    int             i;
+    VclClass *      VclRun;
+    extern int      GlobalReturnValue;
+
+    VclRun = new VclClass;
+
+    /* passing a null source filename is ok, VCL reports the error */
+    {
+        int     argc;
+        char *  argv[3];
+
+        argc = 3;
+        argv[0] = "Vcl/Rtk";
+        argv[1] = "-q";
+        argv[2] = "hello";
+
+        i = VclRun->vclRuntime ( argc, argv );
+    }
+
+    delete VclRun;
+
+    GlobalReturnValue = i;
+} /* VclRtkInstance */
+
+} /* extern "C" */
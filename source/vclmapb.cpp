@@ -0,0 +1,200 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*pubMan**********************************************************************
+ NAME
+    vclmapb.cpp - VCL instance of the parallel_map() benchmark
+
+ SYNOPSIS
+    int VclMapBench (int argc, char **argv, int count, int work, int runs);
+
+ DESCRIPTION
+    Compiles the program of command line argv, as for vclRuntime(), and
+    prepares an instance of it with the spawn hooks of vclspawn.cpp.
+    Then it times the program's functions, as in mapb.vcc:
+
+        int setup (int count, int work);
+        int serial (void);
+        int parallel (void);
+        int check (void);
+
+    setup() is called once with count and work.  serial() and parallel()
+    are each called runs times, and the fastest run of each is reported
+    on stdout with the speedup of parallel() over serial().  check()
+    then returns the number of elements on which the two differ.
+
+ RETURN VALUE
+    0, ENOEXEC if the program did not compile, the error code of a
+    function which failed, or 1 if setup() or check() did not return 0.
+
+ FILES
+    vcl.hpp
+
+ SEE ALSO
+    vci-mapb.c, vclspawn.cpp, mapb.vcc
+
+ NOTES
+    The times are of the wall clock, so that of parallel() shows the
+    threads working at once.
+
+**********************************************************************pubMan*/
+
+extern "C" {
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <scdef.h>
+#include "vcl.hpp"
+
+/* definitions */
+#define MAPBHOST            "VCI-MAPB"
+
+/* externals */
+void *                  VclSpawnOpen (VclClass *, FILE *, FILE *, FILE *);  /* in vclspawn.cpp */
+void                    VclSpawnClose (void *);     /* in vclspawn.cpp */
+
+/* prototypes */
+static int              BenchCall (VclClass *, const char *, int, VclClass::VCLVALUE *, int *);
+static double           BenchNow (void);
+
+
+int
+VclMapBench (int argc, char **argv, int count, int work, int runs)
+{
+    VclClass::VCLPROG * prog;
+    VclClass::VCLVALUE  args[2];
+    VclClass *      vcl;
+    void *          spawn;
+    char **         cArgv;
+    double          serial = 0.0;
+    double          parallel = 0.0;
+    double          t;
+    int             n = argc;
+    int             rv;
+    int             ret;
+    int             i;
+
+    /* compile from a copy of argv, the compiler shuffles it */
+    if ( ( cArgv = (char **) malloc( ( argc + 1 ) * sizeof( char * ) )) == NULL )
+        return ENOMEM;
+    memcpy( cArgv, argv, ( argc + 1 ) * sizeof( char * ) );
+    vcl = new VclClass;
+    prog = vcl->vclCompile( &n, cArgv );
+    delete vcl;
+    free( cArgv );
+    if ( prog == NULL )
+        return ENOEXEC;
+
+    vcl = new VclClass;
+    vcl->vclPrepare( prog );
+    vcl->vclRelease( prog );            /* the instance has its own */
+    spawn = VclSpawnOpen( vcl, NULL, NULL, NULL );
+
+    args[0] = VclClass::vclArg( count );
+    args[1] = VclClass::vclArg( work );
+    if ( ( ret = BenchCall( vcl, "setup", 2, args, &rv )) == 0 && rv != 0 )
+        ret = 1;
+
+    /* the fastest of runs of each */
+    for ( i = 0; i < runs && ret == 0; ++i )
+    {
+        t = BenchNow();
+        if ( ( ret = BenchCall( vcl, "serial", 0, NULL, &rv )) != 0 )
+            break;
+        t = BenchNow() - t;
+        if ( i == 0 || t < serial )
+            serial = t;
+
+        t = BenchNow();
+        if ( ( ret = BenchCall( vcl, "parallel", 0, NULL, &rv )) != 0 )
+            break;
+        t = BenchNow() - t;
+        if ( i == 0 || t < parallel )
+            parallel = t;
+    }
+
+    if ( ret == 0 )
+    {
+        printf( "%d elements, work %d, fastest of %d runs\n", count, work, runs );
+        printf( "serial     %10.3f ms\n", serial * 1000.0 );
+        printf( "parallel   %10.3f ms on %ld processors\n", parallel * 1000.0,
+                sysconf( _SC_NPROCESSORS_ONLN ) );
+        printf( "speedup    %10.2f\n", parallel > 0.0 ? serial / parallel : 0.0 );
+
+        if ( ( ret = BenchCall( vcl, "check", 0, NULL, &rv )) == 0 && rv != 0 )
+        {
+            printf( "%d elements differ\n", rv );
+            ret = 1;
+        }
+    }
+
+    VclSpawnClose( spawn );
+    vcl->vclSpawn( NULL, NULL );
+    vcl->vclShutdown();
+    delete vcl;
+
+    return ret;
+} /* VclMapBench */
+
+
+/*
+ * Call a function of the benchmark by name, *rv set to its return
+ *
+ * Returns 0, or the error code
+ *------------------------------------------------------------------*/
+static int
+BenchCall (VclClass *vcl, const char *name, int argc, VclClass::VCLVALUE *argv, int *rv)
+{
+    VclClass::VCLFUNC   fn;
+    VclClass::VCLVALUE  ret;
+    VclClass::VCLERROR * e;
+    int             err;
+
+    if ( ( fn = vcl->vclFindFunction( name )) == NULL )
+    {
+        fprintf( stderr, "%s: no function %s()\n", MAPBHOST, name );
+        return 1;
+    }
+    if ( ( err = vcl->vclCall( fn, argc, argv, &ret )) != 0 )
+    {
+        e = vcl->vclLastError();
+        fprintf( stderr, "%s: %s() failed: %s %d: %s\n",
+                 MAPBHOST, name, e->file, e->line, e->message );
+        return err;
+    }
+    *rv = ret.type == VclClass::VCL_INT ? ret.v.i : 0;
+    return 0;
+} /* BenchCall */
+
+
+/* monotonic seconds */
+static double
+BenchNow (void)
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+} /* BenchNow */
+
+} /* extern "C" */
@@ -0,0 +1,437 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*unpubModule*****************************************************************
+ NAME
+    vclprog.c - Shared compiled programs
+
+ DESCRIPTION
+    Moves a linked program out of the instance that compiled it into a
+    VCLPROG, and loads a VCLPROG into an instance for execution.
+
+    The program part (pcode, variables and struct definitions, functions,
+    prototypes, symbol table and source file list) is shared by every
+    instance executing it and is never written once saved.  The run part
+    (stack, data space, heap and open files) belongs to each instance.
+    The global data space is seeded from an image taken after linking, so
+    global initializers are run once, by the compiler.
+
+ FUNCTIONS
+    vclRelease()
+    vclRetain()
+    vclStale()
+    ProgramSave()
+    ProgramLoad()
+    ProgramReset()
+    ProgramRelease()
+    AddReloc()
+    SourceStamp()
+
+    ProgramFree()
+
+ FILES
+    vcldef.h
+
+ SEE ALSO
+    vcl.c
+
+ NOTES
+    Pointers in the global data space which point into the data space
+    (e.g. "int *p = &i;") are recorded by AddReloc() while linking, and
+    are moved to the instance's own data space when it is loaded.
+
+    ProgramReset() compares the data space with the image RESETBLOCK
+    bytes at a time, so a run which dirties a few globals costs a compare
+    of the image and a copy of those blocks.  Blocks holding relocated
+    pointers always compare as dirty.
+
+    Each source file records the path, modification time and size it was
+    read with, so vclStale() can tell a long-running host that a program
+    has to be compiled again.  vclStale() updates these, the only part
+    of a saved program which is ever written.
+
+**********************************************************************unpubModule*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef WRAPVCL
+#include "vcl.hpp"
+#else
+#include "vcldef.h"
+#endif
+
+/* bytes of global data compared at a time by ProgramReset() */
+#define RESETBLOCK      64
+
+
+/*
+ * Release a reference to a compiled program
+ *
+ * The program is freed with the last reference.  Like vclRetain(),
+ * a static member in C++, so any thread may call it without an
+ * instance.
+ */
+void
+VCLCLASS vclRelease (VCLPROG *prog)
+{
+    int             refs;
+
+    if ( prog == NULL )
+        return;
+
+#ifdef VCL_PTHREADS
+    pthread_mutex_lock( &prog->lock );
+#endif
+    refs = --prog->refcount;
+#ifdef VCL_PTHREADS
+    pthread_mutex_unlock( &prog->lock );
+#endif
+
+    if ( refs == 0 )
+        ProgramFree( prog );
+} /* vclRelease */
+
+
+/*
+ * Add a reference to a compiled program
+ *
+ * For a host which hands a program on while another thread may
+ * release it; each vclRetain() is matched by a vclRelease().
+ */
+void
+VCLCLASS vclRetain (VCLPROG *prog)
+{
+#ifdef VCL_PTHREADS
+    pthread_mutex_lock( &prog->lock );
+#endif
+    ++prog->refcount;
+#ifdef VCL_PTHREADS
+    pthread_mutex_unlock( &prog->lock );
+#endif
+} /* vclRetain */
+
+
+/*
+ * Test whether a compiled program's source has changed
+ *
+ * Returns TRUE if the source file or any file it #included was
+ * modified, resized or removed since the program was compiled or
+ * since the last call.  The new times & sizes are recorded, so a
+ * change is reported once; a host which fails to compile the new
+ * source keeps the program and is not told again until the next
+ * change.  Call from one thread at a time for a program.
+ */
+int
+VCLCLASS vclStale (VCLPROG *prog)
+{
+    SRCFILE *       fp;
+    struct stat     sb;
+    int             stale = FALSE;
+
+    for ( fp = prog->FirstFile; fp != NULL; fp = fp->NextFile )
+    {
+        if ( fp->path == NULL )
+            continue;                   /* not read from a file */
+        if ( stat( fp->path, &sb ) )
+        {
+            sb.st_mtime = 0;            /* removed */
+            sb.st_size = -1;
+        }
+        if ( sb.st_mtime != fp->mtime || (long) sb.st_size != fp->size )
+        {
+            fp->mtime = sb.st_mtime;
+            fp->size = (long) sb.st_size;
+            stale = TRUE;
+        }
+    }
+    return stale;
+} /* vclStale */
+
+
+/*
+ * Save the linked program
+ *
+ * Moves the program out of this instance into a new VCLPROG, with
+ * one reference for the caller.  The instance keeps its run part.
+ */
+VCLCLASS VCLPROG *
+VCLCLASS ProgramSave (void)
+{
+    VCLPROG *       prog = (VCLPROG *) getmem( sizeof( VCLPROG ) );
+
+    prog->Progstart = Progstart;
+    prog->Progused = Progused;
+    prog->VariableMemory = VariableMemory;
+    prog->VariablesUsed = VariablesUsed;
+    prog->Globals = Globals;
+    prog->FunctionMemory = FunctionMemory;
+    prog->FunctionsCount = FunctionsCount;
+    prog->NextFunction = NextFunction;
+    prog->PrototypeMemory = PrototypeMemory;
+    prog->NextProto = NextProto;
+    prog->SymbolTable = SymbolTable;
+    prog->SymbolCount = SymbolCount;
+    prog->FirstFile = FirstFile;
+    prog->FileCount = FileCount;
+    prog->Relocs = Relocs;
+    prog->RelocCount = RelocCount;
+    prog->cfg = vclCfg;
+    prog->opt = rtopt;
+
+    /* keep the initialized global data */
+    prog->DataUsed = (int) ( Ctx.NextData - DataSpace );
+    prog->DataImage = (char *) getmem( prog->DataUsed + 1 );
+    memcpy( prog->DataImage, DataSpace, prog->DataUsed );
+    prog->DataBase = DataSpace;
+
+    prog->refcount = 1;
+#ifdef VCL_PTHREADS
+    pthread_mutex_init( &prog->lock, NULL );
+#endif
+
+    /* the instance no longer owns the program */
+    Progstart = NULL;
+    Progused = 0;
+    VariableMemory = NULL;
+    VariablesUsed = 0;
+    Globals.vfirst = Globals.vlast = NULL;
+    FunctionMemory = NextFunction = NULL;
+    FunctionsCount = 0;
+    PrototypeMemory = NULL;
+    NextProto = NULL;
+    SymbolTable = NULL;
+    SymbolCount = 0;
+    FirstFile = LastFile = ThisFile = BaseFile = NULL;
+    FileCount = 0;
+    Relocs = NULL;
+    RelocCount = 0;
+    Ctx.NextVar = NULL;
+
+    return prog;
+} /* ProgramSave */
+
+
+/*
+ * Load a saved program for execution
+ *
+ * Attaches the shared program and allocates this run's stack and
+ * data space, seeded with the program's initialized globals.
+ */
+void
+VCLCLASS ProgramLoad (VCLPROG *prog)
+{
+    int             i;
+
+#ifdef VCL_PTHREADS
+    pthread_mutex_lock( &prog->lock );
+#endif
+    ++prog->refcount;
+#ifdef VCL_PTHREADS
+    pthread_mutex_unlock( &prog->lock );
+#endif
+
+    Program = prog;
+    Progstart = prog->Progstart;
+    Progused = prog->Progused;
+    VariableMemory = prog->VariableMemory;
+    VariablesUsed = prog->VariablesUsed;
+    Globals = prog->Globals;
+    FunctionMemory = prog->FunctionMemory;
+    FunctionsCount = prog->FunctionsCount;
+    NextFunction = prog->NextFunction;
+    PrototypeMemory = prog->PrototypeMemory;
+    NextProto = prog->NextProto;
+    SymbolTable = prog->SymbolTable;
+    SymbolCount = prog->SymbolCount;
+    FirstFile = ThisFile = BaseFile = prog->FirstFile;
+    for ( LastFile = FirstFile; LastFile && LastFile->NextFile; )
+        LastFile = LastFile->NextFile;
+    FileCount = prog->FileCount;
+    vclCfg = prog->cfg;
+    rtopt = prog->opt;
+    Ctx.NextVar = VariableMemory + VariablesUsed;
+
+    /* this run's stack & data space */
+    InitRun();
+
+    /* copy in the globals, moving pointers to our data space */
+    memcpy( DataSpace, prog->DataImage, prog->DataUsed );
+    for ( i = 0; i < prog->RelocCount; ++i )
+    {
+        char **     pp = (char **) ( DataSpace + prog->Relocs[i] );
+
+        *pp = DataSpace + ( *pp - prog->DataBase );
+    }
+    Ctx.NextData = MaxDataSpace = DataSpace + prog->DataUsed;
+} /* ProgramLoad */
+
+
+/*
+ * Restore a loaded program's globals to their initial values
+ *
+ * Copies back only the blocks which were changed since the
+ * program was loaded, and rewinds the data space.
+ */
+void
+VCLCLASS ProgramReset (void)
+{
+    VCLPROG *       prog = Program;
+    int             i;
+    int             n;
+
+    for ( i = 0; i < prog->DataUsed; i += RESETBLOCK )
+    {
+        n = prog->DataUsed - i;
+        if ( n > RESETBLOCK )
+            n = RESETBLOCK;
+        if ( memcmp( DataSpace + i, prog->DataImage + i, n ) )
+            memcpy( DataSpace + i, prog->DataImage + i, n );
+    }
+    for ( i = 0; i < prog->RelocCount; ++i )
+    {
+        char **     pp = (char **) ( DataSpace + prog->Relocs[i] );
+
+        *pp = DataSpace + ( *pp - prog->DataBase );
+    }
+    Ctx.NextData = DataSpace + prog->DataUsed;
+} /* ProgramReset */
+
+
+/*
+ * Detach the shared program from this instance
+ *
+ * Releases the instance's reference.  The run part is left
+ * for vclShutdown().
+ */
+void
+VCLCLASS ProgramRelease (void)
+{
+    VCLPROG *       prog = Program;
+
+    Program = NULL;
+    Progstart = NULL;
+    Progused = 0;
+    VariableMemory = NULL;
+    VariablesUsed = 0;
+    Globals.vfirst = Globals.vlast = NULL;
+    FunctionMemory = NextFunction = NULL;
+    FunctionsCount = 0;
+    PrototypeMemory = NULL;
+    NextProto = NULL;
+    SymbolTable = NULL;
+    SymbolCount = 0;
+    FirstFile = LastFile = ThisFile = BaseFile = NULL;
+    FileCount = 0;
+    Ctx.NextVar = NULL;
+
+    vclRelease( prog );
+} /* ProgramRelease */
+
+
+/*
+ * Record a data space pointer which points into data space
+ *
+ * Called by Initializer() for pointers; ignores any pointer which
+ * is not itself in the data space or does not point into it.
+ */
+void
+VCLCLASS AddReloc (void **pp)
+{
+    char *          p = (char *) *pp;
+    char *          end = DataSpace + vclCfg.MaxDataSpace;
+
+    if ( (char *) pp < DataSpace || (char *) pp >= end )
+        return;
+    if ( p < DataSpace || p > end )
+        return;
+
+    Relocs = (int *) realloc( Relocs, ( RelocCount + 1 ) * sizeof( int ) );
+    if ( Relocs == NULL )
+        error( OMERR );
+    Relocs[RelocCount++] = (int) ( (char *) pp - DataSpace );
+} /* AddReloc */
+
+
+/*
+ * Record the path, modification time & size a source file was read with
+ *
+ * Called by LoadSource() and Include(), for vclStale().
+ */
+void
+VCLCLASS SourceStamp (SRCFILE *file, char *path, time_t mtime, long size)
+{
+    file->path = (char *) getmem( strlen( path ) + 1 );
+    strcpy( file->path, path );
+    file->mtime = mtime;
+    file->size = size;
+} /* SourceStamp */
+
+
+/*
+ * Free a program
+ *
+ * Called only when nothing references it
+ */
+void
+VCLCLASS ProgramFree (VCLPROG *prog)
+{
+    SRCFILE *       fp;
+    int             i;
+
+    for ( i = 0; i < prog->SymbolCount; i++ )
+    {
+        if ( prog->SymbolTable[i].symbol )
+            free( prog->SymbolTable[i].symbol );
+    }
+
+    while ( ( fp = prog->FirstFile ) != NULL )
+    {
+        prog->FirstFile = fp->NextFile;
+        if ( fp->fname )
+            free( fp->fname );
+        if ( fp->fullname )
+            free( fp->fullname );
+        if ( fp->IncludeIp )
+            free( fp->IncludeIp );
+        if ( fp->path )
+            free( fp->path );
+        free( fp );
+    }
+
+    free( prog->Progstart );
+    free( prog->VariableMemory );
+    free( prog->FunctionMemory );
+    free( prog->PrototypeMemory );
+    free( prog->SymbolTable );
+    free( prog->DataImage );
+    if ( prog->Relocs )
+        free( prog->Relocs );
+#ifdef VCL_PTHREADS
+    pthread_mutex_destroy( &prog->lock );
+#endif
+    free( prog );
+} /* ProgramFree */
@@ -0,0 +1,631 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*pubMan**********************************************************************
+ NAME
+    vclptin.cpp - VCL instance for the POSIX threads worker pool
+
+ SYNOPSIS
+    int VclPtRun (char *cmd, FILE *in, FILE *out, FILE *err, VCLSTATS *stats);
+    void VclPtFlush (void);
+    void (* VclPtYield) (void *);
+    int (* VclPtIoWait) (void *, int, int, long);
+    VCLCHANNELS * VclPtChans;
+
+ DESCRIPTION
+    Runs command line cmd in a VclClass object, with the program's stdin,
+    stdout and stderr set to in, out and err (NULL for the process's
+    own).  Called by the worker threads of tskpool.c for a task's command
+    line, by the connection threads of vci-srv.c and by the stage
+    threads of vci-pipe.c; any number of threads may call it at once.
+
+    The program runs with a budget of RunIni.budget ticks (see
+    vclBudget()); each time it is used up VclPtYield is called, so a
+    script in a long loop does not hold up the others.  By default the
+    thread gives up its processor; the worker pool of tskpool.c sets it
+    to switch to another task.  If stats is not NULL it is set to what
+    the run cost, see vclStats(), including the number of times the
+    budget was used up.
+
+    If VclPtIoWait is set it is the program's I/O wait hook (see
+    vclIoWait()), called when a stdio call on a pipe or socket would
+    wait, and by sleep() and delay().  The worker pool sets it to block
+    the task until the descriptor is ready, so the worker runs others.
+    Likewise VclPtChans, if set, gives the program message channels
+    (see vclChannels()); the worker pool sets it to those of tskchan.c.
+    The program may run its functions in parallel with spawn() and join(),
+    see vclspawn.cpp.
+
+    Each program is compiled once, by the first task to run it, and kept
+    in a cache.  Every task running it executes the one shared copy.
+    Tasks with the same command line wait for that compile; other tasks
+    are not held up by it, though compiles are made one at a time.  A
+    cached program is found by its runtime options and source filename;
+    the remaining arguments are the program's own.
+
+    Up to RunIni.warm instances of each cached program are kept prepared,
+    i.e. with their globals initialized and ready to call main().  A task
+    takes a warm instance if there is one.  After the task has run its
+    instance is reset and put back, and any shortfall is prepared.
+
+    If RunIni.reload is not 0, a task checks every RunIni.reload seconds
+    whether the source of its program, or any file it #includes, has
+    changed.  If it has, the task compiles it again once it has run, and
+    swaps the new program into the cache for the tasks which start after
+    that.  Tasks already running finish on the old program, which is
+    freed with its last instance.  Tasks starting meanwhile run the old
+    program.  If the new source does not compile, the old program is
+    kept.
+
+    VclPtFlush() empties the cache.
+
+ RETURN VALUE
+    The return value of the VCL program, EINVAL if the command line could
+    not be parsed, or ENOEXEC if the program did not compile.
+
+ FILES
+    vcl.hpp, tskmgmt.h
+
+ SEE ALSO
+    tskpool.c, vci-srv.c, vci-pipe.c, vclspawn.cpp, vclrtkin.cpp
+
+**********************************************************************pubMan*/
+
+extern "C" {
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include <scdef.h>
+#include <sclib.h>
+#include "vcl.hpp"
+
+#include "tskmgmt.h"
+
+/* compiled program cache entry */
+typedef struct PROGCACHE
+{
+    char *              key;            /* runtime options & source */
+    int                 nargs;          /* arguments in key */
+    VclClass::VCLPROG * prog;           /* the compiled program */
+    VclClass **         warm;           /* prepared instances */
+    int                 nwarm;          /* number prepared */
+    int                 gen;            /* count of reloads of prog */
+    time_t              checked;        /* when source last checked */
+    int                 reloading;      /* a task is checking it now */
+    int                 compiling;      /* first compile, no prog yet */
+    struct PROGCACHE *  next;
+} ProgCache_t;
+
+/* externals */
+extern char *           arg0;
+void *                  VclSpawnOpen (VclClass *, FILE *, FILE *, FILE *);  /* in vclspawn.cpp */
+void                    VclSpawnClose (void *);     /* in vclspawn.cpp */
+
+/* globals */
+void                    (* VclPtYield) (void *) = NULL;  /* budget hook */
+int                     (* VclPtIoWait) (void *, int, int, long) = NULL;   /* I/O wait hook */
+VclClass::VCLCHANNELS * VclPtChans = NULL;  /* message channels */
+
+/* locals */
+static ProgCache_t *    ProgList = NULL;
+static pthread_mutex_t  ProgLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t  CompLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   ProgCompiled = PTHREAD_COND_INITIALIZER;
+
+/* prototypes */
+static ProgCache_t *        ProgFind (char *, int, char **);
+static ProgCache_t *        ProgMatch (int, char **, int);
+static VclClass::VCLPROG *  ProgCompile (char *, int *);
+static VclClass *           ProgPrepare (ProgCache_t *, int *);
+static void                 ProgReload (ProgCache_t *, char *, VclClass *);
+static char *               ProgKey (int, char **);
+static VclClass *           WarmTake (ProgCache_t *, int *);
+static int                  WarmPut (ProgCache_t *, VclClass *, int);
+static void                 WarmFill (ProgCache_t *);
+static void                 PtYield (void *);
+
+
+int
+VclPtRun (char *cmd, FILE *in, FILE *out, FILE *err, VclClass::VCLSTATS *stats)
+{
+    int             i;
+    int             ret;
+    int             vclArgc;
+    int             gen;
+    char **         vclArgv;
+    ProgCache_t *   pc;
+    VclClass *      vcl;
+    void *          spawn;
+
+    if ( stats != NULL )
+        memset( stats, 0, sizeof( *stats ) );
+
+    /* parse the command line */
+    if ( ( vclArgc = parseLine( cmd, arg0, &vclArgv )) > 0 )
+    {
+        /* find or compile the program */
+        if ( (pc = ProgFind( cmd, vclArgc, vclArgv )) != NULL )
+        {
+            char **     progArgv = vclArgv + pc->nargs;
+            char *      svArg = progArgv[0];
+
+            /* take a warm instance, or prepare one on the heap */
+            if ( (vcl = WarmTake( pc, &gen )) == NULL )
+                vcl = ProgPrepare( pc, &gen );
+
+            /* run the VCL program with argv[0] & the program's options */
+            vcl->vclStdio( in, out, err );
+            vcl->vclBudget( RunIni.budget, VclPtYield ? VclPtYield : PtYield, NULL );
+            vcl->vclIoWait( VclPtIoWait, NULL );
+            vcl->vclChannels( VclPtChans, NULL );
+            spawn = VclSpawnOpen( vcl, in, out, err );
+            progArgv[0] = vclArgv[0];
+            ret = vcl->vclRun( vclArgc - pc->nargs, progArgv );
+            progArgv[0] = svArg;
+            VclSpawnClose( spawn );     /* the program's spawned functions */
+            vcl->vclSpawn( NULL, NULL );
+            if ( stats != NULL )
+                vcl->vclStats( stats );
+
+            /* pick up a changed source */
+            ProgReload( pc, cmd, vcl );
+
+            /* reuse the instance, or free the class object space */
+            if ( ! WarmPut( pc, vcl, gen ) )
+            {
+                vcl->vclShutdown();
+                delete vcl;
+            }
+
+            /* top up the warm instances for the next task */
+            WarmFill( pc );
+        }
+        else
+            ret = ENOEXEC;              /* did not compile */
+
+        /* free the allocated arguments */
+        for ( i = 0; i < vclArgc; ++i )
+            free( vclArgv[i] );
+
+        /* free the allocated array */
+        free( vclArgv );
+    }
+    else
+        ret = EINVAL;                   /* invalid argument */
+
+    return ret;
+} /* VclPtRun */
+
+
+/*
+ * Empty the compiled program cache
+ *
+ * Call only when no task is running
+ *-----------------------------------*/
+void
+VclPtFlush (void)
+{
+    ProgCache_t *   pc;
+
+    pthread_mutex_lock( &ProgLock );
+    while ( (pc = ProgList) != NULL )
+    {
+        ProgList = pc->next;
+        while ( pc->nwarm )
+        {
+            pc->warm[--pc->nwarm]->vclShutdown();
+            delete pc->warm[pc->nwarm];
+        }
+        VclClass::vclRelease( pc->prog );
+        free( pc->warm );
+        free( pc->key );
+        free( pc );
+    }
+    pthread_mutex_unlock( &ProgLock );
+} /* VclPtFlush */
+
+
+/*
+ * Find a task's program in the cache, compiling it if not there
+ *
+ * The entry's nargs is the number of arguments after argv[0] which
+ * are runtime options or the source filename.  While the program is
+ * compiled its entry is a placeholder keyed by the whole command line:
+ * tasks with the same command line wait for it, others go on.
+ *--------------------------------------------------------------------*/
+static ProgCache_t *
+ProgFind (char *cmd, int argc, char **argv)
+{
+    ProgCache_t *   pc;
+    ProgCache_t *   done;
+    ProgCache_t **  pp;
+    VclClass::VCLPROG * prog;
+    char *          key = NULL;
+    int             n;
+
+    pthread_mutex_lock( &ProgLock );
+
+    /* wait out the compile of this command line in another task */
+    while ( (pc = ProgMatch( argc, argv, FALSE )) == NULL &&
+            ProgMatch( argc, argv, TRUE ) != NULL )
+        pthread_cond_wait( &ProgCompiled, &ProgLock );
+
+    if ( pc != NULL )
+    {
+        pthread_mutex_unlock( &ProgLock );
+        return pc;
+    }
+
+    /* add a placeholder, until the compile says which arguments count */
+    if ( ( pc = (ProgCache_t *) calloc( 1, sizeof( ProgCache_t ) )) == NULL ||
+         ( pc->key = ProgKey( argc - 1, argv )) == NULL ||
+         ( pc->warm = (VclClass **) calloc( RunIni.warm + 1,
+                                            sizeof( VclClass * ) )) == NULL )
+    {
+        pthread_mutex_unlock( &ProgLock );
+        if ( pc )
+            free( pc->key );
+        free( pc );
+        return NULL;
+    }
+    pc->nargs = argc - 1;
+    pc->compiling = TRUE;
+    pc->next = ProgList;
+    ProgList = pc;
+    pthread_mutex_unlock( &ProgLock );
+
+    if ( (prog = ProgCompile( cmd, &n )) != NULL )
+        key = ProgKey( n, argv );
+
+    pthread_mutex_lock( &ProgLock );
+
+    for ( pp = &ProgList; *pp != pc; pp = &(*pp)->next )
+        ;
+    *pp = pc->next;
+
+    /* the program may have come in by another command line meanwhile */
+    done = key != NULL ? ProgMatch( argc, argv, FALSE ) : NULL;
+    if ( key != NULL && done == NULL )
+    {
+        free( pc->key );
+        pc->key = key;
+        pc->nargs = n;
+        pc->prog = prog;
+        pc->checked = time( NULL );
+        pc->compiling = FALSE;
+        pc->next = ProgList;
+        ProgList = pc;
+        key = NULL;
+        prog = NULL;
+    }
+    else
+    {
+        free( pc->warm );
+        free( pc->key );
+        free( pc );
+        pc = done;
+    }
+    pthread_cond_broadcast( &ProgCompiled );
+
+    pthread_mutex_unlock( &ProgLock );
+
+    free( key );
+    VclClass::vclRelease( prog );       /* if not kept */
+
+    return pc;
+} /* ProgFind */
+
+
+/*
+ * Find the cache entry of a command line, or NULL
+ *
+ * Entries still compiling are included if compiling is TRUE.
+ * Call holding ProgLock
+ *-------------------------------------------------------------*/
+static ProgCache_t *
+ProgMatch (int argc, char **argv, int compiling)
+{
+    ProgCache_t *   pc;
+    char *          key;
+    int             match;
+
+    for ( pc = ProgList; pc != NULL; pc = pc->next )
+    {
+        if ( pc->compiling && ! compiling )
+            continue;
+        if ( pc->nargs < argc && (key = ProgKey( pc->nargs, argv )) != NULL )
+        {
+            match = ! strcmp( key, pc->key );
+            free( key );
+            if ( match )
+                break;
+        }
+    }
+
+    return pc;
+} /* ProgMatch */
+
+
+/*
+ * Compile a task's program
+ *
+ * Sets *nargs to the number of arguments after argv[0] which are
+ * runtime options or the source filename.  Compiles are serialized.
+ *
+ * Returns NULL if the program did not compile
+ *-------------------------------------------------------------------*/
+static VclClass::VCLPROG *
+ProgCompile (char *cmd, int *nargs)
+{
+    VclClass::VCLPROG * prog = NULL;
+    int             cArgc;
+    int             n;
+    char **         cArgv;
+    char **         svArgv;
+    VclClass *      vclComp;
+
+    pthread_mutex_lock( &CompLock );
+
+    /* compile from a copy, the compiler shuffles & edits argv */
+    if ( ( cArgc = parseLine( cmd, arg0, &cArgv )) > 0 &&
+         ( svArgv = (char **) malloc( cArgc * sizeof( char * ) )) != NULL )
+    {
+        memcpy( svArgv, cArgv, cArgc * sizeof( char * ) );
+
+        n = cArgc;
+        vclComp = new VclClass;
+        prog = vclComp->vclCompile( &n, cArgv );
+        delete vclComp;
+
+        *nargs = cArgc - n;
+        while ( cArgc )
+            free( svArgv[--cArgc] );
+        free( svArgv );
+        free( cArgv );
+    }
+
+    pthread_mutex_unlock( &CompLock );
+
+    return prog;
+} /* ProgCompile */
+
+
+/*
+ * Prepare an instance of the current program of a cache entry
+ *
+ * *gen is set to the reload count of the program prepared
+ *-------------------------------------------------------------*/
+static VclClass *
+ProgPrepare (ProgCache_t *pc, int *gen)
+{
+    VclClass *          vcl = new VclClass;
+    VclClass::VCLPROG * prog;
+
+    /* hold the program, a reload may swap it while we prepare */
+    pthread_mutex_lock( &ProgLock );
+    prog = pc->prog;
+    *gen = pc->gen;
+    vcl->vclRetain( prog );
+    pthread_mutex_unlock( &ProgLock );
+
+    vcl->vclPrepare( prog );
+    vcl->vclRelease( prog );            /* the instance has its own */
+
+    return vcl;
+} /* ProgPrepare */
+
+
+/*
+ * Compile a cache entry's program again if its source has changed
+ *
+ * Checks at most every RunIni.reload seconds, and in one task at a
+ * time.  vcl is an instance of the program, for vclStale().
+ *------------------------------------------------------------------*/
+static void
+ProgReload (ProgCache_t *pc, char *cmd, VclClass *vcl)
+{
+    VclClass::VCLPROG * prog;
+    VclClass::VCLPROG * old = NULL;
+    VclClass **     warm;
+    int             nwarm;
+    int             n;
+    time_t          now;
+
+    if ( RunIni.reload <= 0 )
+        return;
+
+    pthread_mutex_lock( &ProgLock );
+    now = time( NULL );
+    if ( pc->reloading || now - pc->checked < RunIni.reload )
+    {
+        pthread_mutex_unlock( &ProgLock );
+        return;
+    }
+    pc->checked = now;
+    pc->reloading = TRUE;
+    pthread_mutex_unlock( &ProgLock );
+
+    /* pc->prog is only swapped by the task reloading it, i.e. this one */
+    if ( vcl->vclStale( pc->prog ) && (prog = ProgCompile( cmd, &n )) != NULL )
+    {
+        if ( n == pc->nargs &&
+             ( warm = (VclClass **) calloc( RunIni.warm + 1, sizeof( VclClass * ) )) != NULL )
+        {
+            VclClass ** oldwarm;
+
+            /* swap in the new program & an empty warm list */
+            pthread_mutex_lock( &ProgLock );
+            old = pc->prog;
+            pc->prog = prog;
+            ++pc->gen;
+            oldwarm = pc->warm;
+            nwarm = pc->nwarm;
+            pc->warm = warm;
+            pc->nwarm = 0;
+            pthread_mutex_unlock( &ProgLock );
+
+            /* the old warm instances are not running, free them */
+            while ( nwarm )
+            {
+                oldwarm[--nwarm]->vclShutdown();
+                delete oldwarm[nwarm];
+            }
+            free( oldwarm );
+        }
+        else
+            vcl->vclRelease( prog );    /* no room to swap */
+    }
+
+    /* the cache's reference, tasks still running hold their own */
+    vcl->vclRelease( old );
+
+    pthread_mutex_lock( &ProgLock );
+    pc->reloading = FALSE;
+    pthread_mutex_unlock( &ProgLock );
+} /* ProgReload */
+
+
+/*
+ * Take a warm instance of a cached program
+ *
+ * *gen is set to the reload count of the program.
+ * Returns NULL if there is none
+ *-------------------------------------------------*/
+static VclClass *
+WarmTake (ProgCache_t *pc, int *gen)
+{
+    VclClass *      vcl = NULL;
+
+    pthread_mutex_lock( &ProgLock );
+    if ( pc->nwarm )
+        vcl = pc->warm[--pc->nwarm];
+    *gen = pc->gen;
+    pthread_mutex_unlock( &ProgLock );
+
+    return vcl;
+} /* WarmTake */
+
+
+/*
+ * Reset a used instance and keep it warm
+ *
+ * gen is the reload count of the instance's program.
+ * Returns FALSE if it could not be reset, is not needed
+ * or its program was reloaded, the caller then frees it.
+ *--------------------------------------------------------*/
+static int
+WarmPut (ProgCache_t *pc, VclClass *vcl, int gen)
+{
+    int             kept = FALSE;
+
+    if ( vcl->vclReset() )
+    {
+        pthread_mutex_lock( &ProgLock );
+        if ( gen == pc->gen && pc->nwarm < RunIni.warm )
+        {
+            pc->warm[pc->nwarm++] = vcl;
+            kept = TRUE;
+        }
+        pthread_mutex_unlock( &ProgLock );
+    }
+    return kept;
+} /* WarmPut */
+
+
+/*
+ * Prepare warm instances of a cached program up to RunIni.warm
+ *
+ * Instances are prepared outside the lock; one which is not
+ * needed by the time it is ready is thrown away.
+ *--------------------------------------------------------------*/
+static void
+WarmFill (ProgCache_t *pc)
+{
+    VclClass *      vcl;
+    int             more;
+    int             gen;
+
+    pthread_mutex_lock( &ProgLock );
+    more = ( pc->nwarm < RunIni.warm );
+    pthread_mutex_unlock( &ProgLock );
+
+    while ( more )
+    {
+        vcl = ProgPrepare( pc, &gen );
+
+        pthread_mutex_lock( &ProgLock );
+        if ( (more = ( gen == pc->gen && pc->nwarm < RunIni.warm )) != 0 )
+        {
+            pc->warm[pc->nwarm++] = vcl;
+            more = ( pc->nwarm < RunIni.warm );
+            vcl = NULL;
+        }
+        pthread_mutex_unlock( &ProgLock );
+
+        if ( vcl != NULL )
+        {
+            vcl->vclShutdown();
+            delete vcl;
+        }
+    }
+} /* WarmFill */
+
+
+/*
+ * Budget used up, let the other threads run
+ *--------------------------------------------*/
+static void
+PtYield (void *arg)
+{
+    arg = arg;                          /* avoid 'not used' compiler warning */
+    sched_yield();
+} /* PtYield */
+
+
+/*
+ * Build a cache key from argv[1] to argv[nargs]
+ *-----------------------------------------------*/
+static char *
+ProgKey (int nargs, char **argv)
+{
+    char *      key;
+    int         i;
+    size_t      len = 1;
+
+    for ( i = 1; i <= nargs; ++i )
+        len += strlen( argv[i] ) + 1;
+
+    if ( (key = (char *) malloc( len )) != NULL )
+    {
+        *key = '\0';
+        for ( i = 1; i <= nargs; ++i )
+        {
+            strcat( key, argv[i] );
+            strcat( key, "\n" );
+        }
+    }
+    return key;
+} /* ProgKey */
+
+} /* extern "C" */
@@ -0,0 +1,767 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*pubMan**********************************************************************
+ NAME
+    vclspawn.cpp - parallel VCL functions on a work-stealing thread pool
+
+ SYNOPSIS
+    void * VclSpawnOpen (VclClass *vcl, FILE *in, FILE *out, FILE *err);
+    void VclSpawnClose (void *ctx);
+
+ DESCRIPTION
+    Gives the program of prepared instance vcl the spawn() and join()
+    library functions (see vclSpawn()).  VclSpawnOpen() is called before
+    the program runs and VclSpawnClose() after, with the context it
+    returned; VclSpawnClose() waits for any spawned function the program
+    did not join.
+
+    A spawned function runs in a child instance prepared from the same
+    compiled program, sharing vcl's globals and heap (see
+    vclShareGlobals()), with its own stack and locals and with in, out
+    and err for its stdio.  The blocks it allocates outlive it, and are
+    freed when vcl is reset.  Child instances are kept by the context and
+    reused.  A spawned function may itself spawn.
+
+    The functions run on a pool of one thread per processor, started by
+    the first spawn().  Each pool thread has a deque of spawned
+    functions: it pushes those it spawns at the bottom and takes work
+    from the bottom, LIFO, and an idle thread steals from the top of the
+    others, oldest first.  Functions spawned by threads outside the pool
+    go to a deque of their own, used by them as a pool thread uses its
+    own and stolen from by the pool threads.
+    A thread in join() runs other spawned functions until the one it
+    waits for has returned, so a function which spawns and joins never
+    holds up a pool thread.
+
+    parallel_map() runs the function for the first elements itself,
+    timing them, and makes the chunk taken at a time large enough for a
+    chunk to run MAPGRAIN microseconds at that rate.  It then spawns a
+    mapper for each pool thread the rest can keep busy and works with
+    them.  Each mapper takes a chunk of the remaining elements at a
+    time, a share of what is left while that is large and the smallest
+    chunk towards the end, so the threads finish together.
+
+    A for loop after "#pragma parallel for" is spread over the pool the
+    same way, a chunk of iterations at a time run by vclLoop().
+
+ RETURN VALUE
+    VclSpawnOpen() returns the context, or NULL if there is no memory;
+    the program then has no spawn().
+
+ FILES
+    vcl.hpp, tskmgmt.h
+
+ SEE ALSO
+    vclptin.cpp, vclmapb.cpp
+
+ NOTES
+    At most SPAWNJOBS functions may be spawned and not yet joined, over
+    all programs; spawn() returns -1 beyond that.
+
+    The pool threads live for the rest of the process.
+
+ EXAMPLES
+    Mapping a function over an array of doubles:
+
+        int scale (void *in, void *out)
+        {
+            *(double *) out = sqrt( *(double *) in ) * 2.5;
+            return 0;
+        }
+        ...
+        parallel_map( a, n, sizeof( double ), "scale", b );
+
+    vci-mapb times mapb.vcc's map against the plain loop and reports
+    the speedup on this host, see vci-mapb.c.
+
+    The mapped function takes its arguments as void *, the type
+    vclCall() passes pointers with.
+
+**********************************************************************pubMan*/
+
+extern "C" {
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <scdef.h>
+#include "vcl.hpp"
+
+#include "tskmgmt.h"
+
+/* definitions */
+#define SPAWNJOBS           1024        /* functions spawned & not joined */
+#define MINSTACK            65536U      /* smallest sensible thread stack */
+#define MAPPROBE            100         /* microseconds timed by a map */
+#define MAPGRAIN            200         /* microseconds of a map chunk */
+
+enum SPAWNSTATES                        /* spawned function states */
+{
+    JOB_FREE,
+    JOB_QUEUED,
+    JOB_RUNNING,
+    JOB_DONE
+};
+
+/* a run of a program which may spawn */
+typedef struct SPAWNCTX
+{
+    VclClass::VCLPROG * prog;           /* the program */
+    void *              globals;        /* its globals, shared */
+    void *              heap;           /* its heap list, shared */
+    FILE *              in;             /* its stdio */
+    FILE *              out;
+    FILE *              err;
+    VclClass **         idle;           /* child instances to reuse */
+    int                 nidle;
+    int                 maxidle;        /* size of idle */
+    int                 pending;        /* spawned & not joined */
+} SpawnCtx_t;
+
+/* the elements of a parallel_map(), or iterations of a parallel for */
+typedef struct SPAWNMAP
+{
+    VclClass::VCLFUNC   fn;
+    VclClass::VCLLOOP * loop;           /* the loop, or NULL for a map */
+    char *              in;
+    char *              out;
+    int                 size;           /* of an element */
+    long                count;          /* elements */
+    long                next;           /* first not yet taken, may pass count */
+    long                chunk;          /* smallest taken at a time */
+    int                 mappers;        /* threads taking elements */
+    int                 err;            /* first vclCall() error code */
+} SpawnMap_t;
+
+/* a spawned function */
+typedef struct SPAWNJOB
+{
+    SpawnCtx_t *        ctx;            /* spawned by */
+    SpawnMap_t *        map;            /* a mapper, or NULL */
+    VclClass::VCLFUNC   fn;
+    VclClass::VCLVALUE  arg;
+    VclClass::VCLVALUE  ret;            /* return value when done */
+    int                 err;            /* vclCall() error code */
+    int                 state;          /* JOB_FREE, etc. */
+    int                 next;           /* next free, 0 for none */
+} SpawnJob_t;
+
+/* deque of queued functions */
+typedef struct SPAWNDEQUE
+{
+    pthread_mutex_t     lock;
+    int                 jobs[SPAWNJOBS];    /* ring of job handles */
+    unsigned            top;            /* oldest, stolen */
+    unsigned            bottom;         /* newest, popped by its owner */
+} SpawnDeque_t;
+
+/* locals */
+static pthread_once_t   SpawnOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t  SpawnLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   SpawnQueued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t   SpawnDone = PTHREAD_COND_INITIALIZER;
+static pthread_key_t    SpawnKey;       /* pool thread's number + 1 */
+static SpawnJob_t       Jobs[SPAWNJOBS + 1];    /* handle 0 unused */
+static int              FreeJob = 0;    /* first free handle */
+static int              Queued = 0;     /* jobs in the deques */
+static int              Idle = 0;       /* pool threads waiting for work */
+static SpawnDeque_t *   Deques = NULL;  /* one per pool thread & outside */
+static int              SpawnThreads = 0;
+
+/* prototypes */
+static int          SpawnStart (void *, VclClass::VCLFUNC, VclClass::VCLVALUE *);
+static int          SpawnJoin (void *, int, VclClass::VCLVALUE *);
+static int          SpawnMap (void *, VclClass::VCLFUNC, char *, char *, int, int);
+static int          SpawnLoop (void *, VclClass::VCLLOOP *, long);
+static int          MapRun (SpawnCtx_t *, SpawnMap_t *);
+static int          SpawnQueue (SpawnCtx_t *, VclClass::VCLFUNC, VclClass::VCLVALUE *,
+                                SpawnMap_t *);
+static void         SpawnPool (void);
+static void *       SpawnThread (void *);
+static int          SpawnTake (int);
+static void         SpawnRun (int);
+static VclClass *   SpawnChild (SpawnCtx_t *);
+static void         SpawnIdle (SpawnCtx_t *, VclClass *);
+static int          MapChunk (VclClass *, SpawnMap_t *, long, long);
+static void         MapWork (VclClass *, SpawnMap_t *);
+static long         MapNow (void);
+
+static VclClass::VCLSPAWN   SpawnHooks = { SpawnStart, SpawnJoin, SpawnMap,
+                                                  SpawnLoop };
+
+
+void *
+VclSpawnOpen (VclClass *vcl, FILE *in, FILE *out, FILE *err)
+{
+    SpawnCtx_t *    ctx;
+
+    if ( ( ctx = (SpawnCtx_t *) calloc( 1, sizeof( SpawnCtx_t ) )) == NULL )
+        return NULL;
+
+    ctx->prog = vcl->vclProgram();
+    ctx->globals = vcl->vclGlobals();
+    ctx->heap = vcl->vclHeap();
+    ctx->in = in;
+    ctx->out = out;
+    ctx->err = err;
+
+    vcl->vclSpawn( &SpawnHooks, ctx );
+    return ctx;
+} /* VclSpawnOpen */
+
+
+void
+VclSpawnClose (void *arg)
+{
+    SpawnCtx_t *    ctx = (SpawnCtx_t *) arg;
+    VclClass::VCLVALUE  ret;
+    int             mine;
+    int             h;
+
+    if ( ctx == NULL )
+        return;
+
+    /* the functions not joined still use the globals */
+    for ( h = 1; h <= SPAWNJOBS; ++h )
+    {
+        pthread_mutex_lock( &SpawnLock );
+        if ( ctx->pending == 0 )
+            h = SPAWNJOBS;              /* none left */
+        mine = ( Jobs[h].ctx == ctx && Jobs[h].state != JOB_FREE );
+        pthread_mutex_unlock( &SpawnLock );
+        if ( mine )
+            SpawnJoin( ctx, h, &ret );
+    }
+
+    while ( ctx->nidle )
+    {
+        ctx->idle[--ctx->nidle]->vclShutdown();
+        delete ctx->idle[ctx->nidle];
+    }
+    free( ctx->idle );
+    free( ctx );
+} /* VclSpawnClose */
+
+
+/*
+ * Spawn a function, the spawn() hook
+ *
+ * Returns its handle, or -1
+ *------------------------------------*/
+static int
+SpawnStart (void *arg, VclClass::VCLFUNC fn, VclClass::VCLVALUE *argv)
+{
+    pthread_once( &SpawnOnce, SpawnPool );
+    if ( SpawnThreads == 0 )
+        return -1;
+
+    return SpawnQueue( (SpawnCtx_t *) arg, fn, argv, NULL );
+} /* SpawnStart */
+
+
+/*
+ * Queue a spawned function, or a mapper if map isn't NULL
+ *
+ * Returns its handle, or -1
+ *---------------------------------------------------------*/
+static int
+SpawnQueue (SpawnCtx_t *ctx, VclClass::VCLFUNC fn, VclClass::VCLVALUE *argv,
+            SpawnMap_t *map)
+{
+    SpawnDeque_t *  dq;
+    long            me;
+    int             h;
+
+    pthread_mutex_lock( &SpawnLock );
+    if ( ( h = FreeJob ) != 0 )
+    {
+        FreeJob = Jobs[h].next;
+        Jobs[h].ctx = ctx;
+        Jobs[h].map = map;
+        Jobs[h].fn = fn;
+        if ( argv != NULL )
+            Jobs[h].arg = *argv;
+        Jobs[h].err = 0;
+        Jobs[h].state = JOB_QUEUED;
+        ++ctx->pending;
+    }
+    pthread_mutex_unlock( &SpawnLock );
+    if ( h == 0 )
+        return -1;
+
+    /* a pool thread's own deque, or the outside one */
+    me = (long) pthread_getspecific( SpawnKey );
+    dq = &Deques[me ? me - 1 : SpawnThreads];
+    pthread_mutex_lock( &dq->lock );
+    dq->jobs[dq->bottom++ % SPAWNJOBS] = h;
+    pthread_mutex_unlock( &dq->lock );
+
+    pthread_mutex_lock( &SpawnLock );
+    ++Queued;
+    pthread_cond_signal( &SpawnQueued );
+    if ( Idle == 0 )
+        pthread_cond_broadcast( &SpawnDone );   /* the joiners can help */
+    pthread_mutex_unlock( &SpawnLock );
+
+    return h;
+} /* SpawnQueue */
+
+
+/*
+ * Wait for a spawned function, the join() hook
+ *
+ * Runs queued functions meanwhile.  Returns 0, the vclCall()
+ * error code, or -1 for a bad handle
+ *------------------------------------------------------------*/
+static int
+SpawnJoin (void *arg, int h, VclClass::VCLVALUE *ret)
+{
+    SpawnCtx_t *    ctx = (SpawnCtx_t *) arg;
+    long            me = (long) pthread_getspecific( SpawnKey );
+    int             other;
+    int             err;
+
+    if ( h < 1 || h > SPAWNJOBS )
+        return -1;
+
+    pthread_mutex_lock( &SpawnLock );
+    if ( Jobs[h].ctx != ctx || Jobs[h].state == JOB_FREE )
+    {
+        pthread_mutex_unlock( &SpawnLock );
+        return -1;
+    }
+
+    while ( Jobs[h].state != JOB_DONE )
+    {
+        pthread_mutex_unlock( &SpawnLock );
+        if ( ( other = SpawnTake( me ? me - 1 : SpawnThreads )) != 0 )
+            SpawnRun( other );          /* help, maybe it was h */
+        pthread_mutex_lock( &SpawnLock );
+        if ( other == 0 && Jobs[h].state != JOB_DONE && Queued == 0 )
+            pthread_cond_wait( &SpawnDone, &SpawnLock );
+    }
+
+    *ret = Jobs[h].ret;
+    err = Jobs[h].err;
+    Jobs[h].ctx = NULL;
+    Jobs[h].map = NULL;
+    Jobs[h].state = JOB_FREE;
+    Jobs[h].next = FreeJob;
+    FreeJob = h;
+    --ctx->pending;
+    pthread_mutex_unlock( &SpawnLock );
+
+    return err;
+} /* SpawnJoin */
+
+
+/*
+ * Call a function for each element of an array, the parallel_map() hook
+ *
+ * Returns 0, the error code of the first call to fail, or -1 if it
+ * could not call the function
+ *--------------------------------------------------------------------*/
+static int
+SpawnMap (void *arg, VclClass::VCLFUNC fn, char *in, char *out, int count, int size)
+{
+    SpawnMap_t      map;
+
+    memset( &map, 0, sizeof( map ) );
+    map.fn = fn;
+    map.in = in;
+    map.out = out;
+    map.size = size;
+    map.count = count;
+
+    return MapRun( (SpawnCtx_t *) arg, &map );
+} /* SpawnMap */
+
+
+/*
+ * Run the iterations of a loop, the parallel for hook
+ *
+ * Returns 0, the error code of the first iteration to fail, or -1 if
+ * it could not run them
+ *---------------------------------------------------------------------*/
+static int
+SpawnLoop (void *arg, VclClass::VCLLOOP *loop, long count)
+{
+    SpawnMap_t      map;
+
+    /* next may pass count by a chunk of each mapper */
+    if ( count > LONG_MAX / 4 )
+        return -1;
+
+    memset( &map, 0, sizeof( map ) );
+    map.loop = loop;
+    map.count = count;
+
+    return MapRun( (SpawnCtx_t *) arg, &map );
+} /* SpawnLoop */
+
+
+/*
+ * Run a map or loop, in a child instance and the mappers
+ *
+ * Times the first elements, for the chunk size, then spreads the rest
+ * over the mappers.  Returns map->err, or -1 if there is no instance,
+ * before any element has run: parallel_map() and the parallel for
+ * then run them all themselves.  The calls return an error code > 0.
+ *---------------------------------------------------------------------*/
+static int
+MapRun (SpawnCtx_t *ctx, SpawnMap_t *map)
+{
+    VclClass *      vcl;
+    VclClass::VCLVALUE  ret;
+    int             hs[SPAWNJOBS];
+    int             nh = 0;
+    long            helpers;
+    long            start;
+    long            took;
+
+    pthread_once( &SpawnOnce, SpawnPool );
+    if ( ( vcl = SpawnChild( ctx )) == NULL )
+        return -1;
+
+    /* the cost of an element, from the first MAPPROBE microseconds */
+    start = MapNow();
+    do
+    {
+        map->err = MapChunk( vcl, map, map->next, map->next + 1 );
+        ++map->next;
+        took = MapNow() - start;
+    } while ( map->err == 0 && map->next < map->count && took < MAPPROBE );
+    map->chunk = MAPGRAIN * map->next / ( took > 0 ? took : 1 );
+    if ( map->chunk < 1 )
+        map->chunk = 1;
+
+    /* a mapper for each pool thread the rest keeps busy, with this one */
+    if ( map->err == 0 && map->next < map->count )
+    {
+        helpers = ( map->count - map->next ) / map->chunk - 1;
+        if ( helpers > SpawnThreads )
+            helpers = SpawnThreads;
+        map->mappers = helpers > 0 ? (int) helpers + 1 : 1;
+        while ( nh < helpers && ( hs[nh] = SpawnQueue( ctx, map->fn, NULL, map )) > 0 )
+            ++nh;
+
+        MapWork( vcl, map );
+        while ( nh > 0 )
+            SpawnJoin( ctx, hs[--nh], &ret );
+    }
+
+    SpawnIdle( ctx, vcl );
+    return map->err;
+} /* MapRun */
+
+
+/*
+ * Start the pool, once
+ *----------------------*/
+static void
+SpawnPool (void)
+{
+    pthread_attr_t  attr;
+    pthread_t       thread;
+    size_t          stack;
+    long            n;
+    long            i;
+
+    for ( i = SPAWNJOBS; i > 0; --i )
+    {
+        Jobs[i].next = FreeJob;
+        FreeJob = (int) i;
+    }
+
+    if ( ( n = sysconf( _SC_NPROCESSORS_ONLN )) <= 0 )
+        n = 1;
+    if ( ( Deques = (SpawnDeque_t *) calloc( n + 1, sizeof( SpawnDeque_t ) )) == NULL ||
+         pthread_key_create( &SpawnKey, NULL ) != 0 )
+        return;
+    for ( i = 0; i <= n; ++i )
+        pthread_mutex_init( &Deques[i].lock, NULL );
+
+    /* the interpreter recurses on the C stack, don't go below a minimum */
+    stack = RunIni.stack;
+    if ( stack < MINSTACK )
+        stack = MINSTACK;
+    if ( stack < PTHREAD_STACK_MIN )
+        stack = PTHREAD_STACK_MIN;
+
+    pthread_attr_init( &attr );
+    pthread_attr_setstacksize( &attr, stack );
+    pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_DETACHED );
+    for ( i = 0; i < n; ++i )
+        if ( pthread_create( &thread, &attr, SpawnThread, (void *) i ) != 0 )
+            break;
+    pthread_attr_destroy( &attr );
+
+    /* the outside deque is the one after the last thread's */
+    SpawnThreads = (int) i;
+} /* SpawnPool */
+
+
+/*
+ * Pool thread
+ *
+ * Runs queued functions, its own first
+ *--------------------------------------*/
+static void *
+SpawnThread (void *arg)
+{
+    int             me = (int) (long) arg;
+    int             h;
+
+    pthread_setspecific( SpawnKey, (void *) (long) ( me + 1 ) );
+
+    for ( ;; )
+    {
+        pthread_mutex_lock( &SpawnLock );
+        ++Idle;
+        while ( Queued == 0 )
+            pthread_cond_wait( &SpawnQueued, &SpawnLock );
+        --Idle;
+        pthread_mutex_unlock( &SpawnLock );
+
+        if ( ( h = SpawnTake( me )) != 0 )
+            SpawnRun( h );
+    }
+    return NULL;
+} /* SpawnThread */
+
+
+/*
+ * Take a queued function
+ *
+ * Pool thread me pops the newest of its own deque, else steals the
+ * oldest of another, starting with its neighbour.  me SpawnThreads,
+ * for a thread outside the pool, pops the outside deque.
+ * Returns the handle, or 0 if nothing is queued
+ *---------------------------------------------------------------------*/
+static int
+SpawnTake (int me)
+{
+    SpawnDeque_t *  dq;
+    int             h = 0;
+    int             i;
+
+    dq = &Deques[me];
+    pthread_mutex_lock( &dq->lock );
+    if ( dq->bottom != dq->top )
+        h = dq->jobs[--dq->bottom % SPAWNJOBS];
+    pthread_mutex_unlock( &dq->lock );
+
+    for ( i = 1; h == 0 && i <= SpawnThreads; ++i )
+    {
+        dq = &Deques[( me + i ) % ( SpawnThreads + 1 )];
+        pthread_mutex_lock( &dq->lock );
+        if ( dq->bottom != dq->top )
+            h = dq->jobs[dq->top++ % SPAWNJOBS];
+        pthread_mutex_unlock( &dq->lock );
+    }
+
+    if ( h != 0 )
+    {
+        pthread_mutex_lock( &SpawnLock );
+        --Queued;
+        Jobs[h].state = JOB_RUNNING;
+        pthread_mutex_unlock( &SpawnLock );
+    }
+    return h;
+} /* SpawnTake */
+
+
+/*
+ * Run a spawned function in a child instance
+ *--------------------------------------------*/
+static void
+SpawnRun (int h)
+{
+    SpawnJob_t *    job = &Jobs[h];
+    SpawnCtx_t *    ctx = job->ctx;
+    VclClass *      vcl = SpawnChild( ctx );
+
+    if ( vcl == NULL )
+    {
+        job->ret.type = VclClass::VCL_VOID;
+        job->err = ENOMEM;
+    }
+    else
+    {
+        if ( job->map != NULL )
+        {
+            MapWork( vcl, job->map );
+            job->ret.type = VclClass::VCL_VOID;
+            job->err = 0;
+        }
+        else
+            job->err = vcl->vclCall( job->fn, 1, &job->arg, &job->ret );
+        SpawnIdle( ctx, vcl );
+    }
+
+    pthread_mutex_lock( &SpawnLock );
+    job->state = JOB_DONE;
+    pthread_cond_broadcast( &SpawnDone );
+    pthread_mutex_unlock( &SpawnLock );
+} /* SpawnRun */
+
+
+/*
+ * Get a child instance for a run, an idle one or a new one
+ *----------------------------------------------------------*/
+static VclClass *
+SpawnChild (SpawnCtx_t *ctx)
+{
+    VclClass *      vcl = NULL;
+
+    pthread_mutex_lock( &SpawnLock );
+    if ( ctx->nidle )
+        vcl = ctx->idle[--ctx->nidle];
+    pthread_mutex_unlock( &SpawnLock );
+
+    if ( vcl == NULL )
+    {
+        if ( ( vcl = new VclClass ) == NULL )
+            return NULL;
+        vcl->vclPrepare( ctx->prog );
+        vcl->vclShareGlobals( ctx->globals );
+        vcl->vclShareHeap( ctx->heap );
+        vcl->vclSpawn( &SpawnHooks, ctx );
+    }
+
+    /* vclReset() put its stdio back */
+    vcl->vclStdio( ctx->in, ctx->out, ctx->err );
+    return vcl;
+} /* SpawnChild */
+
+
+/*
+ * Keep a child instance for the next function of the run
+ *--------------------------------------------------------*/
+static void
+SpawnIdle (SpawnCtx_t *ctx, VclClass *vcl)
+{
+    vcl->vclReset();
+    pthread_mutex_lock( &SpawnLock );
+    if ( ctx->nidle == ctx->maxidle )
+    {
+        VclClass ** idle = (VclClass **) realloc( ctx->idle,
+                                ( ctx->maxidle + 4 ) * sizeof( VclClass * ) );
+
+        if ( idle != NULL )
+        {
+            ctx->idle = idle;
+            ctx->maxidle += 4;
+        }
+    }
+    if ( ctx->nidle < ctx->maxidle )
+    {
+        ctx->idle[ctx->nidle++] = vcl;
+        vcl = NULL;
+    }
+    pthread_mutex_unlock( &SpawnLock );
+
+    if ( vcl != NULL )
+    {
+        vcl->vclShutdown();
+        delete vcl;
+    }
+} /* SpawnIdle */
+
+
+/*
+ * Call the function for elements from through to - 1, or run those
+ * iterations of the loop
+ *
+ * Returns 0, or the vclCall() or vclLoop() error code
+ *-------------------------------------------------------------------*/
+static int
+MapChunk (VclClass *vcl, SpawnMap_t *map, long from, long to)
+{
+    VclClass::VCLVALUE  args[2];
+    int             err = 0;
+
+    if ( map->loop != NULL )
+        return vcl->vclLoop( map->loop, from, to );
+
+    args[0].type = VclClass::VCL_PTR;
+    args[1].type = VclClass::VCL_PTR;
+    for ( ; from < to && err == 0; ++from )
+    {
+        args[0].v.p = map->in + from * map->size;
+        args[1].v.p = map->out + from * map->size;
+        err = vcl->vclCall( map->fn, 2, args, NULL );
+    }
+    return err;
+} /* MapChunk */
+
+
+/*
+ * Take chunks of a map's elements until there are none left
+ *
+ * A chunk is 1 / 2 mappers of the elements left, and at least
+ * map->chunk.  A failed call ends the map.
+ *-------------------------------------------------------------*/
+static void
+MapWork (VclClass *vcl, SpawnMap_t *map)
+{
+    long            from;
+    long            n;
+    int             err;
+
+    for ( ;; )
+    {
+        n = ( map->count - __atomic_load_n( &map->next, __ATOMIC_RELAXED ) ) /
+            ( 2 * map->mappers );
+        if ( n < map->chunk )
+            n = map->chunk;
+        if ( ( from = __atomic_fetch_add( &map->next, n, __ATOMIC_RELAXED )) >= map->count )
+            break;
+        if ( ( err = MapChunk( vcl, map, from,
+                               from + n < map->count ? from + n : map->count )) != 0 )
+        {
+            pthread_mutex_lock( &SpawnLock );
+            if ( map->err == 0 )
+                map->err = err;
+            pthread_mutex_unlock( &SpawnLock );
+            __atomic_store_n( &map->next, map->count, __ATOMIC_RELAXED );
+            break;
+        }
+    }
+} /* MapWork */
+
+
+/* monotonic microseconds */
+static long
+MapNow (void)
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1000000L + ts.tv_nsec / 1000;
+} /* MapNow */
+
+} /* extern "C" */